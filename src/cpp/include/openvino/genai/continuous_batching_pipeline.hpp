@@ -209,5 +209,32 @@ public:
     * @brief finish chat and clear kv cache.
     */
     void finish_chat();
+
+    /**
+     * Saves the contents of the prefix cache to a file, so that a pipeline created later with
+     * SchedulerConfig::prefix_cache_snapshot_path pointing to this file starts with the same cached prefixes.
+     * Requires prefix caching to be enabled. Must not be called while step() or generate() is running.
+     * @param path The path of the snapshot file.
+     */
+    void save_prefix_cache(const std::filesystem::path& path);
+
+    /**
+     * Saves the cached KV cache blocks of a prompt to a file, so that another pipeline with the same model loading it with
+     * load_prefix_cache() does not have to process the prompt again, except for its last block. This allows to process prompts and generate
+     * tokens in different pipelines (e.g. bound to different sockets): the prompt is processed by one pipeline, e.g. with
+     * max_new_tokens set to 1, and its KV cache is handed over to another one through a file on a memory-backed file
+     * system such as /dev/shm. Requires prefix caching to be enabled. Must not be called while step() or generate() is running.
+     * @param path The path of the snapshot file.
+     * @param input_ids The prompt tokens, only the blocks holding a prefix of the prompt are saved.
+     */
+    void save_prefix_cache(const std::filesystem::path& path, const ov::Tensor& input_ids);
+
+    /**
+     * Loads the KV cache blocks saved by save_prefix_cache() into the prefix cache, so that the requests starting with the
+     * saved prefixes reuse them. Requires prefix caching to be enabled. Must not be called while step() or generate() is running.
+     * @param path The path of the snapshot file.
+     * @return The number of loaded blocks, 0 if the snapshot does not match the model or the KV cache layout.
+     */
+    size_t load_prefix_cache(const std::filesystem::path& path);
 };
 }
@@ -616,10 +616,23 @@ operator|(const StructuredOutputConfig::StructuralTag& lhs,
  *        NOTE: ContinuousBatching backend for Speculative Decode uses `num_assistant_tokens` as is. Stateful backend for Speculative Decode uses `num_assistant_tokens`'s
  *        copy as initial value and adjusts it based on recent number of accepted tokens. If `num_assistant_tokens` is not set, it defaults to `5` for both backends.
  * @param max_ngram_size is maximum ngram to use when looking for matches in the prompt.
+ * @param adaptive_num_assistant_tokens if true, ContinuousBatching backend for Speculative Decode and prompt lookup adjusts the number of candidates
+ *        of the request every step between 1 and 2 * `num_assistant_tokens`, maximizing the expected number of accepted tokens per unit of time
+ *        according to the observed acceptance rate of the request and the measured durations of draft and main model steps.
+ *        `num_assistant_tokens` is used until they are measured. Ignored with `assistant_confidence_threshold`.
+ * @param prompt_lookup_corpus token ids looked up by prompt lookup in addition to the prompt and the generated tokens, e.g. the tokenized
+ *        documents retrieved for the request. The candidates are taken from the corpus when the end of a sequence does not occur earlier
+ *        in the sequence itself.
  *
  * @param structured_output_config if set, the output will be a string constrained by the specified json_schema, regex, or EBNF grammar.
  * 
  * @param apply_chat_template whether or not to apply chat_template for non-chat scenarios
+ *
+ * Scheduling parameters (used by ContinuousBatching backend depending on SchedulerConfig::scheduling_policy):
+ * @param priority importance of the request for SchedulingPolicy::PRIORITY, requests with a higher value are processed first.
+ * @param ttft_target_ms time to first token target in milliseconds for SchedulingPolicy::EARLIEST_DEADLINE_FIRST, 0 means no target.
+ * @param tpot_target_ms time per output token target in milliseconds for SchedulingPolicy::EARLIEST_DEADLINE_FIRST, 0 means no target.
+ * @param tenant_id the tenant the request belongs to for SchedulingPolicy::FAIR_SHARE.
  */
 class OPENVINO_GENAI_EXPORTS GenerationConfig {
 public:
@@ -666,6 +679,8 @@ public:
     float assistant_confidence_threshold = 0.f;
     size_t num_assistant_tokens = 0;
     size_t max_ngram_size = 0;
+    bool adaptive_num_assistant_tokens = false;
+    std::vector<int64_t> prompt_lookup_corpus;
 
     // Structured output parameters
     std::optional<StructuredOutputConfig> structured_output_config;
@@ -675,6 +690,12 @@ public:
     // set to true if chat template should be applied for non-chat scenarios, set to false otherwise
     bool apply_chat_template = true;
 
+    // Scheduling parameters
+    int64_t priority = 0;
+    size_t ttft_target_ms = 0;
+    size_t tpot_target_ms = 0;
+    std::string tenant_id;
+
 
     /** @brief sets eos_token_id to tokenizer_eos_token_id if eos_token_id is less than 0.
      * Otherwise verifies eos_token_id == tokenizer_eos_token_id.
@@ -740,6 +761,8 @@ extern OPENVINO_GENAI_EXPORTS ov::Property<size_t> rng_seed;
 static constexpr ov::Property<float> assistant_confidence_threshold{"assistant_confidence_threshold"};
 static constexpr ov::Property<size_t> num_assistant_tokens{"num_assistant_tokens"};
 static constexpr ov::Property<size_t> max_ngram_size{"max_ngram_size"};
+static constexpr ov::Property<bool> adaptive_num_assistant_tokens{"adaptive_num_assistant_tokens"};
+static constexpr ov::Property<std::vector<int64_t>> prompt_lookup_corpus{"prompt_lookup_corpus"};
 
 static constexpr ov::Property<StructuredOutputConfig> structured_output_config{"structured_output_config"};
 static constexpr ov::Property<std::string> regex{"regex"};
@@ -749,6 +772,11 @@ static constexpr ov::Property<std::string> backend{"backend"};
 
 static constexpr ov::Property<bool> apply_chat_template{"apply_chat_template"};
 
+static constexpr ov::Property<int64_t> priority{"priority"};
+static constexpr ov::Property<size_t> ttft_target_ms{"ttft_target_ms"};
+static constexpr ov::Property<size_t> tpot_target_ms{"tpot_target_ms"};
+static constexpr ov::Property<std::string> tenant_id{"tenant_id"};
+
 // Predefined Configs
 
 OPENVINO_DEPRECATED("Please, use individual parameters instead of predefined configs. This method will be removed in 2026.0.0 release")
@@ -391,6 +391,14 @@ static constexpr ov::Property<SchedulerConfig> scheduler_config{"scheduler_confi
 */
 static constexpr ov::Property<bool> prompt_lookup{"prompt_lookup"};
 
+/**
+* @brief enable concurrent_draft property serves to generate the next candidates by the draft model of speculative decoding
+* while the main model validates the current ones, the candidates are discarded if the validation rejects any of the current ones.
+* Set `true` within the draft model properties to activate this mode, e.g. draft_model(path, device, concurrent_draft(true)).
+* The draft model can be compiled for another device or CPU cores (via its properties) for both models to run in parallel.
+*/
+static constexpr ov::Property<bool> concurrent_draft{"concurrent_draft"};
+
 /**
 * @brief enable enable_save_ov_model property serves to serialize ov model (xml/bin) generated from gguf model on disk for re-use.
 * Set `true` to activate this mode.
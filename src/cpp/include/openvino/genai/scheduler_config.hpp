@@ -4,12 +4,32 @@
 #pragma once
 
 #include <cstddef>
+#include <map>
 #include <sstream>
+#include <string>
+#include <unordered_map>
 
 #include "openvino/genai/cache_eviction.hpp"
 #include "openvino/genai/sparse_attention.hpp"
 
 namespace ov::genai {
+
+/**
+ * @brief Defines the order in which ContinuousBatchingPipeline admits requests to a batch and preempts them when it runs
+ * out of KV-cache blocks: requests go to the batch from the most important one and are preempted from the least important one.
+ */
+enum class SchedulingPolicy {
+    FCFS,                    /** Requests are processed in the order of arrival. */
+    PRIORITY,                /** Requests with a higher GenerationConfig::priority go first, requests of the same priority
+                              *  in the order of arrival. */
+    EARLIEST_DEADLINE_FIRST, /** Requests go in the order of the deadlines derived from GenerationConfig::ttft_target_ms before
+                              *  the first token is generated and from GenerationConfig::tpot_target_ms afterwards. Requests
+                              *  without a target go last in the order of arrival. */
+    FAIR_SHARE               /** Batch is shared between tenants (GenerationConfig::tenant_id) in proportion to
+                              *  SchedulerConfig::tenant_weights: requests of the tenant which has received the fewest scheduled
+                              *  tokens relative to its weight go first, requests of a tenant in the order of arrival. */
+};
+
 struct SchedulerConfig {
     // a maximum number of tokens to batch
     // (in contrast to max_batch_size which combines independent sequences, we consider total amount of tokens in a batch)
@@ -68,11 +88,54 @@ struct SchedulerConfig {
      */
     SparseAttentionConfig sparse_attention_config;
 
+    // total size of host memory swap space for preempted sequences in GB
+    // When set, sequences preempted due to lack of KV-cache blocks have their KV-cache copied into host memory
+    // and copied back once enough blocks are available, instead of being recomputed from scratch.
+    // When equal to zero (or when swap space is exhausted) preempted sequences are recomputed.
+    std::size_t swap_space = 0;
+
+    // total size of the disk tier of the prefix cache in GB, used only when enable_prefix_caching is set
+    // When set, fully filled KV-cache blocks which are about to be overwritten in the prefix cache are stored
+    // to a memory-mapped file and loaded back once a new prompt starts with the same prefix.
+    std::size_t prefix_cache_disk_size = 0;
+
+    // directory for the prefix cache disk tier file, system temporary directory is used when empty
+    std::string prefix_cache_disk_dir;
+
+    // path to a prefix cache snapshot created by ContinuousBatchingPipeline::save_prefix_cache() to warm-start the prefix cache from,
+    // used only when enable_prefix_caching is set
+    // A snapshot created for a different model or KV-cache precision is ignored with a warning.
+    std::string prefix_cache_snapshot_path;
+
+    // order in which requests are admitted to a batch and preempted, see SchedulingPolicy
+    SchedulingPolicy scheduling_policy = SchedulingPolicy::FCFS;
+
+    // relative batch shares of tenants for SchedulingPolicy::FAIR_SHARE, tenants which are not listed have a weight of 1.0
+    std::map<std::string, float> tenant_weights;
+
+    // number of consecutive generation steps scheduled at once when all running requests are in the generation phase
+    // When greater than 1, KV-cache blocks for this number of tokens are reserved for the running requests at once and
+    // the following steps only append a token to each of them, without running admission, preemption and KV-cache resizing.
+    // Requests added meanwhile wait for the next full scheduling step, so larger values reduce the per-token host overhead
+    // at the cost of time to first token of new requests. Not applied when cache eviction or sparse attention is used.
+    std::size_t num_scheduler_steps = 1;
+
+    // target duration in milliseconds of the steps generating tokens for running requests, used only when dynamic_split_fuse is set
+    // When set, the number of prompt tokens scheduled together with generated tokens is adapted at each step to the measured
+    // step durations to keep this target, while steps without generated tokens still use the whole max_num_batched_tokens.
+    // When equal to zero, prompt tokens fill the batch up to max_num_batched_tokens.
+    std::size_t inter_token_latency_target_ms = 0;
+
     bool operator==(const SchedulerConfig& other) const {
         return max_num_batched_tokens == other.max_num_batched_tokens && num_kv_blocks == other.num_kv_blocks &&
                cache_size == other.cache_size &&
                dynamic_split_fuse == other.dynamic_split_fuse && use_cache_eviction == other.use_cache_eviction &&
-               max_num_seqs == other.max_num_seqs && enable_prefix_caching == other.enable_prefix_caching;
+               max_num_seqs == other.max_num_seqs && enable_prefix_caching == other.enable_prefix_caching &&
+               swap_space == other.swap_space && prefix_cache_disk_size == other.prefix_cache_disk_size &&
+               prefix_cache_disk_dir == other.prefix_cache_disk_dir && prefix_cache_snapshot_path == other.prefix_cache_snapshot_path &&
+               scheduling_policy == other.scheduling_policy && tenant_weights == other.tenant_weights &&
+               num_scheduler_steps == other.num_scheduler_steps &&
+               inter_token_latency_target_ms == other.inter_token_latency_target_ms;
     }
 
     /**
@@ -83,6 +146,12 @@ struct SchedulerConfig {
      * @return A string describing the current SchedulerConfig in a readable format.
      */
     std::string to_string() const {
+        static const std::unordered_map<SchedulingPolicy, std::string> scheduling_policy_to_string = {
+            {SchedulingPolicy::FCFS, "FCFS"},
+            {SchedulingPolicy::PRIORITY, "PRIORITY"},
+            {SchedulingPolicy::EARLIEST_DEADLINE_FIRST, "EARLIEST_DEADLINE_FIRST"},
+            {SchedulingPolicy::FAIR_SHARE, "FAIR_SHARE"},
+        };
         std::ostringstream oss;
         oss << "SchedulerConfig { \n";
         oss << "  max_num_batched_tokens: " << max_num_batched_tokens << "\n";
@@ -99,6 +168,26 @@ struct SchedulerConfig {
         if (use_sparse_attention) {
             oss << sparse_attention_config.to_string() << "\n";
         }
+        oss << "  swap_space: " << swap_space << "\n";
+        oss << "  prefix_cache_disk_size: " << prefix_cache_disk_size << "\n";
+        if (prefix_cache_disk_size > 0) {
+            oss << "  prefix_cache_disk_dir: " << prefix_cache_disk_dir << "\n";
+        }
+        if (!prefix_cache_snapshot_path.empty()) {
+            oss << "  prefix_cache_snapshot_path: " << prefix_cache_snapshot_path << "\n";
+        }
+        if (scheduling_policy_to_string.count(scheduling_policy) > 0) {
+            oss << "  scheduling_policy: " << scheduling_policy_to_string.at(scheduling_policy) << "\n";
+        }
+        if (scheduling_policy == SchedulingPolicy::FAIR_SHARE) {
+            oss << "  tenant_weights: {";
+            for (const auto& [tenant_id, weight] : tenant_weights) {
+                oss << " '" << tenant_id << "': " << weight;
+            }
+            oss << " }\n";
+        }
+        oss << "  num_scheduler_steps: " << num_scheduler_steps << "\n";
+        oss << "  inter_token_latency_target_ms: " << inter_token_latency_target_ms << "\n";
         oss << " }";
         return oss.str();
     }
@@ -28,6 +28,7 @@ public:
     void end() override;
 
     TextStreamer(const Tokenizer& tokenizer, std::function<CallbackTypeVariant(std::string)> callback, const ov::AnyMap& detokenization_params = {});
+    ~TextStreamer();
 
 protected:
     Tokenizer m_tokenizer;
@@ -45,6 +46,10 @@ protected:
     StreamingStatus run_callback_if_needed(const std::string& text);
 
     void compute_decoded_length_for_position(size_t cache_position);
+
+    // Is used to hide internal states of decoding the tokens cache
+    class TextStreamerImpl;
+    std::unique_ptr<TextStreamerImpl> m_impl;
 };
 
 class OPENVINO_GENAI_EXPORTS TextParserStreamer : public TextStreamer {
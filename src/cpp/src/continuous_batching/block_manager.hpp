@@ -9,8 +9,13 @@
 #include <algorithm>
 #include <fstream>
 #include <chrono>
+#include <functional>
+#include <optional>
+#include <set>
+#include <unordered_map>
 
 #include "sequence_group.hpp"
+#include "continuous_batching/disk_block_cache.hpp"
 
 namespace ov::genai {
 
@@ -72,16 +77,197 @@ public:
 };
 
 using BlocksPerLayer = std::vector<KVCacheBlock::Ptr>;
+// physical indices of the blocks occupied by a sequence, one contiguous row of logical blocks per layer
+using BlockIndicesPerLayer = std::vector<std::vector<int32_t>>;
+
+/**
+ * @brief Prefix tree over the hashed KV cache blocks known to the allocator, shared across all sequences.
+ * Each node corresponds to a block hash and is linked to the hash of the block preceding it in the sequence, so that
+ * the blocks of all sequences with a common prefix form a single tree starting at the first block. Since block hashes
+ * are chained (the hash of a block depends on the hashes of all preceding blocks), children are grouped by the parent
+ * hash rather than owned by the parent node and stay reachable if the parent node is removed and later re-inserted.
+ */
+class BlockPrefixTree {
+    struct Node {
+        std::optional<size_t> prefix_hash;
+        size_t num_tokens;
+    };
+
+    struct Children {
+        std::set<size_t> hashes;
+        // number of tokens in the child block -> number of children with this many tokens
+        std::map<size_t, size_t, std::greater<size_t>> num_tokens_counts;
+    };
+
+    std::unordered_map<size_t, Node> m_nodes;
+    std::unordered_map<size_t, Children> m_children;
+    Children m_root_children;
+
+    Children* _get_children(const std::optional<size_t>& prefix_hash) {
+        if (!prefix_hash.has_value()) {
+            return &m_root_children;
+        }
+        auto it = m_children.find(*prefix_hash);
+        return it == m_children.end() ? nullptr : &it->second;
+    }
+
+    const Children* _get_children(const std::optional<size_t>& prefix_hash) const {
+        return const_cast<BlockPrefixTree*>(this)->_get_children(prefix_hash);
+    }
+
+public:
+    /**
+     * Inserts a node for a block hash, replacing the previous node with the same hash if any.
+     * @param hash The hash of the block.
+     * @param prefix_hash The hash of the preceding block in the sequence, or std::nullopt for the first block.
+     * @param num_tokens The number of tokens in the block the hash was computed for, 0 if unknown.
+     */
+    void insert(size_t hash, std::optional<size_t> prefix_hash, size_t num_tokens) {
+        if (prefix_hash == hash) {
+            // blocks allocated ahead of their contents repeat the hash of the preceding block
+            return;
+        }
+        erase(hash);
+        m_nodes.emplace(hash, Node{prefix_hash, num_tokens});
+        Children& children = prefix_hash.has_value() ? m_children[*prefix_hash] : m_root_children;
+        children.hashes.insert(hash);
+        ++children.num_tokens_counts[num_tokens];
+    }
+
+    /**
+     * Removes the node for a block hash. Nodes of the blocks following it are kept.
+     * @param hash The hash of the block. Silently ignored if not present in the tree.
+     */
+    void erase(size_t hash) {
+        auto it = m_nodes.find(hash);
+        if (it == m_nodes.end()) {
+            return;
+        }
+        const Node& node = it->second;
+        Children* children = _get_children(node.prefix_hash);
+        OPENVINO_ASSERT(children != nullptr);
+        children->hashes.erase(hash);
+        auto count_it = children->num_tokens_counts.find(node.num_tokens);
+        if (--count_it->second == 0) {
+            children->num_tokens_counts.erase(count_it);
+        }
+        if (node.prefix_hash.has_value() && children->hashes.empty()) {
+            m_children.erase(*node.prefix_hash);
+        }
+        m_nodes.erase(it);
+    }
+
+    bool contains(size_t hash) const {
+        return m_nodes.count(hash) != 0;
+    }
+
+    /**
+     * @param hash The hash of the block.
+     * @return The hash of the preceding block for a block in the tree, or std::nullopt if the block is the first one
+     * in its sequence or is not present in the tree.
+     */
+    std::optional<size_t> get_prefix_hash(size_t hash) const {
+        auto it = m_nodes.find(hash);
+        return it == m_nodes.end() ? std::nullopt : it->second.prefix_hash;
+    }
+
+    /**
+     * @param hash The hash of the block.
+     * @return The number of tokens the hash of a block in the tree was computed for, or 0 if unknown.
+     */
+    size_t get_num_tokens(size_t hash) const {
+        auto it = m_nodes.find(hash);
+        return it == m_nodes.end() ? 0 : it->second.num_tokens;
+    }
+
+    /**
+     * @param prefix_hash The hash of the parent block, or std::nullopt for the first blocks of the sequences.
+     * @param hash The hash of the child block.
+     * @return Whether a block with the given hash directly follows the given parent in the tree.
+     */
+    bool has_child(const std::optional<size_t>& prefix_hash, size_t hash) const {
+        const Children* children = _get_children(prefix_hash);
+        return children != nullptr && children->hashes.count(hash) != 0;
+    }
+
+    /**
+     * @param prefix_hash The hash of the parent block, or std::nullopt for the first blocks of the sequences.
+     * @return The distinct known token counts of the children of the given parent, in descending order.
+     */
+    std::vector<size_t> get_children_num_tokens(const std::optional<size_t>& prefix_hash) const {
+        std::vector<size_t> retval;
+        const Children* children = _get_children(prefix_hash);
+        if (children != nullptr) {
+            retval.reserve(children->num_tokens_counts.size());
+            for (const auto& num_tokens_and_count : children->num_tokens_counts) {
+                if (num_tokens_and_count.first != 0) {
+                    retval.push_back(num_tokens_and_count.first);
+                }
+            }
+        }
+        return retval;
+    }
+
+    /**
+     * @return Number of nodes (blocks per layer) in the tree.
+     */
+    size_t size() const {
+        return m_nodes.size();
+    }
+
+    void clear() {
+        m_nodes.clear();
+        m_children.clear();
+        m_root_children = Children{};
+    }
+};
 
 /**
  * @brief Allows to store and retrieve KV-cache blocks based on their content- and position-based hash.
  * Blocks with the same prefix in the generated sequence will have the same hash. Blocks within this store
  * are not owned by any sequence (but had been once) and may be either selected for overwriting, if the allocator
  * runs out of fresh blocks, or reused if their contents match to the prefix-based requested hash.
+ * Blocks are selected for overwriting at leaf granularity - a block is only overwritten once no block continuing
+ * its prefix is left in the store, so that the cached prefixes are shortened from the end and stay restorable.
+ * The leaves are kept ordered by their timestamps, so the least recently used one is found in logarithmic time.
+ * Timestamps only grow, so a leaf whose blocks got a newer timestamp is re-sorted lazily once it comes first.
  */
 class OverwritableBlocksHashStore {
-    std::map<size_t, BlocksPerLayer> m_blocks;
+    using Timestamp = std::chrono::time_point<std::chrono::steady_clock>;
+
+    struct Entry {
+        BlocksPerLayer blocks;
+        std::optional<size_t> prefix_hash;
+        // the timestamp the entry is sorted by among the leaves, not newer than the timestamp of the blocks
+        Timestamp timestamp;
+    };
+
+    std::map<size_t, Entry> m_blocks;
+    // hash -> number of blocks in the store which directly follow the block with this hash
+    std::unordered_map<size_t, size_t> m_num_children;
+    // { timestamp, hash } of the blocks in the store which are not followed by any other block in the store
+    std::set<std::pair<Timestamp, size_t>> m_lru_leaves;
     size_t m_num_layers;
+
+    BlocksPerLayer _pop(std::map<size_t, Entry>::iterator it) {
+        BlocksPerLayer blocks_for_all_layers = std::move(it->second.blocks);
+        const auto& prefix_hash = it->second.prefix_hash;
+        m_lru_leaves.erase({it->second.timestamp, it->first});
+        if (prefix_hash.has_value()) {
+            auto children_it = m_num_children.find(*prefix_hash);
+            OPENVINO_ASSERT(children_it != m_num_children.end());
+            if (--children_it->second == 0) {
+                m_num_children.erase(children_it);
+                auto prefix_it = m_blocks.find(*prefix_hash);
+                if (prefix_it != m_blocks.end()) {
+                    m_lru_leaves.emplace(prefix_it->second.timestamp, prefix_it->first);
+                }
+            }
+        }
+        m_blocks.erase(it);
+        return blocks_for_all_layers;
+    }
+
     public:
     /**
      * Constructs the BlockHashStore.
@@ -93,8 +279,9 @@ class OverwritableBlocksHashStore {
      * Registers allocated KV cache blocks as overwritable. The blocks must not be owned by any sequence.
      * @param blocks_for_all_layers A vector of KV cache blocks (one for each decoder layer) to be added to the store.
      * The hash of each block across the vector must be identical.
+     * @param prefix_hash The hash of the block preceding the added blocks in the sequence, if any.
      */
-    void add(const BlocksPerLayer& blocks_for_all_layers) {
+    void add(const BlocksPerLayer& blocks_for_all_layers, std::optional<size_t> prefix_hash = std::nullopt) {
         OPENVINO_ASSERT(blocks_for_all_layers.size() == m_num_layers);
         bool is_all_free = std::all_of(blocks_for_all_layers.begin(), blocks_for_all_layers.end(), [](const KVCacheBlock::Ptr& block_ptr) { return block_ptr->is_free(); });
         OPENVINO_ASSERT(is_all_free);
@@ -105,7 +292,21 @@ class OverwritableBlocksHashStore {
             }
         }
         OPENVINO_ASSERT(m_blocks.count(hash) == 0);
-        m_blocks[hash] = blocks_for_all_layers;
+        if (prefix_hash.has_value() && ++m_num_children[*prefix_hash] == 1) {
+            auto prefix_it = m_blocks.find(*prefix_hash);
+            if (prefix_it != m_blocks.end()) {
+                m_lru_leaves.erase({prefix_it->second.timestamp, prefix_it->first});
+            }
+        }
+        const Timestamp timestamp = blocks_for_all_layers[0]->get_timestamp();
+        m_blocks[hash] = Entry{blocks_for_all_layers, prefix_hash, timestamp};
+        if (m_num_children.count(hash) == 0) {
+            m_lru_leaves.emplace(timestamp, hash);
+        }
+    }
+
+    bool contains(size_t hash) const {
+        return m_blocks.count(hash) != 0;
     }
 
 
@@ -121,34 +322,49 @@ class OverwritableBlocksHashStore {
         {
             return {};
         }
-        BlocksPerLayer blocks_for_all_layers = it->second;
+        BlocksPerLayer blocks_for_all_layers = _pop(it);
         for (auto& block_ptr : blocks_for_all_layers) {
 
             block_ptr->set_timestamp(std::chrono::steady_clock::now());
             block_ptr->increment();
         }
-        m_blocks.erase(it);
         return blocks_for_all_layers;
     }
 
     /**
-     * Pops the least recently used blocks from the store to be used and overwritten by another sequence.
+     * Pops the least recently used blocks among the leaves of the stored prefixes to be used and overwritten by another sequence.
      * Returned blocks will have reference counters equal to 1.
      * @return A vector of KV cache blocks (one for each decoder layer) that has least recently been added to the store
-     * based on the timestamp.
+     * based on the timestamp and is not followed by any other block in the store.
      */
     BlocksPerLayer get_lru_block_to_overwrite() {
         if (m_blocks.empty()) {
             return {};
         }
-        auto hash_and_blocks_for_all_layers = std::min_element(std::begin(m_blocks), std::end(m_blocks), [](const auto& lhs, const auto& rhs) -> bool { return lhs.second[0]->get_timestamp() < rhs.second[0]->get_timestamp(); });
-        auto blocks_for_all_layers = hash_and_blocks_for_all_layers->second;
+        auto lru_it = m_blocks.end();
+        while (!m_lru_leaves.empty()) {
+            auto leaf_it = m_lru_leaves.begin();
+            auto it = m_blocks.find(leaf_it->second);
+            OPENVINO_ASSERT(it != m_blocks.end());
+            const Timestamp timestamp = it->second.blocks[0]->get_timestamp();
+            if (timestamp == leaf_it->first) {
+                lru_it = it;
+                break;
+            }
+            m_lru_leaves.erase(leaf_it);
+            it->second.timestamp = timestamp;
+            m_lru_leaves.emplace(timestamp, it->first);
+        }
+        if (lru_it == m_blocks.end()) {
+            // only possible if hash collisions made the stored prefixes cyclic
+            lru_it = std::min_element(std::begin(m_blocks), std::end(m_blocks), [](const auto& lhs, const auto& rhs) -> bool { return lhs.second.blocks[0]->get_timestamp() < rhs.second.blocks[0]->get_timestamp(); });
+        }
+        BlocksPerLayer blocks_for_all_layers = _pop(lru_it);
         auto timestamp = std::chrono::steady_clock::now();
         for (auto& block_ptr : blocks_for_all_layers) {
             block_ptr->set_timestamp(timestamp);
             block_ptr->increment();
         }
-        m_blocks.erase(hash_and_blocks_for_all_layers->first);
         return blocks_for_all_layers;
     }
 
@@ -172,8 +388,7 @@ class OverwritableBlocksHashStore {
         for (uint64_t hash : hashes_to_discard) {
             auto it = m_blocks.find(hash);
             if (it != m_blocks.end()) {
-                retval.push_back(it->second);
-                m_blocks.erase(it);
+                retval.push_back(_pop(it));
             }
         }
         return retval;
@@ -181,6 +396,8 @@ class OverwritableBlocksHashStore {
 
     void clear() {
         m_blocks.clear();
+        m_num_children.clear();
+        m_lru_leaves.clear();
     }
 };
 
@@ -200,6 +417,8 @@ class BlockAllocator {
     size_t m_num_layers;
     bool m_enable_prefix_caching;
     ov::genai::OverwritableBlocksHashStore m_overwriteable_blocks;
+    ov::genai::BlockPrefixTree m_prefix_tree;
+    std::function<void(size_t, const BlocksPerLayer&)> m_overwrite_callback;
 
 public:
     /**
@@ -248,6 +467,44 @@ public:
         m_total_num_blocks = new_kv_blocks_count;
     }
 
+    /**
+     * @return The smallest number of blocks the pool can be shrunk to with decrease_kv_blocks_number(), i.e. one more than
+     * the highest index of a block which is occupied or kept for prefix caching in any of the layers.
+     */
+    size_t get_min_kv_blocks_number() const {
+        size_t min_kv_blocks_number = 0;
+        std::vector<bool> is_free(m_total_num_blocks);
+        for (const auto& per_layer_block_list : m_free_blocks) {
+            std::fill(is_free.begin(), is_free.end(), false);
+            for (const auto& block : per_layer_block_list) {
+                is_free[block->get_index()] = true;
+            }
+            size_t num_blocks = m_total_num_blocks;
+            while (num_blocks > min_kv_blocks_number && is_free[num_blocks - 1]) {
+                --num_blocks;
+            }
+            min_kv_blocks_number = num_blocks;
+        }
+        return min_kv_blocks_number;
+    }
+
+    /**
+     * Removes the blocks with the highest indices from the pool, these must be free.
+     * @param new_kv_blocks_count The new number of blocks, not less than get_min_kv_blocks_number().
+     */
+    void decrease_kv_blocks_number(size_t new_kv_blocks_count) {
+        OPENVINO_ASSERT(new_kv_blocks_count < m_total_num_blocks, "New blocks number should be less than previous blocks number.");
+        OPENVINO_ASSERT(new_kv_blocks_count >= get_min_kv_blocks_number(), "Only free blocks can be removed from the pool.");
+        size_t removed_blocks = m_total_num_blocks - new_kv_blocks_count;
+        for (size_t layer_idx = 0; layer_idx < m_num_layers; layer_idx++) {
+            m_free_blocks[layer_idx].remove_if([new_kv_blocks_count](const KVCacheBlock::Ptr& block) {
+                return static_cast<size_t>(block->get_index()) >= new_kv_blocks_count;
+            });
+            m_free_blocks_num[layer_idx] -= removed_blocks;
+        }
+        m_total_num_blocks = new_kv_blocks_count;
+    }
+
 
     /**
      * Returns the number of free blocks for a given layer.
@@ -354,16 +611,21 @@ public:
                             OPENVINO_THROW("internal error - double free when prefix caching");
                         }
 
-                        // actual collision case
+                        // actual collision case, the hash and its node in the prefix tree now belong to the blocks being freed
                         for (size_t layer_idx = 0; layer_idx < colliding_blocks_per_layer.size(); layer_idx++) {
                             m_free_blocks[layer_idx].push_back(colliding_blocks_per_layer[layer_idx]);
                             ++m_free_blocks_num[layer_idx];
                         }
                     }
-                    m_overwriteable_blocks.add(blocks_for_all_layers);
+                    m_overwriteable_blocks.add(blocks_for_all_layers, m_prefix_tree.get_prefix_hash(blocks_for_all_layers[0]->get_hash()));
                 } else {
                     // This set of blocks to be freed corresponds to blocks from different time steps, and thus not eligible for caching
                     // TODO (vshampor): more fine-grained hash store control
+                    for (uint64_t hash : hashes_across_blocks) {
+                        if (!m_overwriteable_blocks.contains(hash)) {
+                            m_prefix_tree.erase(hash);
+                        }
+                    }
                     for (size_t layer_idx = 0; layer_idx < blocks_for_all_layers.size(); layer_idx++) {
                         m_free_blocks[layer_idx].push_back(blocks_for_all_layers[layer_idx]);
                         ++m_free_blocks_num[layer_idx];
@@ -415,10 +677,13 @@ public:
      * @param[in,out] cached_blocks The map of known hashes to already allocated and filled blocks. If the blocks are freshly allocated,
      * it is added to this map under `hash`. If the blocks are reused from the internal overwritable block store,
      * the previous hash entry for these is deleted and the reused blocks are likewise stored in the map under the (new) `hash`.
+     * @param[in] prefix_hash The hash of the block preceding the new block in the sequence, or std::nullopt for the first block.
+     * @param[in] num_tokens The number of tokens the new block hash was computed for, 0 if unknown.
      * @return A vector of blocks (one for each layer), either freshly allocated or reused for overwriting,
      * or an empty vector if cache is exhausted.
      */
-    BlocksPerLayer allocate_block(size_t hash, std::map<uint64_t, BlocksPerLayer>& cached_blocks) {
+    BlocksPerLayer allocate_block(size_t hash, std::map<uint64_t, BlocksPerLayer>& cached_blocks,
+                                  std::optional<size_t> prefix_hash = std::nullopt, size_t num_tokens = 0) {
         OPENVINO_ASSERT(m_enable_prefix_caching);
         OPENVINO_ASSERT(can_allocate_blocks(1));
 
@@ -435,24 +700,61 @@ public:
                 --m_free_blocks_num[i];
             }
             cached_blocks[hash] = allocated_blocks;
+            m_prefix_tree.insert(hash, prefix_hash, num_tokens);
             return allocated_blocks;
         }
         if (m_overwriteable_blocks.num_blocks() > 0) {
             // get least recently used block from store and reuse it
             BlocksPerLayer blocks_for_all_layers = m_overwriteable_blocks.get_lru_block_to_overwrite();
-            cached_blocks.erase(blocks_for_all_layers[0]->get_hash());
-
-            // update block with new hash
-            for (auto& block : blocks_for_all_layers) {
-                block->set_hash(hash);
+            if (m_overwrite_callback) {
+                m_overwrite_callback(blocks_for_all_layers[0]->get_hash(), blocks_for_all_layers);
             }
-            cached_blocks[hash] = blocks_for_all_layers;
+            update_block_hash(blocks_for_all_layers, hash, cached_blocks, prefix_hash, num_tokens);
             return blocks_for_all_layers;
         }
         // should not be reachable due to the can_allocate_blocks assert in the beginning
         return {};
     }
 
+    /**
+     * Changes the hash of the given allocated blocks, e.g. after a partially filled block received more tokens,
+     * and moves the corresponding entries in the supplied storage map and in the prefix tree under the new hash.
+     * @param blocks_for_all_layers The blocks (one for each layer) to be rehashed.
+     * @param hash The new hash of the blocks.
+     * @param cached_blocks The map of known hashes to already allocated and filled blocks.
+     * @param prefix_hash The hash of the block preceding the rehashed blocks in the sequence, or std::nullopt for the first block.
+     * @param num_tokens The number of tokens the new hash was computed for, 0 if unknown.
+     */
+    void update_block_hash(const BlocksPerLayer& blocks_for_all_layers, size_t hash, std::map<uint64_t, BlocksPerLayer>& cached_blocks,
+                           std::optional<size_t> prefix_hash, size_t num_tokens) {
+        OPENVINO_ASSERT(m_enable_prefix_caching);
+        OPENVINO_ASSERT(!blocks_for_all_layers.empty());
+        size_t prev_hash = blocks_for_all_layers[0]->get_hash();
+        cached_blocks.erase(prev_hash);
+        m_prefix_tree.erase(prev_hash);
+        for (auto& block : blocks_for_all_layers) {
+            block->set_hash(hash);
+        }
+        cached_blocks[hash] = blocks_for_all_layers;
+        m_prefix_tree.insert(hash, prefix_hash, num_tokens);
+    }
+
+    /**
+     * Sets a function to be called each time a cached block from the internal store is about to be reused for
+     * a different hash, while the block still holds the cached contents.
+     * @param callback The function receiving the previous hash of the blocks and the blocks (one for each layer).
+     */
+    void set_overwrite_callback(std::function<void(size_t, const BlocksPerLayer&)> callback) {
+        m_overwrite_callback = std::move(callback);
+    }
+
+    /**
+     * @return The prefix tree over the hashes of the blocks allocated with prefix caching.
+     */
+    const BlockPrefixTree& get_prefix_tree() const {
+        return m_prefix_tree;
+    }
+
     /**
      * Returns the blocks corresponding to a given hash either from the internal allocator store,
      * or from the supplied storage map, or nothing if there are no blocks corresponding to this hash.
@@ -503,6 +805,7 @@ public:
             per_layer_block_list.clear();
         }
         m_overwriteable_blocks.clear();
+        m_prefix_tree.clear();
     }
 };
 
@@ -513,19 +816,115 @@ public:
  * blocks within the block table being associated with "logical" block indices.
  */
 class BlockManager {
+public:
+    /**
+     * @brief A copy of a KV cache block between the device cache and a slot of the prefix cache disk tier.
+     */
+    struct DiskBlockTransfer {
+        // whether the block is stored to disk (true) or loaded from disk (false)
+        bool to_disk;
+        size_t slot;
+        // physical block index for each layer
+        std::vector<size_t> block_indices;
+    };
+
+private:
     friend class CacheStateDumper;
+    friend class PrefixCacheSnapshot;
     BlockAllocator m_allocator;
     bool m_enable_prefix_caching;
     size_t m_block_size;
     size_t m_num_layers;
-    // TODO: caching time can probably be improved if we use the prefix tree
     std::map<uint64_t, BlocksPerLayer> m_prefix_hash_to_occupied_block_map;
 
     // stores blocks for each sequence (not sequence group)
     // the same block can be seen in multiple block_tables for different sequences
     std::map<uint64_t, std::vector<BlocksPerLayer>> m_block_table;
+    // physical block indices mirroring m_block_table, updated along with it so that the scheduler output can refer to
+    // them instead of copying the block tables and the model runner can copy whole rows into the block_indices inputs
+    std::map<uint64_t, BlockIndicesPerLayer> m_block_indices;
 
     std::mutex m_cached_blocks_map_mutex;
+
+    // second-level prefix cache storage, see SchedulerConfig::prefix_cache_disk_size
+    std::shared_ptr<DiskBlockCache> m_disk_cache;
+    std::vector<DiskBlockTransfer> m_pending_disk_transfers;
+    std::mutex m_disk_transfers_mutex;
+
+    std::vector<size_t> _get_block_indices(const BlocksPerLayer& blocks) const {
+        std::vector<size_t> block_indices;
+        block_indices.reserve(blocks.size());
+        for (const auto& block : blocks) {
+            block_indices.push_back(block->get_index());
+        }
+        return block_indices;
+    }
+
+    void _on_block_overwrite(size_t hash, const BlocksPerLayer& blocks) {
+        // partially filled blocks are cheap to recompute and rarely matched, only keep the full ones
+        if (m_allocator.get_prefix_tree().get_num_tokens(hash) != m_block_size) {
+            return;
+        }
+        auto slot = m_disk_cache->put(hash);
+        if (!slot.has_value()) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(m_disk_transfers_mutex);
+        m_pending_disk_transfers.push_back({true, *slot, _get_block_indices(blocks)});
+    }
+
+    BlocksPerLayer _load_block_from_disk(size_t hash, const std::optional<size_t>& prefix_hash) {
+        if (!m_disk_cache || !m_allocator.can_allocate_blocks(1)) {
+            return {};
+        }
+        auto slot = m_disk_cache->acquire(hash);
+        if (!slot.has_value()) {
+            return {};
+        }
+        // may overwrite another cached block, which then gets stored to disk before the loaded contents land
+        BlocksPerLayer blocks = m_allocator.allocate_block(hash, m_prefix_hash_to_occupied_block_map, prefix_hash, m_block_size);
+        std::lock_guard<std::mutex> lock(m_disk_transfers_mutex);
+        m_pending_disk_transfers.push_back({false, *slot, _get_block_indices(blocks)});
+        return blocks;
+    }
+
+    std::optional<size_t> _get_prefix_hash(uint64_t seq_id, size_t logical_block_idx) const {
+        if (logical_block_idx == 0) {
+            return std::nullopt;
+        }
+        return m_block_table.at(seq_id)[0][logical_block_idx - 1]->get_hash();
+    }
+
+    size_t _get_last_block_num_tokens(const SequenceGroup::CPtr& seq_group) const {
+        size_t num_tokens = seq_group->get_context_len() % m_block_size;
+        return num_tokens == 0 ? m_block_size : num_tokens;
+    }
+
+    void _create_block_table(uint64_t seq_id) {
+        m_block_table[seq_id].resize(m_num_layers);
+        m_block_indices[seq_id].resize(m_num_layers);
+    }
+
+    void _erase_block_table(uint64_t seq_id) {
+        OPENVINO_ASSERT(m_block_table.erase(seq_id) == 1);
+        OPENVINO_ASSERT(m_block_indices.erase(seq_id) == 1);
+    }
+
+    void _append_block(uint64_t seq_id, size_t layer_idx, const KVCacheBlock::Ptr& block) {
+        m_block_table[seq_id][layer_idx].push_back(block);
+        m_block_indices[seq_id][layer_idx].push_back(block->get_index());
+    }
+
+    void _set_block(uint64_t seq_id, size_t layer_idx, size_t logical_block_idx, const KVCacheBlock::Ptr& block) {
+        m_block_table[seq_id][layer_idx][logical_block_idx] = block;
+        m_block_indices[seq_id][layer_idx][logical_block_idx] = block->get_index();
+    }
+
+    void _truncate_block_table(uint64_t seq_id, size_t layer_idx, size_t num_blocks) {
+        m_block_table[seq_id][layer_idx].resize(num_blocks);
+        m_block_indices[seq_id][layer_idx].resize(num_blocks);
+    }
+
 public:
     /**
      * Constructs the BlockManager.
@@ -547,6 +946,31 @@ public:
         OPENVINO_ASSERT(m_block_table.empty());
     }
 
+    /**
+     * Enables the disk tier of the prefix cache: fully filled cached blocks are stored to the given disk cache before
+     * being overwritten and looked up there by restore_cached_blocks() if missing from the device cache.
+     * The actual copies are deferred until the device cache is allocated, see take_pending_disk_transfers().
+     * @param disk_cache The disk storage for the blocks.
+     */
+    void set_disk_cache(std::shared_ptr<DiskBlockCache> disk_cache) {
+        OPENVINO_ASSERT(m_enable_prefix_caching, "Prefix cache disk tier requires prefix caching to be enabled");
+        m_disk_cache = std::move(disk_cache);
+        m_allocator.set_overwrite_callback([this](size_t hash, const BlocksPerLayer& blocks) {
+            _on_block_overwrite(hash, blocks);
+        });
+    }
+
+    /**
+     * @return The block copies between the device cache and the disk tier collected since the previous call,
+     * to be performed in order before the device cache is used.
+     */
+    std::vector<DiskBlockTransfer> take_pending_disk_transfers() {
+        std::lock_guard<std::mutex> lock(m_disk_transfers_mutex);
+        std::vector<DiskBlockTransfer> transfers;
+        transfers.swap(m_pending_disk_transfers);
+        return transfers;
+    }
+
     /**
      * Gets the block table for a given sequence.
      * @param seq_id The identifier of an ov::genai::Sequence.
@@ -557,6 +981,16 @@ public:
         return m_block_table.at(seq_id);
     }
 
+    /**
+     * Gets the physical block indices for a given sequence, kept up to date with its block table.
+     * The reference stays valid until the sequence is freed completely.
+     * @param seq_id The identifier of an ov::genai::Sequence.
+     * @return A contiguous row of physical block indices of the logical blocks of this sequence for each layer.
+     */
+    const BlockIndicesPerLayer& get_block_indices(uint64_t seq_id) const {
+        return m_block_indices.at(seq_id);
+    }
+
     /**
      * Gets the block table for a given sequence and given layer.
      * @param seq_id The identifier of an ov::genai::Sequence.
@@ -619,12 +1053,12 @@ public:
         }
         m_allocator.free(blocks_to_free);
         for (size_t layer_idx = 0; layer_idx < m_num_layers; layer_idx++) {
-            block_table[layer_idx].resize(block_table[layer_idx].size() - 1);
+            _truncate_block_table(seq_id, layer_idx, block_table[layer_idx].size() - 1);
         }
 
         if (block_table[0].size() == 0) {
-            OPENVINO_ASSERT(m_block_table.erase(seq_id) == 1);
-         }
+            _erase_block_table(seq_id);
+        }
         return blocks_to_free[0]->is_free();
     }
 
@@ -703,7 +1137,7 @@ public:
 
         auto sequence_id = sequence->get_id();
         if (m_block_table.find(sequence_id) == m_block_table.end()) {
-            m_block_table[sequence_id].resize(m_num_layers);
+            _create_block_table(sequence_id);
         }
 
         auto& block_table = m_block_table[sequence_id][0];
@@ -714,11 +1148,10 @@ public:
 
         if (!m_enable_prefix_caching) {
             for (size_t layer_idx = 0; layer_idx < m_block_table[sequence_id].size(); layer_idx++) {
-                auto& block_table = m_block_table[sequence_id][layer_idx];
                 for (size_t i = 0; i < num_blocks; ++i) {
                     ov::genai::KVCacheBlock::Ptr block = m_allocator.allocate_block(layer_idx);
                     OPENVINO_ASSERT(block != nullptr);
-                    m_block_table[sequence_id][layer_idx].push_back(block);
+                    _append_block(sequence_id, layer_idx, block);
                 }
             }
         } else {
@@ -733,23 +1166,24 @@ public:
                     BlocksPerLayer last_blocks_vec;
                     last_blocks_vec.reserve(m_num_layers);
                     for (size_t layer_idx = 0; layer_idx < m_num_layers; layer_idx++) {
-                        auto& lst_blk = m_block_table[sequence_id][layer_idx].back();
-                        lst_blk->set_hash(hash);
-                        m_prefix_hash_to_occupied_block_map.erase(prev_hash);
-                        last_blocks_vec.push_back(lst_blk);
+                        last_blocks_vec.push_back(m_block_table[sequence_id][layer_idx].back());
                     }
-                    m_prefix_hash_to_occupied_block_map[hash] = last_blocks_vec;
+                    m_allocator.update_block_hash(last_blocks_vec, hash, m_prefix_hash_to_occupied_block_map,
+                                                  _get_prefix_hash(sequence_id, block_table.size() - 1), m_block_size);
                 }
             }
             for (size_t i = 0; i < num_blocks; ++i) {
+                size_t block_start = num_hashed_tokens;
                 num_hashed_tokens += m_block_size;
                 if (num_hashed_tokens > content_length) {
                     num_hashed_tokens = content_length;
                 }
                 auto hash = sequence->get_hash(num_hashed_tokens);
-                auto blocks_for_all_layers = m_allocator.allocate_block(hash, m_prefix_hash_to_occupied_block_map);
+                auto blocks_for_all_layers = m_allocator.allocate_block(hash, m_prefix_hash_to_occupied_block_map,
+                                                                        _get_prefix_hash(sequence_id, block_table.size()),
+                                                                        num_hashed_tokens > block_start ? num_hashed_tokens - block_start : 0);
                 for (size_t layer_idx = 0; layer_idx < blocks_for_all_layers.size(); layer_idx++) {
-                    m_block_table[sequence_id][layer_idx].push_back(blocks_for_all_layers[layer_idx]);
+                    _append_block(sequence_id, layer_idx, blocks_for_all_layers[layer_idx]);
                 }
             }
         }
@@ -770,6 +1204,21 @@ public:
         m_allocator.increase_kv_blocks_number(num_blocks);
     }
 
+    /**
+     * @return The smallest number of KV blocks the cache can be shrunk to, see BlockAllocator::get_min_kv_blocks_number().
+     */
+    size_t get_min_kv_blocks_number() const {
+        return m_allocator.get_min_kv_blocks_number();
+    }
+
+    /**
+     * Decreases the number of KV blocks by removing free blocks with the highest indices.
+     * @param num_blocks The new number of KV-blocks.
+     */
+    void decrease_kv_blocks_number(size_t num_blocks) {
+        m_allocator.decrease_kv_blocks_number(num_blocks);
+    }
+
     /**
      * @return The total number of KV blocks .
      */
@@ -795,6 +1244,7 @@ public:
                 m_block_table[child_id][layer_idx].push_back(block);
             }
         }
+        m_block_indices[child_id] = m_block_indices[parent_id];
     }
 
     /**
@@ -817,7 +1267,7 @@ public:
             m_allocator.free(blocks_to_free);
         }
 
-        OPENVINO_ASSERT(m_block_table.erase(seq_id) == 1);
+        _erase_block_table(seq_id);
     }
 
     /**
@@ -846,8 +1296,7 @@ public:
         }
 
         for (size_t layer_idx = 0; layer_idx < effective_num_layers; layer_idx++) {
-            auto& layer_block_table = m_block_table[seq_id][layer_idx];
-            layer_block_table.resize(layer_block_table.size() - block_num);
+            _truncate_block_table(seq_id, layer_idx, m_block_table[seq_id][layer_idx].size() - block_num);
         }
 
         auto empty_predicate = [](const BlocksPerLayer& v) { return v.empty(); };
@@ -857,7 +1306,7 @@ public:
             // The invariant must hold at BlockManager level that all per-layer block tables
             // must have the same size
             OPENVINO_ASSERT(all_freed_completely, "block tables across layers should only be empty all at once");
-            OPENVINO_ASSERT(m_block_table.erase(seq_id) == 1);
+            _erase_block_table(seq_id);
         }
     }
 
@@ -908,19 +1357,22 @@ public:
         // remove freed entries from the block table at this BlockManager's level
         for (size_t layer_idx = 0; layer_idx < presumed_num_layers; layer_idx++) {
             auto& per_layer_block_table = m_block_table[seq_id][layer_idx];
+            auto& per_layer_block_indices = m_block_indices[seq_id][layer_idx];
             size_t block_table_size = per_layer_block_table.size();
             const auto& per_layer_block_indices_to_free = logical_block_index_sets_to_free[layer_idx];
-            BlocksPerLayer new_sequence_blocks;
             OPENVINO_ASSERT(per_layer_block_indices_to_free.size() <= block_table_size, "too many blocks to free");
-            new_sequence_blocks.reserve(block_table_size - per_layer_block_indices_to_free.size());
+            // compacted in place, the kept blocks preserve their order
+            size_t num_kept_blocks = 0;
             for (size_t logical_block_idx = 0; logical_block_idx < block_table_size; logical_block_idx++) {
                 if (per_layer_block_indices_to_free.find(logical_block_idx) == per_layer_block_indices_to_free.end()) {
                     // idx NOT in the requested set to free, need to keep this block
-                    new_sequence_blocks.push_back(per_layer_block_table[logical_block_idx]);
+                    per_layer_block_table[num_kept_blocks] = per_layer_block_table[logical_block_idx];
+                    per_layer_block_indices[num_kept_blocks] = per_layer_block_indices[logical_block_idx];
+                    num_kept_blocks++;
                 }
             }
 
-            per_layer_block_table = new_sequence_blocks;
+            _truncate_block_table(seq_id, layer_idx, num_kept_blocks);
         }
     }
 
@@ -1003,8 +1455,12 @@ public:
         }
         for (const auto& sequence : seq_group->get_running_sequences()) {
             auto seq_id = sequence->get_id();
-            auto& block_table = m_block_table[seq_id];
-            size_t num_physical_blocks = block_table[0].size();
+            auto block_table_it = m_block_table.find(seq_id);
+            // e.g. the blocks of a swapped out sequence are in host memory until it is swapped in
+            if (block_table_it == m_block_table.end()) {
+                continue;
+            }
+            size_t num_physical_blocks = block_table_it->second[0].size();
             if (num_physical_blocks > num_logical_blocks) {
                 free_sequence_partially(seq_id, num_physical_blocks - num_logical_blocks);
             }
@@ -1058,7 +1514,9 @@ public:
                     new_blocks_for_all_layers.reserve(effective_num_layers);
                     if (m_enable_prefix_caching) {
                         auto hash = sequence->get_hash();
-                        new_blocks_for_all_layers = m_allocator.allocate_block(hash, m_prefix_hash_to_occupied_block_map);
+                        new_blocks_for_all_layers = m_allocator.allocate_block(hash, m_prefix_hash_to_occupied_block_map,
+                                                                               _get_prefix_hash(seq_id, num_physical_blocks - 1),
+                                                                               _get_last_block_num_tokens(seq_group));
                     } else {
                         for (size_t i = 0; i < effective_num_layers; i++) {
                             new_blocks_for_all_layers.push_back(m_allocator.allocate_block(i));
@@ -1067,8 +1525,7 @@ public:
 
                     for (size_t i = 0; i < effective_num_layers; i++) {
                         auto& new_block = new_blocks_for_all_layers[i];
-                        auto& block_table = m_block_table[seq_id][i];
-                        block_table[num_physical_blocks - 1] = new_blocks_for_all_layers[i];
+                        _set_block(seq_id, i, num_physical_blocks - 1, new_block);
                         auto& last_block = last_blocks[i];
                         copy_blocks_map[last_block->get_index()].push_back(new_block->get_index());
                     }
@@ -1077,14 +1534,10 @@ public:
                     // we are the only users of this block
                     if (m_enable_prefix_caching) {
                         // update hash of block
-                        auto prev_hash = last_blocks[0]->get_hash();
                         auto hash = sequence->get_hash();
-                        for (size_t i = 0; i < effective_num_layers; i++) {
-                            auto& last_block = last_blocks[i];
-                            last_block->set_hash(hash);
-                        }
-                        m_prefix_hash_to_occupied_block_map.erase(prev_hash);
-                        m_prefix_hash_to_occupied_block_map[hash] = last_blocks;
+                        m_allocator.update_block_hash(last_blocks, hash, m_prefix_hash_to_occupied_block_map,
+                                                      _get_prefix_hash(seq_id, num_physical_blocks - 1),
+                                                      _get_last_block_num_tokens(seq_group));
                     }
                 }
             }
@@ -1095,8 +1548,8 @@ public:
     }
 
     void restore_cached_blocks(SequenceGroup::Ptr group) {
-        // When add_request() is executed in multiple threads accessing to cached_blocks causes segfault.
-        // The mutex is needed to prevent such segfaults.
+        // The pipelines restore the cached blocks on the step thread, as loading from the disk tier allocates blocks.
+        // The mutex guards the cached blocks map against other callers.
         const std::lock_guard<std::mutex> lock(m_cached_blocks_map_mutex);
         auto prompt_len = group->get_prompt_len();
         auto sequences = group->get_not_finished_sequences();
@@ -1105,10 +1558,14 @@ public:
         auto seq_id = sequence->get_id();
 
         if (m_block_table.find(seq_id) == m_block_table.end()) {
-            m_block_table[seq_id].resize(m_num_layers);
+            _create_block_table(seq_id);
         }
         auto& block_table = m_block_table[seq_id];
 
+        // Longest-prefix match: descend the prefix tree one block at a time, only computing the hashes
+        // of the partially filled blocks actually present among the children of the last matched block.
+        const BlockPrefixTree& prefix_tree = m_allocator.get_prefix_tree();
+        std::optional<size_t> prefix_hash;
         size_t content_len = 0;
         while (content_len < prompt_len) {
             size_t prev_iteration_content_len = content_len;
@@ -1118,22 +1575,32 @@ public:
             }
             // restore fully filled blocks
             auto full_block_hash = sequence->get_hash(content_len);
-            auto blocks = m_allocator.get_cached_block(full_block_hash, m_prefix_hash_to_occupied_block_map);
+            BlocksPerLayer blocks;
+            if (prefix_tree.contains(full_block_hash)) {
+                blocks = m_allocator.get_cached_block(full_block_hash, m_prefix_hash_to_occupied_block_map);
+            }
+            if (blocks.empty() && content_len - prev_iteration_content_len == m_block_size) {
+                blocks = _load_block_from_disk(full_block_hash, prefix_hash);
+            }
             auto timestamp = std::chrono::steady_clock::now();
             if (!blocks.empty()) {
                 for (size_t layer_idx = 0; layer_idx < block_table.size(); layer_idx++) {
                     auto& block = blocks[layer_idx];
                     block->set_timestamp(timestamp);
-                    block_table[layer_idx].push_back(block);
+                    _append_block(seq_id, layer_idx, block);
                 }
                 group->update_processed_tokens_num(content_len == prompt_len ? content_len - 1 : content_len);
+                prefix_hash = full_block_hash;
             } else {
-            // restore partially filled block
-                for (size_t i = 1; i < m_block_size; i++) {
-                    if (prev_iteration_content_len + i > prompt_len) {
-                        break;
+            // restore the longest partially filled block
+                for (size_t num_tokens : prefix_tree.get_children_num_tokens(prefix_hash)) {
+                    if (num_tokens >= m_block_size || prev_iteration_content_len + num_tokens > prompt_len) {
+                        continue;
+                    }
+                    auto hash = sequence->get_hash(prev_iteration_content_len + num_tokens);
+                    if (!prefix_tree.has_child(prefix_hash, hash)) {
+                        continue;
                     }
-                    auto hash = sequence->get_hash(prev_iteration_content_len + i);
                     auto blocks = m_allocator.get_cached_block(hash, m_prefix_hash_to_occupied_block_map);
                     if (!blocks.empty()) {
                         auto timestamp = std::chrono::steady_clock::now();
@@ -1141,9 +1608,9 @@ public:
                         for (size_t layer_idx = 0; layer_idx < block_table.size(); layer_idx++) {
                             auto& block = blocks[layer_idx];
                             block->set_timestamp(timestamp);
-                            block_table[layer_idx].push_back(block);
+                            _append_block(seq_id, layer_idx, block);
                         }
-                        group->update_processed_tokens_num(prev_iteration_content_len + i == prompt_len ? prev_iteration_content_len + i - 1 : prev_iteration_content_len + i);
+                        group->update_processed_tokens_num(prev_iteration_content_len + num_tokens == prompt_len ? prev_iteration_content_len + num_tokens - 1 : prev_iteration_content_len + num_tokens);
 
                         break;
                     }
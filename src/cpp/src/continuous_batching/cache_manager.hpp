@@ -3,10 +3,13 @@
 
 #pragma once
 
+#include <algorithm>
 #include <vector>
 #include <list>
 
 #include "openvino/runtime/tensor.hpp"
+#include "continuous_batching/reserved_memory.hpp"
+#include "threadpool.hpp"
 #include "utils.hpp"
 namespace ov::genai {
 
@@ -17,7 +20,12 @@ class CacheManager {
     std::vector<ov::element::Type> m_key_precisions, m_value_precisions;
     std::vector<ov::PartialShape> m_key_shapes, m_value_shapes;
     std::vector<ov::Tensor> m_key_cache, m_value_cache;
-    size_t m_num_allocated_kv_blocks = 0, m_block_size_in_bytes = 0;
+    // memory of the host KV caches, reserved for the largest possible cache so that it grows without copying,
+    // the tensors are recreated after each resize since the memory may fall back to a regular allocation
+    std::vector<std::unique_ptr<ReservedMemory>> m_key_cache_memory, m_value_cache_memory;
+    // host-side swap space with the same per-layer layout as the KV cache
+    std::vector<ov::Tensor> m_host_key_cache, m_host_value_cache;
+    size_t m_num_allocated_kv_blocks = 0, m_block_size_in_bytes = 0, m_num_allocated_host_blocks = 0;
     ov::InferRequest m_request;
     ov::RemoteContext m_context;
 
@@ -31,6 +39,134 @@ class CacheManager {
         m_request.set_tensor(std::string("value_cache.") + std::to_string(decoder_layer_id), m_value_cache[decoder_layer_id]);
     }
 
+    ov::Tensor create_host_tensor(const ov::element::Type& precision, const ov::Shape& shape) {
+        // on GPU use host memory registered within device context to speed up transfers
+        return m_context ? m_context.create_host_tensor(precision, shape) : ov::Tensor(precision, shape);
+    }
+
+    static size_t get_byte_size(const ov::element::Type& precision, const ov::Shape& shape) {
+        return (ov::shape_size(shape) * precision.bitwidth() + 7) / 8;
+    }
+
+    ov::Tensor resize_host_tensor(std::unique_ptr<ReservedMemory>& memory, const ov::Tensor& tensor,
+                                  const ov::element::Type& precision, const ov::Shape& shape) {
+        size_t byte_size = get_byte_size(precision, shape);
+        if (!memory || memory->get_capacity() < byte_size) {
+            // the first allocation reserves enough address space for a cache filling the physical memory
+            size_t block_byte_size = get_byte_size(precision, set_kv_blocks(shape, 1));
+            size_t max_num_kv_blocks = m_block_size_in_bytes > 0 ? ReservedMemory::get_physical_memory_size() / m_block_size_in_bytes : 0;
+            auto new_memory = std::make_unique<ReservedMemory>(std::max(byte_size, max_num_kv_blocks * block_byte_size));
+            new_memory->resize(byte_size);
+            if (memory && tensor) {
+                // only reached if the reservation turned out to be too small
+                std::memcpy(new_memory->data(), memory->data(), tensor.get_byte_size());
+            }
+            memory = std::move(new_memory);
+        } else {
+            memory->resize(byte_size);
+        }
+        return ov::Tensor(precision, shape, memory->data());
+    }
+
+    void resize_host_cache(size_t decoder_layer_id, size_t num_kv_blocks) {
+        if (m_key_cache.size() <= decoder_layer_id) {
+            m_key_cache.resize(decoder_layer_id + 1);
+            m_value_cache.resize(decoder_layer_id + 1);
+            m_key_cache_memory.resize(decoder_layer_id + 1);
+            m_value_cache_memory.resize(decoder_layer_id + 1);
+        }
+        m_key_cache[decoder_layer_id] = resize_host_tensor(m_key_cache_memory[decoder_layer_id], m_key_cache[decoder_layer_id],
+            get_key_cache_precision(decoder_layer_id), set_kv_blocks(m_key_shapes[decoder_layer_id], num_kv_blocks));
+        m_value_cache[decoder_layer_id] = resize_host_tensor(m_value_cache_memory[decoder_layer_id], m_value_cache[decoder_layer_id],
+            get_value_cache_precision(decoder_layer_id), set_kv_blocks(m_value_shapes[decoder_layer_id], num_kv_blocks));
+    }
+
+    void copy_block(const ov::Tensor& src, size_t src_block_id, ov::Tensor& dst, size_t dst_block_id) {
+        const ov::element::Type& precision = src.get_element_type();
+        if (precision == ov::element::u4 || precision == ov::element::i4) {
+            OPENVINO_ASSERT(!src.is<ov::RemoteTensor>() && !dst.is<ov::RemoteTensor>(), "Swapping of sub-byte KV cache blocks is not supported for remote tensors");
+            const ov::Shape& shape = src.get_shape();
+            size_t stride = std::accumulate(std::next(shape.begin()), shape.end(), 1, std::multiplies<size_t>()) / sub_byte_data_type_multiplier(precision);
+            std::memcpy(reinterpret_cast<uint8_t*>(dst.data()) + dst_block_id * stride, reinterpret_cast<const uint8_t*>(src.data()) + src_block_id * stride, stride);
+            return;
+        }
+
+        auto block_roi = [](const ov::Shape& shape, size_t block_id) {
+            ov::Coordinate start(shape.size(), 0), end = shape;
+            end[0] = (start[0] = block_id) + 1;
+            return std::make_pair(start, end);
+        };
+        auto [src_start, src_end] = block_roi(src.get_shape(), src_block_id);
+        auto [dst_start, dst_end] = block_roi(dst.get_shape(), dst_block_id);
+        if (src.is<ov::RemoteTensor>()) {
+            ov::RemoteTensor src_roi(src, src_start, src_end);
+            ov::Tensor dst_roi(dst, dst_start, dst_end);
+            src_roi.copy_to(dst_roi);
+        } else if (dst.is<ov::RemoteTensor>()) {
+            ov::RemoteTensor dst_roi(dst, dst_start, dst_end);
+            dst_roi.copy_from(ov::Tensor(src, src_start, src_end));
+        } else {
+            ov::Tensor dst_roi(dst, dst_start, dst_end);
+            ov::Tensor(src, src_start, src_end).copy_to(dst_roi);
+        }
+    }
+
+    // copy of num_blocks consecutive blocks starting at src_block_id into the blocks starting at dst_block_id
+    struct BlockCopyRun {
+        size_t src_block_id;
+        size_t dst_block_id;
+        size_t num_blocks;
+    };
+
+    static std::vector<BlockCopyRun> coalesce_block_copies(const std::map<size_t, std::list<size_t>>& block_copy_map) {
+        std::vector<std::pair<size_t, size_t>> src_dst_pairs;
+        for (const auto& [src_block_id, dst_block_ids] : block_copy_map) {
+            for (size_t dst_block_id : dst_block_ids) {
+                src_dst_pairs.emplace_back(src_block_id, dst_block_id);
+            }
+        }
+        std::sort(src_dst_pairs.begin(), src_dst_pairs.end());
+
+        std::vector<BlockCopyRun> runs;
+        for (const auto& [src_block_id, dst_block_id] : src_dst_pairs) {
+            if (!runs.empty()) {
+                BlockCopyRun& run = runs.back();
+                if (run.src_block_id + run.num_blocks == src_block_id && run.dst_block_id + run.num_blocks == dst_block_id) {
+                    ++run.num_blocks;
+                    continue;
+                }
+            }
+            runs.push_back({src_block_id, dst_block_id, 1});
+        }
+        return runs;
+    }
+
+    void copy_block_runs(ov::Tensor& cache, const std::vector<BlockCopyRun>& runs) {
+        if (cache.is<ov::RemoteTensor>()) {
+            const ov::element::Type& precision = cache.get_element_type();
+            OPENVINO_ASSERT(precision != ov::element::u4 && precision != ov::element::i4, "Copying of sub-byte KV cache blocks is not supported for remote tensors");
+            const ov::Shape& shape = cache.get_shape();
+            for (const auto& run : runs) {
+                ov::Coordinate src_start(shape.size(), 0), src_end = shape, dst_start(shape.size(), 0), dst_end = shape;
+                src_end[0] = (src_start[0] = run.src_block_id) + run.num_blocks;
+                dst_end[0] = (dst_start[0] = run.dst_block_id) + run.num_blocks;
+                ov::RemoteTensor dst_roi(cache, dst_start, dst_end);
+                dst_roi.copy_from(ov::RemoteTensor(cache, src_start, src_end));
+            }
+            return;
+        }
+
+        // blocks are the outermost dimension, so a run of blocks is a contiguous byte range; this also holds for sub-byte precisions
+        size_t num_blocks = cache.get_shape()[0];
+        OPENVINO_ASSERT(num_blocks > 0);
+        size_t block_size_in_bytes = cache.get_byte_size() / num_blocks;
+        uint8_t* data = static_cast<uint8_t*>(cache.data());
+        for (const auto& run : runs) {
+            OPENVINO_ASSERT(std::max(run.src_block_id, run.dst_block_id) + run.num_blocks <= num_blocks);
+            std::memcpy(data + run.dst_block_id * block_size_in_bytes, data + run.src_block_id * block_size_in_bytes, run.num_blocks * block_size_in_bytes);
+        }
+    }
+
 public:
     explicit CacheManager(ov::InferRequest request) :
         m_request(request) {
@@ -117,6 +253,16 @@ public:
         return m_block_size_in_bytes;
     }
 
+    ov::Shape get_key_block_shape(size_t decoder_layer_id) const {
+        OPENVINO_ASSERT(decoder_layer_id < m_key_shapes.size());
+        return set_kv_blocks(m_key_shapes[decoder_layer_id], 1);
+    }
+
+    ov::Shape get_value_block_shape(size_t decoder_layer_id) const {
+        OPENVINO_ASSERT(decoder_layer_id < m_value_shapes.size());
+        return set_kv_blocks(m_value_shapes[decoder_layer_id], 1);
+    }
+
     size_t sub_byte_data_type_multiplier(const ov::element::Type data_type) const {
         if (data_type == ov::element::i4 || data_type == ov::element::u4)
             return 2;
@@ -165,56 +311,7 @@ public:
                 }
             } else {
                 for (size_t decoder_layer_id = 0; decoder_layer_id < m_num_decoder_layers; ++decoder_layer_id) {
-                    ov::Shape value_cache_shape = set_kv_blocks(m_value_shapes[decoder_layer_id], num_kv_blocks);
-                    ov::Shape key_cache_shape = set_kv_blocks(m_key_shapes[decoder_layer_id], num_kv_blocks);
-
-                    ov::element::Type key_precision = get_key_cache_precision(decoder_layer_id);
-                    ov::element::Type value_precision = get_value_cache_precision(decoder_layer_id);
-
-                    ov::Tensor key_cache(key_precision, key_cache_shape);
-                    ov::Tensor value_cache(value_precision, value_cache_shape);
-
-                    auto key_cache_roi_end = static_cast<unsigned char*>(key_cache.data());
-                    auto value_cache_roi_end = static_cast<unsigned char*>(value_cache.data());
-                    size_t key_roi_size_byte = 0;
-                    size_t value_roi_size_byte = 0;
-
-                    if (m_key_cache.size() > decoder_layer_id && m_key_cache[decoder_layer_id]) {
-                        ov::Coordinate end_key = m_key_cache[decoder_layer_id].get_shape();
-                        ov::Coordinate end_value = m_value_cache[decoder_layer_id].get_shape();
-                        // copy current cache data
-                        if (key_precision == ov::element::u4) {
-                            size_t key_stride = std::accumulate(end_key.begin(), end_key.end(), 1, std::multiplies<size_t>());
-                            size_t key_roi_size_byte = key_stride + (key_stride & 1) / sub_byte_data_type_multiplier(key_precision);
-                            std::memcpy(reinterpret_cast<uint8_t*>(key_cache.data()), reinterpret_cast<uint8_t*>(m_key_cache[decoder_layer_id].data()), key_roi_size_byte);
-                        } else {
-                            key_roi_size_byte = m_key_cache[decoder_layer_id].get_byte_size();
-                            ov::Tensor dst_key_roi(key_cache, start_key, end_key);
-                            key_cache_roi_end = static_cast<unsigned char*>(key_cache.data()) + key_roi_size_byte;
-                            m_key_cache[decoder_layer_id].copy_to(dst_key_roi);
-                        }
-
-                        if (value_precision == ov::element::u4) {
-                            size_t value_stride = std::accumulate(end_value.begin(), end_value.end(), 1, std::multiplies<size_t>());
-                            size_t value_roi_size_byte = value_stride + (value_stride & 1) / sub_byte_data_type_multiplier(value_precision);
-                            std::memcpy(reinterpret_cast<uint8_t*>(value_cache.data()), reinterpret_cast<uint8_t*>(m_value_cache[decoder_layer_id].data()), value_roi_size_byte);
-                        } else {
-                            value_roi_size_byte = m_value_cache[decoder_layer_id].get_byte_size();
-                            value_cache_roi_end = static_cast<unsigned char*>(value_cache.data()) + value_roi_size_byte;
-                            ov::Tensor dst_value_roi(value_cache, start_value, end_value);
-                            m_value_cache[decoder_layer_id].copy_to(dst_value_roi);
-                        }
-                    }
-
-                    // set new cache tensors
-                    if (m_key_cache.size() > decoder_layer_id) {
-                        m_key_cache[decoder_layer_id] = key_cache;
-                        m_value_cache[decoder_layer_id] = value_cache;
-                    } else {
-                        m_key_cache.emplace_back(key_cache);
-                        m_value_cache.emplace_back(value_cache);
-                    }
-
+                    resize_host_cache(decoder_layer_id, num_kv_blocks);
                     update_request_tensor(decoder_layer_id);
                 }
             }
@@ -228,6 +325,30 @@ public:
         }
     }
 
+    /**
+     * @return Whether the KV cache can be shrunk by shrink_cache(), which is the case for the caches in host memory.
+     */
+    bool can_shrink_cache() const {
+        return !m_context;
+    }
+
+    /**
+     * Shrinks the KV cache to the given number of blocks, returning the memory of the trailing blocks to the OS.
+     * The contents of the remaining blocks are preserved.
+     * @param num_kv_blocks The new number of KV cache blocks, nothing is done if it is not less than the currently allocated number.
+     */
+    void shrink_cache(size_t num_kv_blocks) {
+        OPENVINO_ASSERT(can_shrink_cache(), "KV cache shrinking is only supported for caches in host memory");
+        if (num_kv_blocks >= m_num_allocated_kv_blocks) {
+            return;
+        }
+        for (size_t decoder_layer_id = 0; decoder_layer_id < m_num_decoder_layers; ++decoder_layer_id) {
+            resize_host_cache(decoder_layer_id, num_kv_blocks);
+            update_request_tensor(decoder_layer_id);
+        }
+        m_num_allocated_kv_blocks = num_kv_blocks;
+    }
+
     ov::Tensor get_key_cache(size_t decoder_layer_id) const {
         OPENVINO_ASSERT(decoder_layer_id < m_key_cache.size(), "decoder_layer_id = ", decoder_layer_id, ", num_layers = ", m_key_cache.size());
         return m_key_cache[decoder_layer_id];
@@ -242,62 +363,125 @@ public:
         return m_value_shapes[layer_id][3].get_length();
     }
 
+    /**
+     * Copies the contents of KV cache blocks into other blocks of all decoder layers, e.g. for the copy-on-write of blocks
+     * shared by forked sequences. Copies between consecutive blocks are coalesced into runs, each run is copied with a single
+     * copy per cache tensor; host caches of different layers are copied in parallel.
+     * @param block_copy_map A map where each key is a source block index and the value is a list of destination block indices.
+     */
     void copy_blocks(const std::map<size_t, std::list<size_t>>& block_copy_map) {
-        for (const auto & blocks_pair : block_copy_map) {
-            size_t src_block_id = blocks_pair.first;
-            const std::list<size_t>& dst_block_ids = blocks_pair.second;
-            for (size_t dst_block_id : dst_block_ids) {
-                for (size_t decoder_layer_id = 0; decoder_layer_id < m_num_decoder_layers; ++decoder_layer_id) {
-                    ov::Shape key_shape = set_kv_blocks(m_key_shapes[decoder_layer_id], m_num_allocated_kv_blocks);
-                    ov::Shape value_shape = set_kv_blocks(m_value_shapes[decoder_layer_id], m_num_allocated_kv_blocks);
-                    ov::Coordinate key_src_start_roi(key_shape.size(), 0);
-                    ov::Coordinate key_src_end_roi = key_shape;
-                    ov::Coordinate key_dst_start_roi(key_shape.size(), 0);
-                    ov::Coordinate key_dst_end_roi = key_shape;
-
-                    ov::Coordinate value_src_start_roi(value_shape.size(), 0);
-                    ov::Coordinate value_src_end_roi = value_shape;
-                    ov::Coordinate value_dst_start_roi(value_shape.size(), 0);
-                    ov::Coordinate value_dst_end_roi = value_shape;
-                    key_src_end_roi[0] = (key_src_start_roi[0] = src_block_id) + 1;
-                    value_src_end_roi[0] = (value_src_start_roi[0] = src_block_id) + 1;
-                    key_dst_end_roi[0] = (key_dst_start_roi[0] = dst_block_id) + 1;
-                    value_dst_end_roi[0] = (value_dst_start_roi[0] = dst_block_id) + 1;
-
-                    auto copy_one_block = [&](ov::Tensor& dst, const ov::Tensor& src, size_t src_start, size_t dst_start, size_t stride) {
-                        const bool is_remote = dst.is<ov::RemoteTensor>() || src.is<ov::RemoteTensor>();
-                        if (is_remote) {
-                            return;
-                        }
-                        auto sub_byte_multipyer = sub_byte_data_type_multiplier(dst.get_element_type());
-                        OPENVINO_SUPPRESS_DEPRECATED_START
-                        const uint8_t* src_ptr = reinterpret_cast<const uint8_t*>(src.data()) + src_start * stride;
-                        uint8_t* dst_ptr = reinterpret_cast<uint8_t*>(dst.data()) + dst_start * stride;
-                        OPENVINO_SUPPRESS_DEPRECATED_END
-                        std::memcpy(dst_ptr, src_ptr, 1 * stride);
-                    };
-
-                    const auto& key_cache_prec = m_key_cache[decoder_layer_id].get_element_type();
-                    if (key_cache_prec == ov::element::u4 || key_cache_prec == ov::element::i4) {
-                        size_t stride = std::accumulate(std::next(key_shape.begin()), key_shape.end(), 1, std::multiplies<size_t>()) / 2;
-                        copy_one_block(m_key_cache[decoder_layer_id], m_key_cache[decoder_layer_id], key_src_start_roi[0], key_dst_start_roi[0], stride);
-                    } else {
-                        ov::Tensor key_src_cache_roi(m_key_cache[decoder_layer_id], key_src_start_roi, key_src_end_roi);
-                        ov::Tensor key_dst_cache_roi(m_key_cache[decoder_layer_id], key_dst_start_roi, key_dst_end_roi);
-                        key_src_cache_roi.copy_to(key_dst_cache_roi);
-                    }
+        std::vector<BlockCopyRun> runs = coalesce_block_copies(block_copy_map);
+        if (runs.empty()) {
+            return;
+        }
 
-                    const auto& value_cache_prec = m_value_cache[decoder_layer_id].get_element_type();
-                    if (value_cache_prec == ov::element::u4 || value_cache_prec == ov::element::i4) {
-                        size_t stride = std::accumulate(std::next(value_shape.begin()), value_shape.end(), 1, std::multiplies<size_t>()) / 2;
-                        copy_one_block(m_value_cache[decoder_layer_id], m_value_cache[decoder_layer_id], value_src_start_roi[0], value_dst_start_roi[0], stride);
-                    } else {
-                        ov::Tensor value_src_cache_roi(m_value_cache[decoder_layer_id], value_src_start_roi, value_src_end_roi);
-                        ov::Tensor value_dst_cache_roi(m_value_cache[decoder_layer_id], value_dst_start_roi, value_dst_end_roi);
-                        value_src_cache_roi.copy_to(value_dst_cache_roi);
-                    }
-                }
+        if (m_context) {
+            // device copies are enqueued by a single thread, the device executes them in order
+            for (size_t decoder_layer_id = 0; decoder_layer_id < m_num_decoder_layers; ++decoder_layer_id) {
+                copy_block_runs(m_key_cache[decoder_layer_id], runs);
+                copy_block_runs(m_value_cache[decoder_layer_id], runs);
             }
+            return;
+        }
+
+        ThreadPool::get_shared().parallel_for(2 * m_num_decoder_layers, [&](size_t i) {
+            size_t decoder_layer_id = i / 2;
+            copy_block_runs(i % 2 == 0 ? m_key_cache[decoder_layer_id] : m_value_cache[decoder_layer_id], runs);
+        });
+    }
+
+    /**
+     * Grows the host-side swap space so that it can hold at least the given number of blocks, preserving the contents
+     * of the already allocated ones. Each swap space block holds key and value caches for all decoder layers.
+     * @param num_host_blocks The required number of blocks in the swap space.
+     */
+    void allocate_swap_space_if_needed(size_t num_host_blocks) {
+        if (m_num_allocated_host_blocks >= num_host_blocks) {
+            return;
+        }
+        m_host_key_cache.resize(m_num_decoder_layers);
+        m_host_value_cache.resize(m_num_decoder_layers);
+        for (size_t decoder_layer_id = 0; decoder_layer_id < m_num_decoder_layers; ++decoder_layer_id) {
+            ov::Tensor key_cache = create_host_tensor(get_key_cache_precision(decoder_layer_id), set_kv_blocks(m_key_shapes[decoder_layer_id], num_host_blocks));
+            ov::Tensor value_cache = create_host_tensor(get_value_cache_precision(decoder_layer_id), set_kv_blocks(m_value_shapes[decoder_layer_id], num_host_blocks));
+            if (m_num_allocated_host_blocks > 0) {
+                // blocks are the outermost dimension, so the previous contents are the prefix of the new tensors
+                std::memcpy(key_cache.data(), m_host_key_cache[decoder_layer_id].data(), m_host_key_cache[decoder_layer_id].get_byte_size());
+                std::memcpy(value_cache.data(), m_host_value_cache[decoder_layer_id].data(), m_host_value_cache[decoder_layer_id].get_byte_size());
+            }
+            m_host_key_cache[decoder_layer_id] = key_cache;
+            m_host_value_cache[decoder_layer_id] = value_cache;
+        }
+        m_num_allocated_host_blocks = num_host_blocks;
+    }
+
+    /**
+     * Copies KV cache blocks from the device cache into the host swap space.
+     * @param per_layer_device_to_host_blocks For each decoder layer, pairs of (device block index, host block index) to copy.
+     */
+    void swap_out(const std::vector<std::vector<std::pair<size_t, size_t>>>& per_layer_device_to_host_blocks) {
+        OPENVINO_ASSERT(per_layer_device_to_host_blocks.size() <= m_num_decoder_layers);
+        for (size_t decoder_layer_id = 0; decoder_layer_id < per_layer_device_to_host_blocks.size(); ++decoder_layer_id) {
+            for (const auto& [device_block_id, host_block_id] : per_layer_device_to_host_blocks[decoder_layer_id]) {
+                OPENVINO_ASSERT(device_block_id < m_num_allocated_kv_blocks && host_block_id < m_num_allocated_host_blocks);
+                copy_block(m_key_cache[decoder_layer_id], device_block_id, m_host_key_cache[decoder_layer_id], host_block_id);
+                copy_block(m_value_cache[decoder_layer_id], device_block_id, m_host_value_cache[decoder_layer_id], host_block_id);
+            }
+        }
+    }
+
+    /**
+     * Copies KV cache blocks from the host swap space back into the device cache.
+     * @param per_layer_host_to_device_blocks For each decoder layer, pairs of (host block index, device block index) to copy.
+     */
+    void swap_in(const std::vector<std::vector<std::pair<size_t, size_t>>>& per_layer_host_to_device_blocks) {
+        OPENVINO_ASSERT(per_layer_host_to_device_blocks.size() <= m_num_decoder_layers);
+        for (size_t decoder_layer_id = 0; decoder_layer_id < per_layer_host_to_device_blocks.size(); ++decoder_layer_id) {
+            for (const auto& [host_block_id, device_block_id] : per_layer_host_to_device_blocks[decoder_layer_id]) {
+                OPENVINO_ASSERT(device_block_id < m_num_allocated_kv_blocks && host_block_id < m_num_allocated_host_blocks);
+                copy_block(m_host_key_cache[decoder_layer_id], host_block_id, m_key_cache[decoder_layer_id], device_block_id);
+                copy_block(m_host_value_cache[decoder_layer_id], host_block_id, m_value_cache[decoder_layer_id], device_block_id);
+            }
+        }
+    }
+
+    /**
+     * Copies a KV cache block of all decoder layers from the device cache into a contiguous host buffer,
+     * key and value caches of each layer one after another.
+     * @param per_layer_block_ids The device block index for each decoder layer.
+     * @param dst The buffer of at least get_block_size_in_bytes() bytes.
+     */
+    void store_block(const std::vector<size_t>& per_layer_block_ids, uint8_t* dst) {
+        OPENVINO_ASSERT(per_layer_block_ids.size() == m_num_decoder_layers);
+        for (size_t decoder_layer_id = 0; decoder_layer_id < m_num_decoder_layers; ++decoder_layer_id) {
+            size_t block_id = per_layer_block_ids[decoder_layer_id];
+            OPENVINO_ASSERT(block_id < m_num_allocated_kv_blocks);
+            ov::Tensor key_block(get_key_cache_precision(decoder_layer_id), set_kv_blocks(m_key_shapes[decoder_layer_id], 1), dst);
+            copy_block(m_key_cache[decoder_layer_id], block_id, key_block, 0);
+            dst += key_block.get_byte_size();
+            ov::Tensor value_block(get_value_cache_precision(decoder_layer_id), set_kv_blocks(m_value_shapes[decoder_layer_id], 1), dst);
+            copy_block(m_value_cache[decoder_layer_id], block_id, value_block, 0);
+            dst += value_block.get_byte_size();
+        }
+    }
+
+    /**
+     * Copies a KV cache block of all decoder layers from a contiguous host buffer filled by store_block() into the device cache.
+     * @param src The buffer holding the block contents.
+     * @param per_layer_block_ids The device block index for each decoder layer.
+     */
+    void load_block(const uint8_t* src, const std::vector<size_t>& per_layer_block_ids) {
+        OPENVINO_ASSERT(per_layer_block_ids.size() == m_num_decoder_layers);
+        uint8_t* data = const_cast<uint8_t*>(src);
+        for (size_t decoder_layer_id = 0; decoder_layer_id < m_num_decoder_layers; ++decoder_layer_id) {
+            size_t block_id = per_layer_block_ids[decoder_layer_id];
+            OPENVINO_ASSERT(block_id < m_num_allocated_kv_blocks);
+            ov::Tensor key_block(get_key_cache_precision(decoder_layer_id), set_kv_blocks(m_key_shapes[decoder_layer_id], 1), data);
+            copy_block(key_block, 0, m_key_cache[decoder_layer_id], block_id);
+            data += key_block.get_byte_size();
+            ov::Tensor value_block(get_value_cache_precision(decoder_layer_id), set_kv_blocks(m_value_shapes[decoder_layer_id], 1), data);
+            copy_block(value_block, 0, m_value_cache[decoder_layer_id], block_id);
+            data += value_block.get_byte_size();
         }
     }
 
@@ -306,6 +490,13 @@ public:
             m_key_cache[decoder_layer_id] = ov::Tensor();
             m_value_cache[decoder_layer_id] = ov::Tensor();
         }
+        // the address space stays reserved for the next allocation
+        for (auto& memory : m_key_cache_memory) {
+            memory->resize(0);
+        }
+        for (auto& memory : m_value_cache_memory) {
+            memory->resize(0);
+        }
         m_num_allocated_kv_blocks = 0;
     }
 };
@@ -0,0 +1,212 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "openvino/core/except.hpp"
+#include "continuous_batching/disk_block_cache.hpp"
+
+namespace {
+
+std::filesystem::path get_unique_file_path(const std::filesystem::path& dir) {
+    static std::atomic<size_t> counter{0};
+#ifdef _WIN32
+    const auto pid = _getpid();
+#else
+    const auto pid = getpid();
+#endif
+    std::filesystem::path base_dir = dir.empty() ? std::filesystem::temp_directory_path() : dir;
+    return base_dir / ("openvino_genai_prefix_cache_" + std::to_string(pid) + "_" + std::to_string(counter++) + ".bin");
+}
+
+#ifndef _WIN32
+// allocates the disk space of the whole file, returns 0 or the error code
+int allocate_file(int fd, size_t file_size) {
+#ifdef __APPLE__
+    fstore_t store = {F_ALLOCATEALL, F_PEOFPOSMODE, 0, static_cast<off_t>(file_size), 0};
+    if (fcntl(fd, F_PREALLOCATE, &store) == -1) {
+        return errno;
+    }
+    return ftruncate(fd, static_cast<off_t>(file_size)) == 0 ? 0 : errno;
+#else
+    return posix_fallocate(fd, 0, static_cast<off_t>(file_size));
+#endif
+}
+#endif
+
+} // namespace
+
+namespace ov::genai {
+
+DiskBlockCache::DiskBlockCache(const std::filesystem::path& dir, size_t num_slots, size_t slot_byte_size) :
+    m_path(get_unique_file_path(dir)), m_num_slots(num_slots), m_slot_byte_size(slot_byte_size) {
+    OPENVINO_ASSERT(num_slots > 0 && slot_byte_size > 0, "Prefix cache disk tier must have a non-zero size");
+    _map_file();
+    m_free_slots.reserve(m_num_slots);
+    // hand out the slots in ascending order
+    for (size_t slot = m_num_slots; slot > 0; --slot) {
+        m_free_slots.push_back(slot - 1);
+    }
+}
+
+DiskBlockCache::~DiskBlockCache() {
+    _unmap_file();
+    std::error_code ec;
+    std::filesystem::remove(m_path, ec);
+}
+
+#ifdef _WIN32
+
+void DiskBlockCache::_map_file() {
+    const uint64_t file_size = static_cast<uint64_t>(m_num_slots) * m_slot_byte_size;
+    HANDLE file = CreateFileW(m_path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                              FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+    OPENVINO_ASSERT(file != INVALID_HANDLE_VALUE, "Failed to create prefix cache file ", m_path.string());
+    // the clusters of a non-sparse file are allocated when it is extended, so a full disk is reported here
+    LARGE_INTEGER end_of_file;
+    end_of_file.QuadPart = static_cast<LONGLONG>(file_size);
+    if (!SetFilePointerEx(file, end_of_file, nullptr, FILE_BEGIN) || !SetEndOfFile(file)) {
+        const DWORD error = GetLastError();
+        CloseHandle(file);
+        OPENVINO_THROW("Failed to allocate ", file_size, " bytes for prefix cache file ", m_path.string(), ", error code ", error);
+    }
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(file_size >> 32),
+                                        static_cast<DWORD>(file_size & 0xFFFFFFFF), nullptr);
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        OPENVINO_THROW("Failed to map prefix cache file ", m_path.string());
+    }
+    void* data = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    if (data == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        OPENVINO_THROW("Failed to map prefix cache file ", m_path.string());
+    }
+    m_file_handle = file;
+    m_mapping_handle = mapping;
+    m_data = static_cast<uint8_t*>(data);
+}
+
+void DiskBlockCache::_unmap_file() {
+    if (m_data != nullptr) {
+        UnmapViewOfFile(m_data);
+        m_data = nullptr;
+    }
+    if (m_mapping_handle != nullptr) {
+        CloseHandle(m_mapping_handle);
+        m_mapping_handle = nullptr;
+    }
+    if (m_file_handle != nullptr) {
+        CloseHandle(m_file_handle);
+        m_file_handle = nullptr;
+    }
+}
+
+#else
+
+void DiskBlockCache::_map_file() {
+    const size_t file_size = m_num_slots * m_slot_byte_size;
+    int fd = open(m_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    OPENVINO_ASSERT(fd != -1, "Failed to create prefix cache file ", m_path.string());
+    // a sparse file would get its disk space on the first write to each page of the mapping, which raises SIGBUS
+    // if the disk is full, so the space is allocated upfront
+    if (const int error = allocate_file(fd, file_size)) {
+        close(fd);
+        std::filesystem::remove(m_path);
+        OPENVINO_THROW("Failed to allocate ", file_size, " bytes for prefix cache file ", m_path.string(), ": ", std::strerror(error));
+    }
+    void* data = mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        close(fd);
+        std::filesystem::remove(m_path);
+        OPENVINO_THROW("Failed to map prefix cache file ", m_path.string());
+    }
+    m_fd = fd;
+    m_data = static_cast<uint8_t*>(data);
+}
+
+void DiskBlockCache::_unmap_file() {
+    if (m_data != nullptr) {
+        munmap(m_data, m_num_slots * m_slot_byte_size);
+        m_data = nullptr;
+    }
+    if (m_fd != -1) {
+        close(m_fd);
+        m_fd = -1;
+    }
+}
+
+#endif
+
+bool DiskBlockCache::contains(size_t hash) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_index.count(hash) != 0;
+}
+
+std::optional<size_t> DiskBlockCache::put(size_t hash) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t slot;
+    auto it = m_index.find(hash);
+    if (it != m_index.end()) {
+        slot = it->second->second;
+        m_lru.erase(it->second);
+    } else if (!m_free_slots.empty()) {
+        slot = m_free_slots.back();
+        m_free_slots.pop_back();
+    } else if (!m_lru.empty()) {
+        // overwrite the least recently stored block
+        slot = m_lru.back().second;
+        m_index.erase(m_lru.back().first);
+        m_lru.pop_back();
+    } else {
+        return std::nullopt;
+    }
+    m_lru.emplace_front(hash, slot);
+    m_index[hash] = m_lru.begin();
+    return slot;
+}
+
+std::optional<size_t> DiskBlockCache::acquire(size_t hash) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_index.find(hash);
+    if (it == m_index.end()) {
+        return std::nullopt;
+    }
+    size_t slot = it->second->second;
+    m_lru.erase(it->second);
+    m_index.erase(it);
+    return slot;
+}
+
+void DiskBlockCache::release(size_t slot) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    OPENVINO_ASSERT(slot < m_num_slots);
+    m_free_slots.push_back(slot);
+}
+
+uint8_t* DiskBlockCache::get_slot_data(size_t slot) {
+    OPENVINO_ASSERT(slot < m_num_slots);
+    return m_data + slot * m_slot_byte_size;
+}
+
+size_t DiskBlockCache::num_blocks() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_index.size();
+}
+
+}
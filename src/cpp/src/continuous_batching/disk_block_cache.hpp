@@ -0,0 +1,110 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace ov::genai {
+
+/**
+ * @brief Second-level storage for the prefix cache. Keeps the contents of fully filled KV cache blocks (key and value
+ * caches of all decoder layers) in fixed-size slots of a memory-mapped file, keyed by the block hash. When all slots
+ * are occupied, the least recently stored block is dropped to make room for a new one.
+ * The file is created on construction and removed on destruction. The disk space of the whole file is allocated on
+ * construction, which throws if the disk is full, so that writing a block to the mapping does not fault later.
+ */
+class DiskBlockCache {
+    std::filesystem::path m_path;
+    size_t m_num_slots;
+    size_t m_slot_byte_size;
+    uint8_t* m_data = nullptr;
+#ifdef _WIN32
+    void* m_file_handle = nullptr;
+    void* m_mapping_handle = nullptr;
+#else
+    int m_fd = -1;
+#endif
+
+    // (hash, slot) pairs of the stored blocks, most recently stored first
+    std::list<std::pair<size_t, size_t>> m_lru;
+    std::unordered_map<size_t, std::list<std::pair<size_t, size_t>>::iterator> m_index;
+    std::vector<size_t> m_free_slots;
+    mutable std::mutex m_mutex;
+
+    void _map_file();
+    void _unmap_file();
+
+public:
+    /**
+     * Creates the backing file and maps it into memory.
+     * @param dir The directory to create the backing file in, the system temporary directory is used if empty.
+     * @param num_slots The maximum number of blocks to be stored.
+     * @param slot_byte_size The size of a single block in bytes.
+     */
+    DiskBlockCache(const std::filesystem::path& dir, size_t num_slots, size_t slot_byte_size);
+    ~DiskBlockCache();
+
+    DiskBlockCache(const DiskBlockCache&) = delete;
+    DiskBlockCache& operator=(const DiskBlockCache&) = delete;
+
+    /**
+     * @param hash The hash of the block.
+     * @return Whether a block with the given hash is stored.
+     */
+    bool contains(size_t hash) const;
+
+    /**
+     * Reserves a slot for a block with the given hash, replacing the previously stored block with the same hash or
+     * the least recently stored block if there are no free slots. The slot contents are to be filled by the caller
+     * via get_slot_data() right away.
+     * @param hash The hash of the block.
+     * @return The slot index to write the block to, or std::nullopt if all slots are acquired.
+     */
+    std::optional<size_t> put(size_t hash);
+
+    /**
+     * Removes the block with the given hash from the index, keeping its slot reserved until release() is called,
+     * so that the block contents can be read while other blocks are being stored.
+     * @param hash The hash of the block.
+     * @return The slot index holding the block, or std::nullopt if the block is not stored.
+     */
+    std::optional<size_t> acquire(size_t hash);
+
+    /**
+     * Returns a slot acquired with acquire() to the pool of free slots.
+     * @param slot The slot index.
+     */
+    void release(size_t slot);
+
+    /**
+     * @param slot The slot index.
+     * @return Pointer to the slot_byte_size bytes of the mapped file holding the slot contents.
+     */
+    uint8_t* get_slot_data(size_t slot);
+
+    /**
+     * @return The number of blocks currently stored.
+     */
+    size_t num_blocks() const;
+
+    size_t get_num_slots() const {
+        return m_num_slots;
+    }
+
+    size_t get_slot_byte_size() const {
+        return m_slot_byte_size;
+    }
+
+    const std::filesystem::path& get_path() const {
+        return m_path;
+    }
+};
+
+}
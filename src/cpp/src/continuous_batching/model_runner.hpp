@@ -129,6 +129,8 @@ class ModelRunner {
     ov::Tensor m_cached_max_context_len;
     ov::Tensor m_cached_score_aggregation_window;
     ov::Tensor m_cached_token_type_ids;
+
+    ManualTimer m_infer_timer{"pure generate inference"};
 public:
     /**
      * Constructs the ModelRunner.
@@ -210,6 +212,22 @@ public:
         m_initial_hidden_states[request_id] = hidden_state;
     }
 
+    /**
+     * @return The vocabulary size of the logits produced by the model, or 0 if it is not statically known.
+     */
+    size_t get_vocab_size() {
+        for (const auto& output : m_request.get_compiled_model().outputs()) {
+            if (output.get_names().count("logits") == 0) {
+                continue;
+            }
+            const auto& pshape = output.get_partial_shape();
+            if (pshape.rank().is_static() && pshape.rank().get_length() > 0 && pshape[pshape.rank().get_length() - 1].is_static()) {
+                return pshape[pshape.rank().get_length() - 1].get_length();
+            }
+        }
+        return 0;
+    }
+
     /**
      * Runs the forward inference call on the underlying LLM's ov::InferRequest, scheduling for inferencing tokens for given sequences
      * taking into account the supplied scheduler output struct.
@@ -218,6 +236,18 @@ public:
      * @return An ov::Tensor with next-token logit scores for each sequence processed during this `forward` call.
      */
     ov::Tensor forward(const std::vector<SequenceGroup::Ptr> & sequence_groups, const Scheduler::Output& scheduler_output) {
+        forward_async(sequence_groups, scheduler_output);
+        return wait_forward(sequence_groups, scheduler_output);
+    }
+
+    /**
+     * Prepares the model inputs in the same manner as `forward` does, but only starts the inference asynchronously and returns
+     * immediately, so that the caller may perform host-side work which does not depend on the results of the current step.
+     * Must be followed by a `wait_forward` call with the same arguments before the next `forward_async` call.
+     * @param sequence_groups A vector of pointers to sequence groups to be processed during this `forward` call
+     * @param scheduler_output The scheduler output struct with information on the specifics of the token scheduling during this forward call
+     */
+    void forward_async(const std::vector<SequenceGroup::Ptr> & sequence_groups, const Scheduler::Output& scheduler_output) {
         m_sequence_hidden_state_mapping.clear();
         size_t num_sequence_groups = scheduler_output.m_scheduled_sequence_groups_ids.size();
 
@@ -543,12 +573,34 @@ public:
             m_request.set_tensor("score_aggregation_window", score_aggregation_window);
         }
 
-        {
-            static ManualTimer timer("pure generate inference");
-            timer.start();
-            m_request.infer();
-            timer.end();
+        m_infer_timer.start();
+        m_request.start_async();
+    }
+
+    /**
+     * Waits for the inference started by `forward_async` to complete without collecting its results, e.g. if the host-side
+     * work overlapped with the inference has failed. An error of the inference itself is ignored, as the caller reports its own.
+     */
+    void discard_forward() {
+        try {
+            m_request.wait();
+        } catch (...) {
         }
+        m_infer_timer.end();
+    }
+
+    /**
+     * Waits for the inference started by `forward_async` to complete and collects its results.
+     * @param sequence_groups A vector of pointers to sequence groups passed to `forward_async`. Sequence groups appended to the end of
+     * the vector after the `forward_async` call are allowed, since they are not referenced by the scheduler output.
+     * @param scheduler_output The scheduler output struct passed to `forward_async`.
+     * @return An ov::Tensor with next-token logit scores for each sequence processed during this `forward` call.
+     */
+    ov::Tensor wait_forward(const std::vector<SequenceGroup::Ptr> & sequence_groups, const Scheduler::Output& scheduler_output) {
+        m_request.wait();
+        m_infer_timer.end();
+
+        size_t num_sequence_groups = scheduler_output.m_scheduled_sequence_groups_ids.size();
 
         if (m_collect_attention_scores) {
             _collect_attention_scores(sequence_groups, scheduler_output);
@@ -767,7 +819,8 @@ private:
         return cached_tensor;
     }
 
-    // Fills indices for sequences in the order defined by scheduler_output
+    // Fills indices for sequences in the order defined by scheduler_output. Sequences present in the layer-specific map
+    // get only the selected logical blocks, the others get all of their logical blocks copied as a contiguous row.
     void _fill_indices_from_block_tables(
         const std::vector<std::string>& dst_tensor_names,
         const std::vector<SequenceGroup::Ptr>& sequence_groups,
@@ -794,33 +847,34 @@ private:
                     Sequence::CPtr sequence = running_sequences[i];
                     size_t seq_id = sequence->get_id();
 
-                    const auto& kv_blocks = scheduler_output.m_block_tables.at(seq_id);
+                    // In case no cache eviction is requested, all per-layer block tables are expected to be
+                    // identical at all times
+                    const auto& block_indices = scheduler_output.m_block_indices.at(seq_id)->at(layer_idx);
+                    size_t block_table_size = block_indices.size();
+
+                    const std::vector<size_t>* select_logical_idxs = nullptr;
+                    if (!is_fill_all) {
+                        const auto& seq_id_to_select_logical_idx_map = seq_id_to_select_logical_idx_maps[layer_idx];
+                        auto it = seq_id_to_select_logical_idx_map.find(seq_id);
+                        if (it != seq_id_to_select_logical_idx_map.end()) {
+                            select_logical_idxs = &it->second;
+                        }
+                    }
 
-                    if (is_fill_all) {
+                    if (select_logical_idxs == nullptr) {
                         size_t num_blocks = sequence_group->get_num_logical_blocks();
-                        for (size_t block_id = 0; block_id < num_blocks; ++block_id) {
-                            // In case no cache eviction is requested, all per-layer block tables are expected to be
-                            // identical at all times
-                            block_indices_data[block_id] = kv_blocks[layer_idx][block_id]->get_index();
-                        }
+                        OPENVINO_ASSERT(num_blocks <= block_table_size);
+                        std::copy_n(block_indices.data(), num_blocks, block_indices_data);
                         block_indices_data += num_blocks;
                         filled_blocks_per_layer[layer_idx] += num_blocks;
                     } else {
-                        auto seq_id_to_select_logical_idx_map = seq_id_to_select_logical_idx_maps[layer_idx];
-                        if (seq_id_to_select_logical_idx_map.find(seq_id) == seq_id_to_select_logical_idx_map.end()) {
-                            continue;  // sequence not being present in layer-specific map means it should be skipped entirely
-                        }
-
-                        const auto& select_logical_idxs = seq_id_to_select_logical_idx_maps[layer_idx].at(seq_id);
-                        const auto& block_table = kv_blocks[layer_idx];
-                        size_t block_table_size = block_table.size();
-                        for (size_t block_id = 0; block_id < select_logical_idxs.size(); ++block_id) {
-                            size_t logical_block_idx = select_logical_idxs[block_id];
+                        for (size_t block_id = 0; block_id < select_logical_idxs->size(); ++block_id) {
+                            size_t logical_block_idx = (*select_logical_idxs)[block_id];
                             OPENVINO_ASSERT(logical_block_idx < block_table_size);
-                            block_indices_data[block_id] = block_table[logical_block_idx]->get_index();
+                            block_indices_data[block_id] = block_indices[logical_block_idx];
                         }
-                        block_indices_data += select_logical_idxs.size();
-                        filled_blocks_per_layer[layer_idx] += select_logical_idxs.size();
+                        block_indices_data += select_logical_idxs->size();
+                        filled_blocks_per_layer[layer_idx] += select_logical_idxs->size();
                     }
                 }
             }
@@ -851,13 +905,12 @@ private:
                 size_t seq_id = kv.first;
                 const auto& select_logical_idxs = kv.second;
 
-                const auto& kv_blocks = scheduler_output.m_block_tables.at(seq_id);
-                const auto& block_table = kv_blocks[layer_idx];
-                size_t block_table_size = block_table.size();
+                const auto& block_indices = scheduler_output.m_block_indices.at(seq_id)->at(layer_idx);
+                size_t block_table_size = block_indices.size();
                 for (size_t block_id = 0; block_id < select_logical_idxs.size(); ++block_id) {
                     size_t logical_block_idx = select_logical_idxs[block_id];
                     OPENVINO_ASSERT(logical_block_idx < block_table_size);
-                    block_indices_data[block_id] = block_table[logical_block_idx]->get_index();
+                    block_indices_data[block_id] = block_indices[logical_block_idx];
                 }
                 block_indices_data += select_logical_idxs.size();
                 filled_blocks_per_layer[layer_idx] += select_logical_idxs.size();
@@ -889,6 +942,7 @@ private:
 
         std::vector<size_t> num_blocks_per_layer(num_layers);
 
+        // only the sequences with skipped blocks are listed, the others are filled with all of their logical blocks
         std::vector<std::map<size_t, std::vector<size_t>>> seq_id_to_select_logical_idx_map(m_num_decoder_layers);
         size_t num_sequence_groups = scheduler_output.m_scheduled_sequence_groups_ids.size();
         for (size_t layer_idx = 0; layer_idx < num_layers; layer_idx++) {
@@ -916,9 +970,6 @@ private:
                     }
                     else
                     {
-                        auto& vec = seq_id_to_select_logical_idx_map[layer_idx][seq_id];
-                        vec.resize(num_blocks);
-                        std::iota(vec.begin(), vec.end(), 0);
                         num_blocks_per_layer[layer_idx] += num_blocks;
                     }
                 }
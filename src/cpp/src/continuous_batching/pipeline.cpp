@@ -374,3 +374,15 @@ void ContinuousBatchingPipeline::start_chat(const std::string& system_message) {
 void ContinuousBatchingPipeline::finish_chat() {
     m_impl->finish_chat();
 }
+
+void ContinuousBatchingPipeline::save_prefix_cache(const std::filesystem::path& path) {
+    m_impl->save_prefix_cache(path);
+}
+
+void ContinuousBatchingPipeline::save_prefix_cache(const std::filesystem::path& path, const ov::Tensor& input_ids) {
+    m_impl->save_prefix_cache(path, input_ids);
+}
+
+size_t ContinuousBatchingPipeline::load_prefix_cache(const std::filesystem::path& path) {
+    return m_impl->load_prefix_cache(path);
+}
@@ -28,11 +28,13 @@ void ContinuousBatchingPipeline::IContinuousBatchingPipeline::start_chat(const s
     if (!system_message.empty()) {
         m_history.push_back({{"role", "system"}, {"content", system_message}});
     }
+    m_chat_tokenizer.emplace(m_tokenizer);
     m_is_chat_conversation = true;
 };
 
 void ContinuousBatchingPipeline::IContinuousBatchingPipeline::finish_chat() {
     m_is_chat_conversation = false;
+    m_chat_tokenizer.reset();
     m_history.clear();
     m_history_images.clear();
     m_history_videos.clear();
@@ -78,8 +80,8 @@ ContinuousBatchingPipeline::IContinuousBatchingPipeline::generate(
         std::string history = m_tokenizer.apply_chat_template(m_history, add_generation_prompt);
         timer.start();
         const auto encode_start = std::chrono::steady_clock::now();
-        // ov::genai::add_special_tokens(false) is aligned with stateful pipeline
-        input_ids.push_back(m_tokenizer.encode(history, ov::genai::add_special_tokens(false)).input_ids);
+        // ov::genai::add_special_tokens(false) is aligned with stateful pipeline, only the new turn is encoded
+        input_ids.push_back(m_chat_tokenizer->encode(history).input_ids);
         tokenization_durations.emplace_back(PerfMetrics::get_microsec(std::chrono::steady_clock::now() - encode_start));
         timer.end();
     } else {
@@ -151,6 +153,14 @@ ContinuousBatchingPipeline::IContinuousBatchingPipeline::generate(
     return decoded;
 }
 
+void ContinuousBatchingPipeline::IContinuousBatchingPipeline::save_prefix_cache(const std::filesystem::path& path, const ov::Tensor& input_ids) {
+    OPENVINO_THROW("Saving the prefix cache is not supported by this pipeline");
+}
+
+size_t ContinuousBatchingPipeline::IContinuousBatchingPipeline::load_prefix_cache(const std::filesystem::path& path) {
+    OPENVINO_THROW("Loading the prefix cache is not supported by this pipeline");
+}
+
 std::vector<GenerationResult>
 ContinuousBatchingPipeline::IContinuousBatchingPipeline::generate(
     const std::vector<ChatHistory>& histories,
@@ -11,6 +11,7 @@
 #include "continuous_batching/model_runner.hpp"
 #include "continuous_batching/scheduler.hpp"
 #include "continuous_batching/threaded_streamer.hpp"
+#include "tokenizer/incremental_chat_tokenizer.hpp"
 
 namespace ov::genai {
 
@@ -51,6 +52,8 @@ protected:
 
     bool m_is_chat_conversation = false;
     ChatHistory m_history;
+    // encodes only the new turns of the templated chat history, created by start_chat()
+    std::optional<IncrementalChatTokenizer> m_chat_tokenizer;
     std::vector<ov::genai::EncodedImage> m_history_images;
     std::vector<size_t> m_history_image_ids;
     std::vector<ov::genai::EncodedVideo> m_history_videos;
@@ -171,6 +174,16 @@ public:
      */
     void finish_chat();
 
+    /**
+     * Saves the contents of the prefix cache to a file, only the blocks of the prompt if input_ids are set
+     */
+    virtual void save_prefix_cache(const std::filesystem::path& path, const ov::Tensor& input_ids = ov::Tensor());
+
+    /**
+     * Loads the contents of a prefix cache file into the prefix cache
+     */
+    virtual size_t load_prefix_cache(const std::filesystem::path& path);
+
     ~IContinuousBatchingPipeline();
 };
 }
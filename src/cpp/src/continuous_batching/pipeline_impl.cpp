@@ -19,6 +19,7 @@
 #include "continuous_batching/paged_attention_transformations.hpp"
 #include "lora/helper.hpp"
 #include "continuous_batching/cache_state_dumper.hpp"
+#include "continuous_batching/prefix_cache_snapshot.hpp"
 
 namespace {
 
@@ -110,10 +111,29 @@ ContinuousBatchingPipeline::ContinuousBatchingImpl::~ContinuousBatchingImpl() {
     }
 }
 
-void ContinuousBatchingPipeline::ContinuousBatchingImpl::_pull_awaiting_requests() {
-    std::lock_guard<std::mutex> lock{m_awaiting_requests_mutex};
+void ContinuousBatchingPipeline::ContinuousBatchingImpl::_drain_awaiting_requests_queue() {
+    SequenceGroup::Ptr sequence_group;
+    while (m_awaiting_requests_queue.try_pop(sequence_group)) {
+        m_awaiting_requests.push_back(std::move(sequence_group));
+    }
+}
+
+void ContinuousBatchingPipeline::ContinuousBatchingImpl::_move_awaiting_requests() {
+    // the cached blocks are restored on the step thread, since loading them from the prefix cache disk tier
+    // allocates blocks, which must not interleave with the allocations and the cache resizing of the scheduler
+    if (m_scheduler->get_config().enable_prefix_caching) {
+        for (const auto& sequence_group : m_awaiting_requests) {
+            m_scheduler->restore_cached_blocks(sequence_group);
+        }
+    }
     m_requests.insert(m_requests.end(), m_awaiting_requests.begin(), m_awaiting_requests.end());
+    m_num_awaiting_requests.fetch_sub(m_awaiting_requests.size());
     m_awaiting_requests.clear();
+}
+
+void ContinuousBatchingPipeline::ContinuousBatchingImpl::_pull_awaiting_requests() {
+    _drain_awaiting_requests_queue();
+    _move_awaiting_requests();
     m_pipeline_metrics.requests = m_requests.size();
 }
 
@@ -137,6 +157,10 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::initialize_pipeline(
         filtered_properties.fork().erase("sampler_num_threads");   // do not use iterator sampler_num_threads_it because a forked container may not be the same container
     }
 
+    if (scheduler_config.enable_prefix_caching) {
+        m_model_fingerprint = PrefixCacheSnapshot::compute_model_fingerprint(model);
+    }
+
     ov::CompiledModel compiled_model = utils::singleton_core().compile_model(model, device, *filtered_properties);
     std::vector<std::string> execution_devices = compiled_model.get_property(ov::execution_devices);
     const bool all_gpu_device =
@@ -211,6 +235,11 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::initialize_pipeline(
                                                        is_use_xattention);
     }
 
+    if (normalized_config.enable_prefix_caching && !normalized_config.prefix_cache_snapshot_path.empty()) {
+        PrefixCacheSnapshot::load(normalized_config.prefix_cache_snapshot_path, *m_scheduler, m_model_fingerprint);
+    }
+
+    m_vocab_size = m_model_runner->get_vocab_size();
     m_sampler = std::make_shared<Sampler>(m_tokenizer, sampler_num_threads);
     m_sampler->set_seed(m_generation_config.rng_seed);
 
@@ -289,14 +318,9 @@ ContinuousBatchingPipeline::ContinuousBatchingImpl::add_request(
         sequence_group = std::make_shared<SequenceGroup>(request_id, input_ids, sampling_params_copy, m_block_size, token_type_ids);
     }
 
-    if (m_scheduler->get_config().enable_prefix_caching) {
-        m_scheduler->restore_cached_blocks(sequence_group);
-    }
-
-    {
-        std::lock_guard<std::mutex> lock{m_awaiting_requests_mutex};
-        m_awaiting_requests.push_back(sequence_group);
-    }
+    // counted before being pushed, so that the request is never missed by has_non_finished_requests
+    m_num_awaiting_requests.fetch_add(1);
+    m_awaiting_requests_queue.push(sequence_group);
 
     return std::make_shared<GenerationHandleImpl>(sequence_group->get_generation_stream(), sampling_params_copy);
 }
@@ -308,7 +332,7 @@ ContinuousBatchingPipeline::ContinuousBatchingImpl::add_request(uint64_t request
     ov::Tensor inputs;
     ov::genai::VLMPerfMetrics metrics;
     if (m_model_input_type == ModelInputType::TOKENS) {
-        static ManualTimer timer("tokenize");
+        static thread_local ManualTimer timer("tokenize");
         timer.start();
         inputs = m_tokenizer.encode(prompt).input_ids;
         timer.end();
@@ -323,12 +347,11 @@ ContinuousBatchingPipeline::ContinuousBatchingImpl::add_request(uint64_t request
 }
 
 bool ContinuousBatchingPipeline::ContinuousBatchingImpl::has_non_finished_requests() {
-    std::lock_guard<std::mutex> lock{m_awaiting_requests_mutex};
-    return !m_awaiting_requests.empty() || !m_requests.empty();
+    return m_num_awaiting_requests.load() > 0 || !m_requests.empty();
 }
 
 void ContinuousBatchingPipeline::ContinuousBatchingImpl::step() {
-    static ManualTimer step_timer("step()");
+    static thread_local ManualTimer step_timer("step()");
     step_timer.start();
 
     _pull_awaiting_requests();
@@ -336,7 +359,7 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::step() {
     Scheduler::Output scheduler_output;
 
     {
-        static ManualTimer scheduling_timer("scheduling");
+        static thread_local ManualTimer scheduling_timer("scheduling");
         scheduling_timer.start();
         scheduler_output = m_scheduler->schedule(m_requests);
         scheduling_timer.end();
@@ -371,12 +394,25 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::step() {
     ov::Tensor logits;
 
     {
-        static ManualTimer timer("forward");
+        static thread_local ManualTimer timer("forward");
         const auto infer_start = std::chrono::steady_clock::now();
         timer.start();
-        logits = m_model_runner->forward(m_requests, scheduler_output);
+        m_model_runner->forward_async(m_requests, scheduler_output);
+        // while the device is busy with the current step, do the host-side work which does not depend on its logits:
+        // requests added since the beginning of the step are pulled and the sampler is prepared for them
+        try {
+            _overlap_with_forward();
+        } catch (...) {
+            // the inference still uses the tensors of the infer request and the KV cache
+            m_model_runner->discard_forward();
+            timer.end();
+            throw;
+        }
+        logits = m_model_runner->wait_forward(m_requests, scheduler_output);
         const auto infer_end = std::chrono::steady_clock::now();
+        // the host-side work runs concurrently with the inference, so it is not subtracted from the wall time
         m_pipeline_metrics.inference_duration = PerfMetrics::get_microsec(infer_end - infer_start);
+        m_scheduler->register_step_duration(scheduler_output, m_pipeline_metrics.inference_duration / 1000.0f);
         timer.end();
     }
 
@@ -402,7 +438,7 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::step() {
 
     SamplerOutput sampler_output;
     {
-        static ManualTimer timer("sample");
+        static thread_local ManualTimer timer("sample");
         timer.start();
         sampler_output = m_sampler->sample(m_requests, logits, m_is_validation_mode_enabled);
         m_batch_size = sampler_output.num_generated_tokens;
@@ -411,7 +447,7 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::step() {
 
     // process sampler_output (e.g. fork or drop sequences from BlockScheduler)
     {
-        static ManualTimer free_fork_timer("fork / free sequence");
+        static thread_local ManualTimer free_fork_timer("fork / free sequence");
         free_fork_timer.start();
 
         for (const auto& pair : sampler_output.m_forked_sequences) {
@@ -433,7 +469,7 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::step() {
 
     // notify requests dropped by handle
     {
-        static ManualTimer report_tokens_timer("notify requests dropped by handle");
+        static thread_local ManualTimer report_tokens_timer("notify requests dropped by handle");
         report_tokens_timer.start();
         _notify_requests_dropped_by_handle();
         report_tokens_timer.end();
@@ -442,7 +478,7 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::step() {
     // free non running requests for current step
 
     {
-        static ManualTimer clean_up_requests_timer("free non running requests");
+        static thread_local ManualTimer clean_up_requests_timer("free non running requests");
         clean_up_requests_timer.start();
         _free_non_running_requests();
         clean_up_requests_timer.end();
@@ -451,6 +487,15 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::step() {
     step_timer.end();
 }
 
+void ContinuousBatchingPipeline::ContinuousBatchingImpl::_overlap_with_forward() {
+    static thread_local ManualTimer overlap_timer("overlapped with forward");
+    overlap_timer.start();
+    // newly pulled requests are appended to the end of m_requests, so indices in the current scheduler output stay valid
+    _pull_awaiting_requests();
+    m_sampler->prepare(m_requests, m_vocab_size);
+    overlap_timer.end();
+}
+
 void ContinuousBatchingPipeline::ContinuousBatchingImpl::set_adapters(const std::optional<AdapterConfig>& adapters) {
     if (m_adapter_controller) {
         m_adapter_controller->apply(m_model_runner->get_infer_request(), adapters);
@@ -513,7 +558,6 @@ ContinuousBatchingPipeline::ContinuousBatchingImpl::generate(const std::vector<o
 
     GenerationHandle& generation = generations.at(0);
 
-    streamer_ptr->start();
     m_sampler->clear_structured_output_compile_times();
     while (has_non_finished_requests()) {
         try {
@@ -859,7 +903,17 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::_fill_prompt_log_probs(
 }
 
 std::vector<SequenceGroup::Ptr> ContinuousBatchingPipeline::ContinuousBatchingImpl::get_awaiting_requests() {
-    std::lock_guard<std::mutex> lock{m_awaiting_requests_mutex};
+    _drain_awaiting_requests_queue();
     return m_awaiting_requests;
 }
+
+void ContinuousBatchingPipeline::ContinuousBatchingImpl::save_prefix_cache(const std::filesystem::path& path, const ov::Tensor& input_ids) {
+    OPENVINO_ASSERT(m_scheduler->get_config().enable_prefix_caching, "Saving the prefix cache requires enable_prefix_caching in SchedulerConfig");
+    PrefixCacheSnapshot::save(path, *m_scheduler, m_model_fingerprint, input_ids);
+}
+
+size_t ContinuousBatchingPipeline::ContinuousBatchingImpl::load_prefix_cache(const std::filesystem::path& path) {
+    OPENVINO_ASSERT(m_scheduler->get_config().enable_prefix_caching, "Loading the prefix cache requires enable_prefix_caching in SchedulerConfig");
+    return PrefixCacheSnapshot::load(path, *m_scheduler, m_model_fingerprint);
+}
 } // namespace ov::genai
@@ -8,6 +8,7 @@
 #include "openvino/genai/lora_adapter.hpp"
 #include "continuous_batching/cache_eviction.hpp"
 #include "visual_language/inputs_embedder.hpp"
+#include "lock_free_queue.hpp"
 
 namespace ov::genai {
 
@@ -20,10 +21,13 @@ protected:
 
     // current requests to process
     std::vector<SequenceGroup::Ptr> m_requests;
-    // requests added to the pipeline that will be added to m_requests in the next iteration
+    // requests added to the pipeline that will be added to m_requests in the next iteration,
+    // add_request may be called from any number of threads concurrently with step
+    MPSCQueue<SequenceGroup::Ptr> m_awaiting_requests_queue;
+    // requests taken from m_awaiting_requests_queue by the thread calling step, but not yet moved to m_requests
     std::vector<SequenceGroup::Ptr> m_awaiting_requests;
-    // Mutex protecting access to m_awaiting_requests, so add_request and step methods can be called from different threads
-    std::mutex m_awaiting_requests_mutex;
+    // the number of added requests which are not moved to m_requests yet, it may be read from any thread
+    std::atomic<size_t> m_num_awaiting_requests{0};
 
     std::map<size_t, CacheEvictionAlgorithm> m_seq_group_id_to_cache_eviction_algo_map;
 
@@ -39,6 +43,10 @@ protected:
 
     size_t m_num_decoder_layers = 0;
     size_t m_block_size = 0;
+    // vocabulary size of the model logits, 0 if not statically known
+    size_t m_vocab_size = 0;
+    // identifies the model in prefix cache snapshots, computed only if prefix caching is enabled
+    uint64_t m_model_fingerprint = 0;
 
     // Pre-allocated per-layer storages for the per-token cache re-rotation deltas used in cache eviction case
     std::vector<ov::Tensor> m_rotation_deltas_stores;
@@ -70,6 +78,24 @@ protected:
      */
     virtual void _pull_awaiting_requests();
 
+    /**
+     * Moves requests added since the previous call from m_awaiting_requests_queue to m_awaiting_requests.
+     * Must be called from the thread calling step()
+     */
+    void _drain_awaiting_requests_queue();
+
+    /**
+     * Moves the drained requests from m_awaiting_requests to m_requests.
+     * Must be called from the thread calling step()
+     */
+    void _move_awaiting_requests();
+
+    /**
+     * Performs host-side work which does not depend on the logits of the current step,
+     * while the model inference for this step is running asynchronously
+     */
+    void _overlap_with_forward();
+
     /**
      * Releases non-running (finished, dropped or OOM) requests from running queue
      */
@@ -143,6 +169,13 @@ public:
      */
     void set_adapters(const std::optional<AdapterConfig>& adapters);
 
+    /**
+     * Returns the requests which are not yet moved to the running queue. Must be called from the thread calling step()
+     */
     std::vector<SequenceGroup::Ptr> get_awaiting_requests();
+
+    void save_prefix_cache(const std::filesystem::path& path, const ov::Tensor& input_ids = ov::Tensor()) override;
+
+    size_t load_prefix_cache(const std::filesystem::path& path) override;
 };
 } // namespace ov::genai
@@ -0,0 +1,57 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+
+#include "continuous_batching/prefill_token_budget.hpp"
+
+namespace ov::genai {
+
+namespace {
+
+// weight of a new measurement in the smoothed estimates
+constexpr float SMOOTHING_FACTOR = 0.25f;
+
+float smooth(float estimate, float measurement) {
+    return estimate < 0.0f ? measurement : estimate + SMOOTHING_FACTOR * (measurement - estimate);
+}
+
+}  // namespace
+
+PrefillTokenBudget::PrefillTokenBudget(float latency_target_ms, size_t min_budget, size_t max_budget)
+    : m_latency_target_ms(latency_target_ms),
+      m_min_budget(std::min(min_budget, max_budget)),
+      m_max_budget(max_budget),
+      m_budget(max_budget) {}
+
+void PrefillTokenBudget::register_step(size_t num_generated_tokens, size_t num_prompt_tokens, float duration_ms) {
+    if (num_prompt_tokens == 0) {
+        if (num_generated_tokens == 0) {
+            return;
+        }
+        m_base_duration_ms = smooth(m_base_duration_ms, duration_ms);
+    } else if (num_generated_tokens > 0 && m_base_duration_ms >= 0.0f) {
+        float prompt_duration_ms = std::max(duration_ms - m_base_duration_ms, 0.0f);
+        m_prompt_token_duration_ms = smooth(m_prompt_token_duration_ms, prompt_duration_ms / num_prompt_tokens);
+    } else if (m_prompt_token_duration_ms < 0.0f) {
+        // until the base duration is known the whole step is attributed to the prompt tokens, which underestimates the budget
+        m_prompt_token_duration_ms = duration_ms / num_prompt_tokens;
+    }
+    _update_budget();
+}
+
+void PrefillTokenBudget::_update_budget() {
+    if (m_prompt_token_duration_ms <= 0.0f) {
+        m_budget = m_max_budget;
+        return;
+    }
+    float available_ms = m_latency_target_ms - std::max(m_base_duration_ms, 0.0f);
+    if (available_ms <= 0.0f) {
+        m_budget = m_min_budget;
+        return;
+    }
+    float budget = available_ms / m_prompt_token_duration_ms;
+    m_budget = budget >= static_cast<float>(m_max_budget) ? m_max_budget : std::max(static_cast<size_t>(budget), m_min_budget);
+}
+
+}  // namespace ov::genai
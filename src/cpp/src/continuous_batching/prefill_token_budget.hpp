@@ -0,0 +1,55 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+
+namespace ov::genai {
+
+/**
+ * @brief Adapts the number of prompt tokens scheduled together with generated tokens to keep the duration of the steps
+ * running generation within SchedulerConfig::inter_token_latency_target_ms.
+ * The step duration is modelled as a base duration of the generated tokens plus a cost per prompt token, both are estimated
+ * from the measured step durations with exponential smoothing: the base duration from the steps without prompt tokens and
+ * the cost per prompt token from the steps with them.
+ */
+class PrefillTokenBudget {
+public:
+    /**
+     * @param latency_target_ms The target duration of a step running generation.
+     * @param min_budget The minimum number of prompt tokens scheduled with generated tokens, so that prompts keep progressing
+     * even when the generated tokens alone exceed the target.
+     * @param max_budget The maximum number of prompt tokens scheduled at a step.
+     */
+    PrefillTokenBudget(float latency_target_ms, size_t min_budget, size_t max_budget);
+
+    /**
+     * Updates the step duration model with a measured step.
+     * @param num_generated_tokens The number of scheduled generated tokens.
+     * @param num_prompt_tokens The number of scheduled prompt tokens.
+     * @param duration_ms The duration of the step.
+     */
+    void register_step(size_t num_generated_tokens, size_t num_prompt_tokens, float duration_ms);
+
+    /**
+     * @return The number of prompt tokens which can be scheduled together with generated tokens.
+     */
+    size_t get_budget() const {
+        return m_budget;
+    }
+
+private:
+    float m_latency_target_ms;
+    size_t m_min_budget;
+    size_t m_max_budget;
+    size_t m_budget;
+
+    // step duration model, negative until estimated
+    float m_base_duration_ms = -1.0f;
+    float m_prompt_token_duration_ms = -1.0f;
+
+    void _update_budget();
+};
+
+}  // namespace ov::genai
@@ -0,0 +1,331 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <fstream>
+#include <string_view>
+#include <unordered_set>
+
+#include "openvino/op/constant.hpp"
+#include "continuous_batching/prefix_cache_snapshot.hpp"
+#include "logger.hpp"
+
+namespace {
+
+constexpr char SNAPSHOT_MAGIC[8] = {'O', 'V', 'G', 'P', 'C', 'S', 'N', 'P'};
+constexpr uint32_t SNAPSHOT_VERSION = 2;
+// magic, version, model fingerprint, cache layout hash and number of blocks
+constexpr size_t SNAPSHOT_HEADER_SIZE = sizeof(SNAPSHOT_MAGIC) + sizeof(uint32_t) + 3 * sizeof(uint64_t);
+// hash, prefix hash flag, prefix hash and number of tokens preceding the contents of each block
+constexpr size_t BLOCK_HEADER_SIZE = 3 * sizeof(uint64_t) + sizeof(uint8_t);
+// number of leading bytes of each weight taken into account by the model fingerprint
+constexpr size_t WEIGHT_SAMPLE_SIZE = 64;
+
+void hash_combine(uint64_t& seed, uint64_t value) {
+    seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+uint64_t hash_string(std::string_view str) {
+    return std::hash<std::string_view>{}(str);
+}
+
+template <typename T>
+void write_value(std::ostream& stream, const T& value) {
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool read_value(std::istream& stream, T& value) {
+    stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return static_cast<bool>(stream);
+}
+
+uint64_t compute_cache_layout_hash(const ov::genai::CacheManager& cache_manager) {
+    uint64_t layout_hash = 0;
+    hash_combine(layout_hash, cache_manager.get_num_decoder_layers());
+    hash_combine(layout_hash, cache_manager.get_block_size());
+    hash_combine(layout_hash, cache_manager.get_block_size_in_bytes());
+    for (size_t decoder_layer_id = 0; decoder_layer_id < cache_manager.get_num_decoder_layers(); ++decoder_layer_id) {
+        hash_combine(layout_hash, hash_string(cache_manager.get_key_cache_precision(decoder_layer_id).get_type_name()));
+        hash_combine(layout_hash, hash_string(cache_manager.get_value_cache_precision(decoder_layer_id).get_type_name()));
+        for (const ov::Shape& shape : {cache_manager.get_key_block_shape(decoder_layer_id), cache_manager.get_value_block_shape(decoder_layer_id)}) {
+            hash_combine(layout_hash, shape.size());
+            for (size_t dim : shape) {
+                hash_combine(layout_hash, dim);
+            }
+        }
+    }
+    return layout_hash;
+}
+
+// the number of blocks a dynamically allocated KV cache of num_kv_blocks blocks can grow by on its device
+size_t get_max_num_new_kv_blocks(const ov::genai::CacheManager& cache_manager, size_t num_kv_blocks) {
+    const size_t block_size_in_bytes = cache_manager.get_block_size_in_bytes();
+    if (cache_manager.get_device().find("GPU") != std::string::npos) {
+        return ov::genai::utils::get_available_gpu_memory(cache_manager.get_device(), cache_manager.get_num_decoder_layers()) / block_size_in_bytes;
+    }
+    const size_t max_num_kv_blocks = ov::genai::ReservedMemory::get_physical_memory_size() / block_size_in_bytes;
+    return max_num_kv_blocks > num_kv_blocks ? max_num_kv_blocks - num_kv_blocks : 0;
+}
+
+// checks the block headers of a snapshot without reading the block contents, then returns the stream to the first block
+bool are_block_headers_valid(std::istream& in, uint64_t num_blocks, size_t block_size_in_bytes, size_t block_size) {
+    const auto contents_begin = in.tellg();
+    for (uint64_t block_idx = 0; block_idx < num_blocks; ++block_idx) {
+        uint64_t hash = 0, prefix_hash = 0, num_tokens = 0;
+        uint8_t has_prefix_hash = 0;
+        in.seekg(contents_begin + static_cast<std::streamoff>(block_idx * (BLOCK_HEADER_SIZE + block_size_in_bytes)));
+        if (!read_value(in, hash) || !read_value(in, has_prefix_hash) || !read_value(in, prefix_hash) || !read_value(in, num_tokens) ||
+            has_prefix_hash > 1 || num_tokens == 0 || num_tokens > block_size) {
+            return false;
+        }
+    }
+    in.seekg(contents_begin);
+    return static_cast<bool>(in);
+}
+
+// hashes of the cached blocks holding a prefix of the prompt, found the same way as BlockManager::restore_cached_blocks() does
+std::unordered_set<size_t> get_prompt_block_hashes(const ov::Tensor& input_ids, const ov::genai::BlockPrefixTree& prefix_tree, size_t block_size) {
+    auto sequence_group = std::make_shared<ov::genai::SequenceGroup>(0, input_ids, ov::genai::GenerationConfig(), block_size);
+    ov::genai::Sequence::Ptr sequence = (*sequence_group)[0];
+    size_t prompt_len = sequence_group->get_prompt_len();
+
+    std::unordered_set<size_t> hashes;
+    std::optional<size_t> prefix_hash;
+    size_t content_len = 0;
+    for (; content_len + block_size <= prompt_len; content_len += block_size) {
+        size_t hash = sequence->get_hash(content_len + block_size);
+        if (!prefix_tree.has_child(prefix_hash, hash)) {
+            return hashes;
+        }
+        hashes.insert(hash);
+        prefix_hash = hash;
+    }
+    // partially filled blocks continuing the prompt
+    for (size_t num_tokens : prefix_tree.get_children_num_tokens(prefix_hash)) {
+        if (num_tokens >= block_size || content_len + num_tokens > prompt_len) {
+            continue;
+        }
+        size_t hash = sequence->get_hash(content_len + num_tokens);
+        if (prefix_tree.has_child(prefix_hash, hash)) {
+            hashes.insert(hash);
+        }
+    }
+    return hashes;
+}
+
+std::vector<size_t> get_block_indices(const ov::genai::BlocksPerLayer& blocks) {
+    std::vector<size_t> block_indices;
+    block_indices.reserve(blocks.size());
+    for (const auto& block : blocks) {
+        block_indices.push_back(block->get_index());
+    }
+    return block_indices;
+}
+
+} // namespace
+
+namespace ov::genai {
+
+uint64_t PrefixCacheSnapshot::compute_model_fingerprint(const std::shared_ptr<const ov::Model>& model) {
+    uint64_t fingerprint = 0;
+    for (const auto& op : model->get_ordered_ops()) {
+        hash_combine(fingerprint, hash_string(op->get_type_info().name));
+        for (const auto& output : op->outputs()) {
+            hash_combine(fingerprint, hash_string(output.get_element_type().get_type_name()));
+            hash_combine(fingerprint, hash_string(output.get_partial_shape().to_string()));
+        }
+        if (auto constant = ov::as_type_ptr<ov::op::v0::Constant>(op)) {
+            // a sample is enough to tell different checkpoints of the same architecture apart without reading all weights
+            const char* data = static_cast<const char*>(constant->get_data_ptr());
+            hash_combine(fingerprint, hash_string(std::string_view(data, std::min(constant->get_byte_size(), WEIGHT_SAMPLE_SIZE))));
+        }
+    }
+    return fingerprint;
+}
+
+size_t PrefixCacheSnapshot::save(const std::filesystem::path& path, Scheduler& scheduler, uint64_t model_fingerprint,
+                                 const ov::Tensor& input_ids) {
+    BlockManager& block_manager = *scheduler.m_block_manager;
+    CacheManager& cache_manager = *scheduler.m_cache_manager;
+    OPENVINO_ASSERT(block_manager.m_enable_prefix_caching, "Prefix cache snapshot requires prefix caching to be enabled");
+
+    // blocks restored from the disk tier must be in place before their contents are read
+    scheduler._apply_pending_disk_transfers();
+
+    std::lock_guard<std::mutex> lock(block_manager.m_cached_blocks_map_mutex);
+    const BlockPrefixTree& prefix_tree = block_manager.m_allocator.get_prefix_tree();
+    std::optional<std::unordered_set<size_t>> prompt_block_hashes;
+    if (input_ids) {
+        prompt_block_hashes = get_prompt_block_hashes(input_ids, prefix_tree, block_manager.get_block_size());
+    }
+
+    struct CachedBlock {
+        size_t hash;
+        std::optional<size_t> prefix_hash;
+        size_t num_tokens;
+        size_t depth;
+        const BlocksPerLayer* blocks;
+    };
+    std::vector<CachedBlock> cached_blocks;
+    std::unordered_map<size_t, size_t> depths;
+    auto get_depth = [&](size_t hash) {
+        if (auto it = depths.find(hash); it != depths.end()) {
+            return it->second;
+        }
+        // walk up to the first block with a known depth, then assign the depths on the way back
+        std::vector<size_t> chain;
+        size_t depth = 0;
+        for (std::optional<size_t> current = hash; current.has_value() && prefix_tree.contains(*current);
+             current = prefix_tree.get_prefix_hash(*current)) {
+            auto it = depths.find(*current);
+            if (it != depths.end()) {
+                depth = it->second + 1;
+                break;
+            }
+            chain.push_back(*current);
+        }
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+            depths[*it] = depth++;
+        }
+        return depths.at(hash);
+    };
+
+    // the map holds the blocks for every hash in the prefix tree, both occupied by sequences and stored for reuse
+    for (const auto& [hash, blocks] : block_manager.m_prefix_hash_to_occupied_block_map) {
+        size_t num_tokens = prefix_tree.get_num_tokens(hash);
+        if (num_tokens == 0 || blocks.empty() || blocks[0]->get_hash() != hash ||
+            (prompt_block_hashes.has_value() && prompt_block_hashes->count(hash) == 0)) {
+            continue;
+        }
+        cached_blocks.push_back({hash, prefix_tree.get_prefix_hash(hash), num_tokens, get_depth(hash), &blocks});
+    }
+    // parents go first, so that a partially loaded snapshot still consists of complete prefixes
+    std::stable_sort(cached_blocks.begin(), cached_blocks.end(), [](const CachedBlock& lhs, const CachedBlock& rhs) {
+        return lhs.depth < rhs.depth;
+    });
+
+    // write to a temporary file first, so that an interrupted save does not damage an existing snapshot
+    std::filesystem::path tmp_path = path;
+    tmp_path += ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        OPENVINO_ASSERT(out.is_open(), "Failed to create prefix cache snapshot ", tmp_path.string());
+
+        out.write(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+        write_value(out, SNAPSHOT_VERSION);
+        write_value(out, model_fingerprint);
+        write_value(out, compute_cache_layout_hash(cache_manager));
+        write_value(out, static_cast<uint64_t>(cached_blocks.size()));
+
+        std::vector<uint8_t> block_data(cache_manager.get_block_size_in_bytes());
+        for (const auto& cached_block : cached_blocks) {
+            write_value(out, static_cast<uint64_t>(cached_block.hash));
+            write_value(out, static_cast<uint8_t>(cached_block.prefix_hash.has_value()));
+            write_value(out, static_cast<uint64_t>(cached_block.prefix_hash.value_or(0)));
+            write_value(out, static_cast<uint64_t>(cached_block.num_tokens));
+            cache_manager.store_block(get_block_indices(*cached_block.blocks), block_data.data());
+            out.write(reinterpret_cast<const char*>(block_data.data()), block_data.size());
+        }
+        OPENVINO_ASSERT(out.good(), "Failed to write prefix cache snapshot ", tmp_path.string());
+    }
+    std::filesystem::rename(tmp_path, path);
+    return cached_blocks.size();
+}
+
+size_t PrefixCacheSnapshot::load(const std::filesystem::path& path, Scheduler& scheduler, uint64_t model_fingerprint) {
+    BlockManager& block_manager = *scheduler.m_block_manager;
+    CacheManager& cache_manager = *scheduler.m_cache_manager;
+    OPENVINO_ASSERT(block_manager.m_enable_prefix_caching, "Prefix cache snapshot requires prefix caching to be enabled");
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        GENAI_WARN("Prefix cache snapshot %s cannot be opened, starting with an empty prefix cache", path.string().c_str());
+        return 0;
+    }
+
+    char magic[sizeof(SNAPSHOT_MAGIC)];
+    uint32_t version = 0;
+    uint64_t snapshot_model_fingerprint = 0, snapshot_layout_hash = 0, num_blocks = 0;
+    in.read(magic, sizeof(magic));
+    if (!in || !std::equal(std::begin(magic), std::end(magic), std::begin(SNAPSHOT_MAGIC)) ||
+        !read_value(in, version) || version != SNAPSHOT_VERSION) {
+        GENAI_WARN("%s is not a supported prefix cache snapshot, starting with an empty prefix cache", path.string().c_str());
+        return 0;
+    }
+    if (!read_value(in, snapshot_model_fingerprint) || snapshot_model_fingerprint != model_fingerprint) {
+        GENAI_WARN("Prefix cache snapshot %s was created for a different model, starting with an empty prefix cache", path.string().c_str());
+        return 0;
+    }
+    if (!read_value(in, snapshot_layout_hash) || snapshot_layout_hash != compute_cache_layout_hash(cache_manager)) {
+        GENAI_WARN("Prefix cache snapshot %s was created with a different KV cache precision or layout, starting with an empty prefix cache",
+                   path.string().c_str());
+        return 0;
+    }
+    if (!read_value(in, num_blocks) || num_blocks == 0) {
+        return 0;
+    }
+    // the number of blocks and the block headers are checked before anything is allocated for them
+    const size_t block_record_size = BLOCK_HEADER_SIZE + cache_manager.get_block_size_in_bytes();
+    std::error_code ec;
+    const uintmax_t file_size = std::filesystem::file_size(path, ec);
+    if (ec || num_blocks > (file_size - SNAPSHOT_HEADER_SIZE) / block_record_size ||
+        !are_block_headers_valid(in, num_blocks, cache_manager.get_block_size_in_bytes(), block_manager.get_block_size())) {
+        GENAI_WARN("Prefix cache snapshot %s is corrupted, starting with an empty prefix cache", path.string().c_str());
+        return 0;
+    }
+    const bool is_dynamic_cache = block_manager.get_total_number_of_kv_blocks() == 0 || scheduler.m_dynamic_memory_allocation;
+    if (is_dynamic_cache && num_blocks > get_max_num_new_kv_blocks(cache_manager, block_manager.get_total_number_of_kv_blocks())) {
+        GENAI_WARN("Prefix cache snapshot %s of %llu blocks does not fit into the memory of %s, starting with an empty prefix cache",
+                   path.string().c_str(), static_cast<unsigned long long>(num_blocks), cache_manager.get_device().c_str());
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(block_manager.m_cached_blocks_map_mutex);
+    BlockAllocator& allocator = block_manager.m_allocator;
+    if (block_manager.get_total_number_of_kv_blocks() == 0) {
+        // dynamically allocated cache starts with the size of the snapshot and grows on demand afterwards
+        block_manager.increase_kv_blocks_number(num_blocks);
+        scheduler.m_dynamic_memory_allocation = true;
+    } else if (scheduler.m_dynamic_memory_allocation && allocator.num_free_blocks(0) < num_blocks) {
+        block_manager.increase_kv_blocks_number(block_manager.get_total_number_of_kv_blocks() + num_blocks - allocator.num_free_blocks(0));
+    }
+    cache_manager.allocate_cache_if_needed(block_manager.get_total_number_of_kv_blocks());
+
+    const BlockPrefixTree& prefix_tree = allocator.get_prefix_tree();
+    std::vector<uint8_t> block_data(cache_manager.get_block_size_in_bytes());
+    // the loaded blocks are held until the end, so that loading does not overwrite the blocks it has just loaded
+    std::vector<BlocksPerLayer> loaded_blocks;
+    size_t num_loaded_blocks = 0;
+    for (uint64_t block_idx = 0; block_idx < num_blocks; ++block_idx) {
+        uint64_t hash = 0, prefix_hash = 0, num_tokens = 0;
+        uint8_t has_prefix_hash = 0;
+        if (!read_value(in, hash) || !read_value(in, has_prefix_hash) || !read_value(in, prefix_hash) || !read_value(in, num_tokens) ||
+            !in.read(reinterpret_cast<char*>(block_data.data()), block_data.size())) {
+            GENAI_WARN("Prefix cache snapshot %s is truncated, %zu blocks loaded", path.string().c_str(), num_loaded_blocks);
+            break;
+        }
+        if (allocator.num_free_blocks(0) == 0) {
+            break;
+        }
+        std::optional<size_t> block_prefix_hash = has_prefix_hash ? std::optional<size_t>(prefix_hash) : std::nullopt;
+        if (prefix_tree.contains(hash) || (block_prefix_hash.has_value() && !prefix_tree.contains(*block_prefix_hash))) {
+            continue;
+        }
+        BlocksPerLayer blocks = allocator.allocate_block(hash, block_manager.m_prefix_hash_to_occupied_block_map, block_prefix_hash, num_tokens);
+        cache_manager.load_block(block_data.data(), get_block_indices(blocks));
+        loaded_blocks.push_back(std::move(blocks));
+        ++num_loaded_blocks;
+    }
+    // no sequence holds the blocks, so they go to the store of blocks available for reuse
+    auto timestamp = std::chrono::steady_clock::now();
+    for (auto& blocks : loaded_blocks) {
+        for (auto& block : blocks) {
+            block->set_timestamp(timestamp);
+        }
+        allocator.free(blocks);
+    }
+    return num_loaded_blocks;
+}
+
+}
@@ -0,0 +1,60 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+#include "openvino/core/model.hpp"
+#include "continuous_batching/scheduler.hpp"
+
+namespace ov::genai {
+
+/**
+ * @brief Saves the contents of the prefix cache to a file and loads them into a newly created pipeline, so that a restarted
+ * pipeline does not have to prefill the commonly used prompt prefixes again.
+ * For each cached block the snapshot keeps its hash, the hash of the preceding block and the number of tokens (i.e. its
+ * place in the prefix tree), followed by the key and value cache contents of all decoder layers. A snapshot is only loaded
+ * into a pipeline with the same model and the same KV cache layout (number of layers, precisions, block size and shapes).
+ * A snapshot limited to the blocks of a single prompt hands the prompt over from a pipeline which has processed it to
+ * another one, which then only has to compute the tokens of the last prompt block (prefill / decode disaggregation).
+ */
+class PrefixCacheSnapshot {
+public:
+    /**
+     * Computes an identifier of the model for snapshot validation from the model topology and a sample of each weight.
+     * @param model The model to be used in the pipeline.
+     * @return The model fingerprint.
+     */
+    static uint64_t compute_model_fingerprint(const std::shared_ptr<const ov::Model>& model);
+
+    /**
+     * Writes the blocks of the prefix cache managed by the scheduler to a file. Must not be called while a generation step
+     * is in progress.
+     * @param path The path of the snapshot file.
+     * @param scheduler The scheduler owning the prefix cache.
+     * @param model_fingerprint The fingerprint of the model the cache was computed with.
+     * @param input_ids If set, only the cached blocks holding a prefix of these prompt tokens are written.
+     * @return The number of saved blocks.
+     */
+    static size_t save(const std::filesystem::path& path, Scheduler& scheduler, uint64_t model_fingerprint,
+                       const ov::Tensor& input_ids = ov::Tensor());
+
+    /**
+     * Fills the free KV cache blocks of the scheduler with the blocks from a snapshot file and makes them available for
+     * prefix caching. A dynamically allocated KV cache is grown to fit the snapshot, otherwise the least recently used
+     * cached blocks are overwritten once no free blocks are left. A snapshot which is missing, corrupted, does not match the
+     * model or the KV cache layout (including the shapes of the blocks), or does not fit into the memory available to a
+     * dynamically allocated KV cache is skipped with a warning before anything is allocated for it. Must not be called
+     * while a generation step is in progress.
+     * @param path The path of the snapshot file.
+     * @param scheduler The scheduler owning the prefix cache.
+     * @param model_fingerprint The fingerprint of the model used in the pipeline.
+     * @return The number of loaded blocks.
+     */
+    static size_t load(const std::filesystem::path& path, Scheduler& scheduler, uint64_t model_fingerprint);
+};
+
+}
@@ -0,0 +1,141 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <cstdlib>
+#include <cstring>
+
+#include "openvino/core/except.hpp"
+#include "continuous_batching/reserved_memory.hpp"
+#include "logger.hpp"
+
+namespace {
+
+size_t get_page_size() {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+#else
+    return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+size_t round_up(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+} // namespace
+
+namespace ov::genai {
+
+ReservedMemory::ReservedMemory(size_t capacity, size_t chunk_size) {
+    OPENVINO_ASSERT(capacity > 0 && chunk_size > 0, "Reserved memory must have a non-zero capacity and chunk size");
+    m_chunk_size = round_up(chunk_size, get_page_size());
+    m_capacity = round_up(capacity, m_chunk_size);
+#ifdef _WIN32
+    void* data = VirtualAlloc(nullptr, m_capacity, MEM_RESERVE, PAGE_NOACCESS);
+    m_is_reserved = data != nullptr;
+#else
+    // no MAP_NORESERVE: the pages are accounted when they are made writable, so a commit fails with ENOMEM
+    // under strict overcommit instead of the process being killed when it touches the pages
+    void* data = mmap(nullptr, m_capacity, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    m_is_reserved = data != MAP_FAILED;
+#endif
+    if (m_is_reserved) {
+        m_data = static_cast<uint8_t*>(data);
+    } else {
+        GENAI_WARN("Failed to reserve %zu bytes of address space, the memory is reallocated on resize instead", m_capacity);
+    }
+}
+
+ReservedMemory::~ReservedMemory() {
+    if (m_is_reserved) {
+        _release_reservation();
+    } else {
+        std::free(m_data);
+    }
+}
+
+void ReservedMemory::_release_reservation() {
+#ifdef _WIN32
+    VirtualFree(m_data, 0, MEM_RELEASE);
+#else
+    munmap(m_data, m_capacity);
+#endif
+}
+
+void ReservedMemory::_resize_allocation(size_t size) {
+    if (size == 0) {
+        std::free(m_data);
+        m_data = nullptr;
+        return;
+    }
+    uint8_t* data = static_cast<uint8_t*>(std::realloc(m_data, size));
+    OPENVINO_ASSERT(data != nullptr, "Failed to allocate ", size, " bytes of memory");
+    if (size > m_committed_size) {
+        std::memset(data + m_committed_size, 0, size - m_committed_size);
+    }
+    m_data = data;
+}
+
+void ReservedMemory::resize(size_t size) {
+    OPENVINO_ASSERT(size <= m_capacity, "Requested ", size, " bytes, while only ", m_capacity, " bytes are reserved");
+    size_t committed_size = round_up(size, m_chunk_size);
+    if (!m_is_reserved) {
+        if (committed_size != m_committed_size) {
+            _resize_allocation(committed_size);
+        }
+    } else if (committed_size > m_committed_size) {
+        uint8_t* begin = m_data + m_committed_size;
+        size_t length = committed_size - m_committed_size;
+#ifdef _WIN32
+        bool is_committed = VirtualAlloc(begin, length, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#else
+        bool is_committed = mprotect(begin, length, PROT_READ | PROT_WRITE) == 0;
+#endif
+        if (!is_committed) {
+            GENAI_WARN("Failed to commit %zu bytes of reserved memory, falling back to a regular allocation", length);
+            uint8_t* data = static_cast<uint8_t*>(std::malloc(committed_size));
+            OPENVINO_ASSERT(data != nullptr, "Failed to allocate ", committed_size, " bytes of memory");
+            std::memcpy(data, m_data, m_committed_size);
+            std::memset(data + m_committed_size, 0, length);
+            _release_reservation();
+            m_data = data;
+            m_is_reserved = false;
+        }
+    } else if (committed_size < m_committed_size) {
+        uint8_t* begin = m_data + committed_size;
+        size_t length = m_committed_size - committed_size;
+#ifdef _WIN32
+        VirtualFree(begin, length, MEM_DECOMMIT);
+#else
+        // the pages are dropped, so that they are zero-filled if committed again
+        madvise(begin, length, MADV_DONTNEED);
+        mprotect(begin, length, PROT_NONE);
+#endif
+    }
+    m_committed_size = committed_size;
+}
+
+size_t ReservedMemory::get_physical_memory_size() {
+#ifdef _WIN32
+    MEMORYSTATUSEX status;
+    status.dwLength = sizeof(status);
+    return GlobalMemoryStatusEx(&status) ? static_cast<size_t>(status.ullTotalPhys) : 0;
+#else
+    long num_pages = sysconf(_SC_PHYS_PAGES);
+    return num_pages > 0 ? static_cast<size_t>(num_pages) * get_page_size() : 0;
+#endif
+}
+
+}  // namespace ov::genai
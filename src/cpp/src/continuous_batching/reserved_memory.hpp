@@ -0,0 +1,81 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ov::genai {
+
+/**
+ * @brief A range of virtual address space reserved up front and backed by physical memory in fixed-size chunks on demand.
+ * The data never moves: growing commits more chunks after the already committed ones, so that tensors over this memory can
+ * be enlarged without copying, and shrinking returns the trailing chunks to the OS.
+ *
+ * The committed chunks are charged against the commit limit of the system when they are committed, not when they are
+ * first touched, so running out of memory fails the commit instead of faulting on a page later (e.g. under
+ * vm.overcommit_memory=2 on Linux). If the address space can not be reserved (e.g. it is limited with ulimit -v) or
+ * a commit fails, the memory falls back to a regular allocation of the committed size, which is reallocated on resize,
+ * so data() may change and the tensors over the memory have to be recreated after each resize.
+ */
+class ReservedMemory {
+    uint8_t* m_data = nullptr;
+    size_t m_capacity = 0;
+    size_t m_chunk_size = 0;
+    size_t m_committed_size = 0;
+    // false if the memory is a regular allocation of the committed size
+    bool m_is_reserved = false;
+
+    void _release_reservation();
+    void _resize_allocation(size_t size);
+
+public:
+    /**
+     * Reserves the address space, no physical memory is committed yet.
+     * @param capacity The maximum size in bytes the memory can grow to, rounded up to the chunk size.
+     * @param chunk_size The granularity of committing and releasing the memory in bytes, rounded up to the page size.
+     */
+    explicit ReservedMemory(size_t capacity, size_t chunk_size = 2 * 1024 * 1024);
+    ~ReservedMemory();
+
+    ReservedMemory(const ReservedMemory&) = delete;
+    ReservedMemory& operator=(const ReservedMemory&) = delete;
+
+    uint8_t* data() const {
+        return m_data;
+    }
+
+    size_t get_capacity() const {
+        return m_capacity;
+    }
+
+    /**
+     * @return The number of bytes backed by physical memory, a multiple of the chunk size.
+     */
+    size_t get_committed_size() const {
+        return m_committed_size;
+    }
+
+    /**
+     * @return Whether the data stays in place on resize, false after falling back to a regular allocation.
+     */
+    bool is_reserved() const {
+        return m_is_reserved;
+    }
+
+    /**
+     * Commits or releases chunks so that exactly the chunks overlapping with the first `size` bytes are committed.
+     * The contents of the chunks which stay committed are preserved, newly committed memory is zero-initialized.
+     * Throws if neither the chunks can be committed nor the regular allocation succeeds.
+     * @param size The number of bytes to be accessible, must not exceed the capacity.
+     */
+    void resize(size_t size);
+
+    /**
+     * @return The size of the physical memory of the system in bytes, or 0 if it is unknown.
+     */
+    static size_t get_physical_memory_size();
+};
+
+}  // namespace ov::genai
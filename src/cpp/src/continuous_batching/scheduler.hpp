@@ -16,6 +16,8 @@
 #include "continuous_batching/sparse_attention.hpp"
 #include "utils.hpp"
 #include "continuous_batching/cache_eviction.hpp"
+#include "continuous_batching/scheduling_policy.hpp"
+#include "continuous_batching/prefill_token_budget.hpp"
 
 namespace ov::genai {
 class Scheduler {
@@ -24,22 +26,53 @@ class Scheduler {
     SchedulerConfig m_config;
     std::shared_ptr<BlockManager> m_block_manager;
     friend class CacheStateDumper;
+    friend class PrefixCacheSnapshot;
 
     bool m_dynamic_memory_allocation = false;
 
     // Dynamic KV-cache allocation params
     size_t m_kv_blocks_initial_multiplier = 2;
     const float m_cache_growth_num_tokens = 256; // Number of tokens by which KV-cache is increased
+    const size_t m_cache_shrink_check_interval = 64; // Number of steps between checks whether KV-cache can be shrunk
+    size_t m_num_steps_since_cache_shrink_check = 0;
 
     std::shared_ptr<CacheManager> m_cache_manager;
 
     size_t m_snapkv_window_size = 1;
+
+    // Host swap space for preempted sequences, see SchedulerConfig::swap_space
+    size_t m_max_num_host_blocks = 0;
+    size_t m_num_host_blocks = 0;
+    std::vector<size_t> m_free_host_blocks;
+    // host blocks holding the KV cache of swapped out sequences, one per logical block
+    std::map<uint64_t, std::vector<size_t>> m_swapped_out_blocks;
+    // host -> device block copies per layer, performed once the device cache is allocated at the end of the step
+    std::vector<std::vector<std::pair<size_t, size_t>>> m_pending_swap_in;
+    std::vector<size_t> m_pending_swap_in_host_blocks;
+    // sequences swapped in at the current step, their blocks must not be freed before the copies are done
+    std::set<uint64_t> m_swapped_in_seq_ids;
+
+    // disk tier of the prefix cache, see SchedulerConfig::prefix_cache_disk_size
+    std::shared_ptr<DiskBlockCache> m_disk_cache;
+
+    // order of admission and preemption of sequence groups, see SchedulerConfig::scheduling_policy
+    std::shared_ptr<ISchedulingPolicy> m_scheduling_policy;
+
+    // Multi-step generation window, see SchedulerConfig::num_scheduler_steps
+    // number of steps left in the current window
+    size_t m_num_multi_steps_left = 0;
+    // request IDs of the sequence groups generated within the window and their numbers of running sequences
+    std::map<uint64_t, size_t> m_multi_step_requests;
+
+    // number of prompt tokens scheduled with generated tokens, see SchedulerConfig::inter_token_latency_target_ms
+    std::unique_ptr<PrefillTokenBudget> m_prefill_token_budget;
 public:
     struct Output {
         // IDs of scheduled groups
         std::vector<uint64_t> m_scheduled_sequence_groups_ids;
-        // block tables for scheduled sequences per each attention layer in the model
-        std::map<uint64_t, std::vector<BlocksPerLayer>> m_block_tables;
+        // physical block indices of the scheduled sequences per each attention layer in the model, owned by the
+        // block manager and only valid until its block tables are modified after the step
+        std::map<uint64_t, const BlockIndicesPerLayer*> m_block_indices;
         // how many previous token scores to aggregate in the paged attention score output, per sequence
         std::map<uint64_t, size_t> m_score_aggregation_windows;
 
@@ -55,6 +88,8 @@ public:
 
         // total number of scheduled tokens
         size_t m_total_num_scheduled_tokens = 0;
+        // number of scheduled prompt tokens, the rest of the scheduled tokens are generated ones
+        size_t m_num_prompt_tokens = 0;
         // dedicated prompt phase
         bool is_prompt = false;
         // current cache usage
@@ -68,11 +103,29 @@ public:
         m_snapkv_window_size(snapkv_window_size) {
         m_block_manager = std::make_shared<BlockManager>(m_config.num_kv_blocks, m_config.enable_prefix_caching, block_size, num_layers);
         OPENVINO_ASSERT(num_layers != 0, "num_layers must be non-zero");
+        m_scheduling_policy = create_scheduling_policy(m_config);
+        if (m_config.dynamic_split_fuse && m_config.inter_token_latency_target_ms > 0) {
+            m_prefill_token_budget = std::make_unique<PrefillTokenBudget>(static_cast<float>(m_config.inter_token_latency_target_ms),
+                                                                          block_size, m_config.max_num_batched_tokens);
+        }
+        if (m_config.swap_space > 0 && m_cache_manager && m_cache_manager->get_block_size_in_bytes() > 0) {
+            m_max_num_host_blocks = m_config.swap_space * 1024 * 1024 * 1024 / m_cache_manager->get_block_size_in_bytes();
+        }
+        if (m_config.enable_prefix_caching && m_config.prefix_cache_disk_size > 0 && m_cache_manager && m_cache_manager->get_block_size_in_bytes() > 0) {
+            size_t block_size_in_bytes = m_cache_manager->get_block_size_in_bytes();
+            size_t num_disk_blocks = m_config.prefix_cache_disk_size * 1024 * 1024 * 1024 / block_size_in_bytes;
+            if (num_disk_blocks > 0) {
+                m_disk_cache = std::make_shared<DiskBlockCache>(m_config.prefix_cache_disk_dir, num_disk_blocks, block_size_in_bytes);
+                m_block_manager->set_disk_cache(m_disk_cache);
+            }
+        }
     }
 
     void release() {
+        m_swapped_out_blocks.clear();
         m_cache_manager.reset();
         m_block_manager.reset();
+        m_disk_cache.reset();
     }
 
     Output schedule(std::vector<SequenceGroup::Ptr>& sequence_groups) {
@@ -80,13 +133,29 @@ public:
         // map of src -> dst blocks copies, which need to be performed by CacheManager
         std::map<size_t, std::list<size_t>> block_copy_map;
 
+        // within a multi-step window the generated sequence groups just get their next token
+        if (_schedule_multi_step(sequence_groups, scheduler_output, block_copy_map)) {
+            m_scheduling_policy->on_scheduled(sequence_groups, scheduler_output.m_scheduled_sequence_groups_ids);
+            scheduler_output.m_cache_usage = m_block_manager->get_used_percentage();
+            m_cache_manager->copy_blocks(block_copy_map);
+            return scheduler_output;
+        }
+
         // free some blocks taken by non-confirmed candidates in SD / prompt look-up
         clean_empty_blocks(sequence_groups);
 
+        _try_decrease_cache();
+
+        // the phases below admit sequence groups in the order of the vector and preempt them in the reverse order
+        m_scheduling_policy->order(sequence_groups);
+
         if (m_block_manager->get_total_number_of_kv_blocks() == 0) {
             _initialize_cache(sequence_groups);
         }
 
+        // blocks restored from the disk tier since the previous step must be in place before they can be swapped out
+        _apply_pending_disk_transfers();
+
         if (m_config.dynamic_split_fuse) {
             // deepspeed-mii case
             // generation phase is always scheduled first
@@ -105,11 +174,16 @@ public:
             }
         }
 
+        _start_multi_step_window(sequence_groups);
+
         m_cache_manager->allocate_cache_if_needed(m_block_manager->get_total_number_of_kv_blocks());
+        _apply_pending_disk_transfers();
+        _apply_pending_swap_in();
         _clear_waiting_sequences(sequence_groups);
+        m_scheduling_policy->on_scheduled(sequence_groups, scheduler_output.m_scheduled_sequence_groups_ids);
         scheduler_output.m_cache_usage = m_block_manager->get_used_percentage();
 
-        static ManualTimer copy_blocks_timer("copy block");
+        static thread_local ManualTimer copy_blocks_timer("copy block");
         copy_blocks_timer.start();
         m_cache_manager->copy_blocks(block_copy_map);
         copy_blocks_timer.end();
@@ -117,6 +191,18 @@ public:
         return scheduler_output;
     }
 
+    /**
+     * Updates the number of prompt tokens scheduled with generated tokens with the duration of a step.
+     * @param scheduler_output The output of schedule() for the step.
+     * @param duration_ms The duration of the inference of the step.
+     */
+    void register_step_duration(const Output& scheduler_output, float duration_ms) {
+        if (m_prefill_token_budget) {
+            m_prefill_token_budget->register_step(scheduler_output.m_total_num_scheduled_tokens - scheduler_output.m_num_prompt_tokens,
+                                                  scheduler_output.m_num_prompt_tokens, duration_ms);
+        }
+    }
+
     /**
      * Some requests can contain empty blocks after prompt look-up or speculative decoding
      * when candidates are not confirmed by main model and we need to free blocks, taken by these candidates
@@ -138,11 +224,24 @@ public:
         return m_block_manager->get_block_tables(seq_id);
     }
 
+    /**
+     * @return Whether the sequence holds KV cache blocks, either on device or swapped out to host memory.
+     */
     const bool has_block_table(uint64_t seq_id) {
-        return m_block_manager->has_block_table(seq_id);
+        return m_block_manager->has_block_table(seq_id) || is_swapped_out(seq_id);
+    }
+
+    bool is_swapped_out(uint64_t seq_id) const {
+        return m_swapped_out_blocks.count(seq_id) != 0;
     }
 
     void free_sequence(uint64_t seq_id) {
+        auto swapped_it = m_swapped_out_blocks.find(seq_id);
+        if (swapped_it != m_swapped_out_blocks.end()) {
+            m_free_host_blocks.insert(m_free_host_blocks.end(), swapped_it->second.begin(), swapped_it->second.end());
+            m_swapped_out_blocks.erase(swapped_it);
+            return;
+        }
         m_block_manager->free_sequence(seq_id);
     }
 
@@ -166,6 +265,7 @@ public:
         OPENVINO_ASSERT(m_config.enable_prefix_caching == false, "KV-cache should not be cleared if prefix caching is enabled.");
         m_cache_manager->clear();
         m_block_manager->clear();
+        _end_multi_step_window();
     }
 
 private:
@@ -233,11 +333,151 @@ private:
         return m_block_manager->num_free_blocks() > prev_blocks_count;
     }
 
-    static size_t _get_low_priority_sequence_group_id(const std::vector<SequenceGroup::Ptr>& sequence_groups) {
+    bool _can_swap_out(const SequenceGroup::Ptr& sequence_group) const {
+        if (m_max_num_host_blocks == 0 || sequence_group->get_num_evicted_tokens() != 0 || sequence_group->get_num_tokens_to_validate() != 0) {
+            return false;
+        }
+        // forked sequences share blocks, so only groups with a single sequence are swapped
+        auto sequences = sequence_group->get_not_finished_sequences();
+        if (sequences.size() != 1 || !m_block_manager->has_block_table(sequences[0]->get_id())) {
+            return false;
+        }
+        size_t num_blocks = m_block_manager->get_block_tables(sequences[0]->get_id())[0].size();
+        return num_blocks <= m_free_host_blocks.size() + (m_max_num_host_blocks - m_num_host_blocks);
+    }
+
+    std::vector<size_t> _allocate_host_blocks(size_t num_blocks) {
+        if (m_free_host_blocks.size() < num_blocks) {
+            // grow the swap space geometrically up to its configured limit
+            size_t new_num_host_blocks = std::max(m_num_host_blocks + num_blocks - m_free_host_blocks.size(), 2 * m_num_host_blocks);
+            new_num_host_blocks = std::min(new_num_host_blocks, m_max_num_host_blocks);
+            m_cache_manager->allocate_swap_space_if_needed(new_num_host_blocks);
+            for (size_t host_block_id = m_num_host_blocks; host_block_id < new_num_host_blocks; ++host_block_id) {
+                m_free_host_blocks.push_back(host_block_id);
+            }
+            m_num_host_blocks = new_num_host_blocks;
+        }
+        OPENVINO_ASSERT(m_free_host_blocks.size() >= num_blocks, "Internal error: not enough blocks in swap space");
+        std::vector<size_t> host_blocks(m_free_host_blocks.end() - num_blocks, m_free_host_blocks.end());
+        m_free_host_blocks.resize(m_free_host_blocks.size() - num_blocks);
+        return host_blocks;
+    }
+
+    bool _preempt_by_swap(SequenceGroup::Ptr sequence_group) {
+        static thread_local ManualTimer timer("swap out");
+        timer.start();
+        size_t prev_blocks_count = m_block_manager->num_free_blocks();
+        uint64_t seq_id = sequence_group->get_not_finished_sequences()[0]->get_id();
+        const auto& block_tables = m_block_manager->get_block_tables(seq_id);
+        std::vector<size_t> host_blocks = _allocate_host_blocks(block_tables[0].size());
+
+        std::vector<std::vector<std::pair<size_t, size_t>>> per_layer_device_to_host_blocks(block_tables.size());
+        for (size_t layer_idx = 0; layer_idx < block_tables.size(); ++layer_idx) {
+            for (size_t logical_block_idx = 0; logical_block_idx < host_blocks.size(); ++logical_block_idx) {
+                per_layer_device_to_host_blocks[layer_idx].emplace_back(block_tables[layer_idx][logical_block_idx]->get_index(), host_blocks[logical_block_idx]);
+            }
+        }
+        m_cache_manager->swap_out(per_layer_device_to_host_blocks);
+
+        m_block_manager->free_sequence(seq_id);
+        m_swapped_out_blocks[seq_id] = std::move(host_blocks);
+        sequence_group->set_waiting();
+        timer.end();
+        return m_block_manager->num_free_blocks() > prev_blocks_count;
+    }
+
+    /**
+     * Allocates device blocks for a swapped out sequence group and schedules copying of its KV cache back from host memory.
+     * @return Whether the group is not swapped out (anymore) and can be scheduled.
+     */
+    bool _try_swap_in(const SequenceGroup::Ptr& sequence_group) {
+        if (m_swapped_out_blocks.empty()) {
+            return true;
+        }
+        auto sequences = sequence_group->get_not_finished_sequences();
+        if (sequences.size() != 1) {
+            return true;
+        }
+        Sequence::Ptr sequence = sequences[0];
+        uint64_t seq_id = sequence->get_id();
+        auto swapped_it = m_swapped_out_blocks.find(seq_id);
+        if (swapped_it == m_swapped_out_blocks.end()) {
+            return true;
+        }
+
+        const std::vector<size_t>& host_blocks = swapped_it->second;
+        while (!m_block_manager->can_allocate_blocks(host_blocks.size())) {
+            if (!_try_increase_cache()) {
+                return false;
+            }
+        }
+        m_block_manager->allocate(sequence, host_blocks.size(), sequence_group->get_prompt_len());
+
+        const auto& block_tables = m_block_manager->get_block_tables(seq_id);
+        m_pending_swap_in.resize(std::max(m_pending_swap_in.size(), block_tables.size()));
+        for (size_t layer_idx = 0; layer_idx < block_tables.size(); ++layer_idx) {
+            for (size_t logical_block_idx = 0; logical_block_idx < host_blocks.size(); ++logical_block_idx) {
+                m_pending_swap_in[layer_idx].emplace_back(host_blocks[logical_block_idx], block_tables[layer_idx][logical_block_idx]->get_index());
+            }
+        }
+        m_pending_swap_in_host_blocks.insert(m_pending_swap_in_host_blocks.end(), host_blocks.begin(), host_blocks.end());
+        m_swapped_in_seq_ids.insert(seq_id);
+        m_swapped_out_blocks.erase(swapped_it);
+        return true;
+    }
+
+    void _apply_pending_disk_transfers() {
+        if (!m_disk_cache) {
+            return;
+        }
+        auto transfers = m_block_manager->take_pending_disk_transfers();
+        if (transfers.empty()) {
+            return;
+        }
+        static thread_local ManualTimer timer("prefix cache disk transfers");
+        timer.start();
+        // transfers are applied in the order they were requested, so that a block stored to disk before being
+        // overwritten is read before the new contents are written to it
+        for (const auto& transfer : transfers) {
+            uint8_t* slot_data = m_disk_cache->get_slot_data(transfer.slot);
+            if (transfer.to_disk) {
+                m_cache_manager->store_block(transfer.block_indices, slot_data);
+            } else {
+                m_cache_manager->load_block(slot_data, transfer.block_indices);
+                m_disk_cache->release(transfer.slot);
+            }
+        }
+        timer.end();
+    }
+
+    void _apply_pending_swap_in() {
+        if (!m_pending_swap_in_host_blocks.empty()) {
+            static thread_local ManualTimer timer("swap in");
+            timer.start();
+            m_cache_manager->swap_in(m_pending_swap_in);
+            m_free_host_blocks.insert(m_free_host_blocks.end(), m_pending_swap_in_host_blocks.begin(), m_pending_swap_in_host_blocks.end());
+            timer.end();
+        }
+        m_pending_swap_in.clear();
+        m_pending_swap_in_host_blocks.clear();
+        m_swapped_in_seq_ids.clear();
+    }
+
+    bool _is_preemptible(const SequenceGroup::Ptr& sequence_group) const {
+        for (const auto& sequence : sequence_group->get_not_finished_sequences()) {
+            uint64_t seq_id = sequence->get_id();
+            if (is_swapped_out(seq_id) || m_swapped_in_seq_ids.count(seq_id) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t _get_low_priority_sequence_group_id(const std::vector<SequenceGroup::Ptr>& sequence_groups) const {
         for (size_t seq_group_id = 0, num_groups = sequence_groups.size(); seq_group_id < num_groups; ++seq_group_id) {
             size_t group_idx = num_groups - seq_group_id - 1;
             SequenceGroup::CPtr sequence_group = sequence_groups[group_idx];
-            if (sequence_group->get_num_processed_tokens() > 0) {
+            if (sequence_group->get_num_processed_tokens() > 0 && _is_preemptible(sequence_groups[group_idx])) {
                 // we are here, because current sequence group has some reserved KV blocks in block manager
                 // which can be freed
                 return group_idx;
@@ -260,7 +500,10 @@ private:
                 break;
             }
             size_t blocks_needed = m_block_manager->required_blocks_count(sequence_group);
-            if (!_preempt_by_recompute(sequence_groups[evicted_sequence_group_id], blocks_needed)){
+            SequenceGroup::Ptr evicted_sequence_group = sequence_groups[evicted_sequence_group_id];
+            bool is_preempted = _can_swap_out(evicted_sequence_group) ? _preempt_by_swap(evicted_sequence_group)
+                                                                      : _preempt_by_recompute(evicted_sequence_group, blocks_needed);
+            if (!is_preempted) {
                 break;
             }
         }
@@ -275,16 +518,26 @@ private:
         //    greedy scheduling of prompt with higher priority
         // 2. The mechanism below performs greedy scheduling of high priority prompts
 
+        size_t max_num_batched_tokens = m_config.max_num_batched_tokens;
+        // the generated tokens are scheduled first, so the prompt tokens are limited to keep their latency target
+        if (m_prefill_token_budget && scheduler_output.m_total_num_scheduled_tokens > 0) {
+            max_num_batched_tokens = std::min(max_num_batched_tokens,
+                                              scheduler_output.m_total_num_scheduled_tokens + m_prefill_token_budget->get_budget());
+        }
+
         for (size_t sequence_group_id = 0; sequence_group_id < sequence_groups.size(); ++sequence_group_id) {
             SequenceGroup::Ptr sequence_group = sequence_groups[sequence_group_id];
             if (!sequence_group->can_generate_tokens() && !sequence_group->is_waiting() && !sequence_group->handle_stopped() && !sequence_group->handle_cancelled()) {
+                if (!_try_swap_in(sequence_group)) {
+                    continue;
+                }
                 size_t num_running_seqs = sequence_group->num_running_seqs();
                 // prompt phases can have a single running sequence
                 OPENVINO_ASSERT(num_running_seqs == 1);
                 Sequence::Ptr sequence = (*sequence_group)[0];
                 uint64_t seq_id = sequence->get_id();
 
-                size_t num_tokens_in_megabatch = m_config.max_num_batched_tokens - scheduler_output.m_total_num_scheduled_tokens;
+                size_t num_tokens_in_megabatch = max_num_batched_tokens - scheduler_output.m_total_num_scheduled_tokens;
                 size_t num_available_tokens = sequence_group->get_num_available_tokens_for_batching();
 
                 // apply megabatch limitations
@@ -318,8 +571,9 @@ private:
                     // add information to scheduler_output
                     {
                         scheduler_output.m_scheduled_sequence_groups_ids.push_back(sequence_group_id);
-                        scheduler_output.m_block_tables[seq_id] = m_block_manager->get_block_tables(seq_id);
+                        scheduler_output.m_block_indices[seq_id] = &m_block_manager->get_block_indices(seq_id);
                         scheduler_output.m_total_num_scheduled_tokens += num_scheduled_tokens * num_running_seqs;
+                        scheduler_output.m_num_prompt_tokens += num_scheduled_tokens * num_running_seqs;
 
 
                         scheduler_output.m_score_aggregation_windows[seq_id] = _schedule_scores_to_aggregate(sequence_group);
@@ -338,7 +592,7 @@ private:
                 }
 
                 // if we added maximum amount of tokens to compute
-                if (scheduler_output.m_total_num_scheduled_tokens == m_config.max_num_batched_tokens)
+                if (scheduler_output.m_total_num_scheduled_tokens == max_num_batched_tokens)
                     break;
             }
         }
@@ -365,6 +619,10 @@ private:
                 if (!available_tokens_per_seq_in_megabatch)
                     continue;
 
+                // KV cache of a preempted group may need to be restored from swap space first
+                if (!_try_swap_in(sequence_group))
+                    continue;
+
                 // Note: current function can return more than 1 token even for generation phase in case of some tokens
                 // of current sequence group were evicted before
                 size_t num_available_tokens_per_seq = sequence_group->get_num_available_tokens_for_batching();
@@ -399,7 +657,7 @@ private:
                     for (const auto & seq : sequence_group->get_running_sequences()) {
                         size_t seq_id = seq->get_id();
                         // block tables for each running sequence within a group
-                        scheduler_output.m_block_tables[seq_id] = m_block_manager->get_block_tables(seq_id);
+                        scheduler_output.m_block_indices[seq_id] = &m_block_manager->get_block_indices(seq_id);
 
                         scheduler_output.m_score_aggregation_windows[seq_id] = _schedule_scores_to_aggregate(sequence_group);
                         scheduler_output.m_xattention_block_size = m_config.sparse_attention_config.xattention_block_size;
@@ -488,8 +746,9 @@ private:
                     {
                         scheduler_output.m_scheduled_sequence_groups_ids.push_back(sequence_group_id);
                         uint64_t seq_id = sequence_group->get_running_sequences()[0]->get_id();
-                        scheduler_output.m_block_tables[seq_id] = m_block_manager->get_block_tables(seq_id);
+                        scheduler_output.m_block_indices[seq_id] = &m_block_manager->get_block_indices(seq_id);
                         scheduler_output.m_total_num_scheduled_tokens += sequence_len;
+                        scheduler_output.m_num_prompt_tokens += sequence_len;
                         scheduler_output.m_score_aggregation_windows[seq_id] = _schedule_scores_to_aggregate(sequence_group);
                         scheduler_output.m_xattention_thresholds[seq_id] = _schedule_xattention_threshold(sequence_group);
                         scheduler_output.m_xattention_block_size = m_config.sparse_attention_config.xattention_block_size;
@@ -557,6 +816,146 @@ private:
         return true;
     }
 
+    // Returns the memory of the free blocks at the end of the dynamically allocated KV-cache once the load drops
+    void _try_decrease_cache() {
+        if (!m_dynamic_memory_allocation || !m_cache_manager || !m_cache_manager->can_shrink_cache()) {
+            return;
+        }
+        // finding the occupied blocks walks the free lists of all layers, so it is not done at each step
+        if (++m_num_steps_since_cache_shrink_check < m_cache_shrink_check_interval) {
+            return;
+        }
+        m_num_steps_since_cache_shrink_check = 0;
+
+        size_t current_num_of_kv_blocks = m_block_manager->get_total_number_of_kv_blocks();
+        size_t growth_num_blocks = std::ceil(m_cache_growth_num_tokens / get_block_size());
+        // one growth step is kept as headroom, and small gains are skipped to not alternate with _try_increase_cache()
+        size_t new_blocks_num = m_block_manager->get_min_kv_blocks_number() + growth_num_blocks;
+        if (new_blocks_num + std::max(2 * growth_num_blocks, current_num_of_kv_blocks / 4) > current_num_of_kv_blocks) {
+            return;
+        }
+        m_block_manager->decrease_kv_blocks_number(new_blocks_num);
+        m_cache_manager->shrink_cache(new_blocks_num);
+    }
+
+    /**
+     * Starts a multi-step window after a full scheduling step if all the non-finished sequence groups are scheduled for
+     * a single generated token and there are enough free KV cache blocks (growing the cache if needed) for all of them
+     * to generate SchedulerConfig::num_scheduler_steps tokens.
+     */
+    void _start_multi_step_window(const std::vector<SequenceGroup::Ptr>& sequence_groups) {
+        _end_multi_step_window();
+        if (m_config.num_scheduler_steps <= 1 || m_config.use_cache_eviction || m_config.use_sparse_attention) {
+            return;
+        }
+
+        size_t num_lookahead_tokens = m_config.num_scheduler_steps - 1;
+        size_t block_size = get_block_size();
+        size_t num_required_blocks = 0;
+        for (const auto& sequence_group : sequence_groups) {
+            if (!sequence_group->is_scheduled()) {
+                if (sequence_group->has_finished() || sequence_group->handle_stopped() || sequence_group->handle_cancelled()) {
+                    continue;
+                }
+                // waiting or preempted sequence groups are not postponed for the whole window
+                _end_multi_step_window();
+                return;
+            }
+            // beam search forks sequences at each step, speculative decoding validates several tokens at once
+            if (!sequence_group->can_generate_tokens() || sequence_group->get_num_scheduled_tokens() != 1 ||
+                sequence_group->get_num_tokens_to_validate() != 0 || sequence_group->get_sampling_parameters().is_beam_search()) {
+                _end_multi_step_window();
+                return;
+            }
+            size_t num_running_seqs = sequence_group->num_running_seqs();
+            size_t num_window_blocks = (sequence_group->get_context_len() + num_lookahead_tokens + block_size - 1) / block_size;
+            num_required_blocks += (num_window_blocks - sequence_group->get_num_logical_blocks()) * num_running_seqs;
+            m_multi_step_requests[sequence_group->get_request_id()] = num_running_seqs;
+        }
+        if (m_multi_step_requests.empty()) {
+            return;
+        }
+
+        while (m_block_manager->num_free_blocks() < num_required_blocks) {
+            if (!_try_increase_cache()) {
+                _end_multi_step_window();
+                return;
+            }
+        }
+        m_num_multi_steps_left = num_lookahead_tokens;
+    }
+
+    void _end_multi_step_window() {
+        m_num_multi_steps_left = 0;
+        m_multi_step_requests.clear();
+    }
+
+    /**
+     * Schedules the next token of each sequence group of the current multi-step window which is still running, without
+     * admission of new sequence groups and preemption. The window ends early if a sequence group has more than one
+     * token to process or got forked, or if the reserved blocks turn out to be insufficient.
+     * @return Whether the step was scheduled, otherwise a full scheduling is required.
+     */
+    bool _schedule_multi_step(std::vector<SequenceGroup::Ptr>& sequence_groups,
+                              Output& scheduler_output,
+                              std::map<size_t, std::list<size_t>>& block_copy_map) {
+        if (m_num_multi_steps_left == 0) {
+            return false;
+        }
+        --m_num_multi_steps_left;
+
+        std::vector<size_t> scheduled_ids;
+        bool can_continue = true;
+        for (size_t sequence_group_id = 0; sequence_group_id < sequence_groups.size() && can_continue; ++sequence_group_id) {
+            const SequenceGroup::Ptr& sequence_group = sequence_groups[sequence_group_id];
+            auto it = m_multi_step_requests.find(sequence_group->get_request_id());
+            // sequence groups added within the window wait for the next full scheduling
+            if (it == m_multi_step_requests.end() || sequence_group->has_finished() ||
+                sequence_group->handle_stopped() || sequence_group->handle_cancelled()) {
+                continue;
+            }
+            can_continue = sequence_group->num_running_seqs() <= it->second &&
+                           sequence_group->get_num_available_tokens_for_batching() == 1;
+            if (can_continue) {
+                // candidates rejected by speculative decoding / prompt look-up can leave empty blocks
+                m_block_manager->free_empty_physical_blocks(sequence_group);
+                sequence_group->schedule_tokens(1);
+                scheduled_ids.push_back(sequence_group_id);
+            }
+        }
+
+        size_t num_required_blocks = 0;
+        for (size_t sequence_group_id : scheduled_ids) {
+            num_required_blocks += m_block_manager->required_blocks_count(sequence_groups[sequence_group_id]);
+        }
+        if (!can_continue || scheduled_ids.empty() || num_required_blocks > m_block_manager->num_free_blocks()) {
+            for (size_t sequence_group_id : scheduled_ids) {
+                sequence_groups[sequence_group_id]->clear_scheduled_tokens();
+            }
+            _end_multi_step_window();
+            return false;
+        }
+
+        for (size_t sequence_group_id : scheduled_ids) {
+            const SequenceGroup::Ptr& sequence_group = sequence_groups[sequence_group_id];
+            std::map<size_t, std::list<size_t>> copy_blocks_map = m_block_manager->append_slots(sequence_group);
+            for (const auto& [src_index, dst_indexes] : copy_blocks_map) {
+                block_copy_map[src_index].insert(block_copy_map[src_index].end(), dst_indexes.begin(), dst_indexes.end());
+            }
+
+            scheduler_output.m_scheduled_sequence_groups_ids.push_back(sequence_group_id);
+            for (const auto& seq : sequence_group->get_running_sequences()) {
+                size_t seq_id = seq->get_id();
+                scheduler_output.m_block_indices[seq_id] = &m_block_manager->get_block_indices(seq_id);
+                scheduler_output.m_score_aggregation_windows[seq_id] = _schedule_scores_to_aggregate(sequence_group);
+            }
+            scheduler_output.m_total_num_scheduled_tokens += sequence_group->num_running_seqs();
+        }
+        // the new blocks may overwrite cached ones, which have to be stored to disk before the step writes to them
+        _apply_pending_disk_transfers();
+        return true;
+    }
+
     size_t _schedule_scores_to_aggregate(SequenceGroup::Ptr sequence_group) {
         auto calculator = SnapKVScoreAggregationCalculator(m_snapkv_window_size);
 
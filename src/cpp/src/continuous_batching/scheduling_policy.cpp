@@ -0,0 +1,132 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <limits>
+#include <unordered_set>
+
+#include "continuous_batching/scheduling_policy.hpp"
+
+namespace ov::genai {
+
+void PrioritySchedulingPolicy::order(std::vector<SequenceGroup::Ptr>& sequence_groups) {
+    std::stable_sort(sequence_groups.begin(), sequence_groups.end(), [](const SequenceGroup::Ptr& lhs, const SequenceGroup::Ptr& rhs) {
+        return lhs->get_sampling_parameters().priority > rhs->get_sampling_parameters().priority;
+    });
+}
+
+DeadlineSchedulingPolicy::Clock::time_point DeadlineSchedulingPolicy::get_deadline(const SequenceGroup::CPtr& sequence_group) const {
+    const GenerationConfig& config = sequence_group->get_sampling_parameters();
+    if (!sequence_group->can_generate_tokens()) {
+        if (config.ttft_target_ms == 0) {
+            return Clock::time_point::max();
+        }
+        return sequence_group->get_arrival_time() + std::chrono::milliseconds(config.ttft_target_ms);
+    }
+    if (config.tpot_target_ms == 0) {
+        return Clock::time_point::max();
+    }
+    auto progress_it = m_progress.find(sequence_group->get_request_id());
+    Clock::time_point last_progress_time = progress_it != m_progress.end() ? progress_it->second.time : Clock::now();
+    return last_progress_time + std::chrono::milliseconds(config.tpot_target_ms);
+}
+
+void DeadlineSchedulingPolicy::order(std::vector<SequenceGroup::Ptr>& sequence_groups) {
+    const Clock::time_point now = Clock::now();
+    std::unordered_map<uint64_t, Progress> progress;
+    for (const auto& sequence_group : sequence_groups) {
+        if (!sequence_group->can_generate_tokens()) {
+            continue;
+        }
+        uint64_t request_id = sequence_group->get_request_id();
+        size_t num_processed_tokens = sequence_group->get_num_processed_tokens();
+        auto it = m_progress.find(request_id);
+        if (it != m_progress.end() && it->second.num_processed_tokens == num_processed_tokens) {
+            progress.emplace(request_id, it->second);
+        } else {
+            progress.emplace(request_id, Progress{num_processed_tokens, now});
+        }
+    }
+    // finished sequence groups are dropped together with their progress
+    m_progress = std::move(progress);
+
+    std::vector<std::pair<Clock::time_point, SequenceGroup::Ptr>> deadlines;
+    deadlines.reserve(sequence_groups.size());
+    for (const auto& sequence_group : sequence_groups) {
+        deadlines.emplace_back(get_deadline(sequence_group), sequence_group);
+    }
+    std::stable_sort(deadlines.begin(), deadlines.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first < rhs.first;
+    });
+    for (size_t i = 0; i < deadlines.size(); ++i) {
+        sequence_groups[i] = deadlines[i].second;
+    }
+}
+
+FairShareSchedulingPolicy::FairShareSchedulingPolicy(const std::map<std::string, float>& tenant_weights) :
+    m_tenant_weights(tenant_weights) {
+    for (const auto& [tenant_id, weight] : m_tenant_weights) {
+        OPENVINO_ASSERT(weight > 0.0f, "Weight of tenant '", tenant_id, "' must be positive, got ", weight);
+    }
+}
+
+float FairShareSchedulingPolicy::_get_weight(const std::string& tenant_id) const {
+    auto it = m_tenant_weights.find(tenant_id);
+    return it != m_tenant_weights.end() ? it->second : 1.0f;
+}
+
+double FairShareSchedulingPolicy::get_usage(const std::string& tenant_id) const {
+    auto it = m_tenant_usage.find(tenant_id);
+    return it != m_tenant_usage.end() ? it->second : 0.0;
+}
+
+void FairShareSchedulingPolicy::order(std::vector<SequenceGroup::Ptr>& sequence_groups) {
+    std::unordered_set<std::string> active_tenants;
+    for (const auto& sequence_group : sequence_groups) {
+        active_tenants.insert(sequence_group->get_sampling_parameters().tenant_id);
+    }
+    // tenants without sequence groups do not accumulate credit while idle
+    double min_usage = std::numeric_limits<double>::max();
+    for (auto it = m_tenant_usage.begin(); it != m_tenant_usage.end();) {
+        if (active_tenants.count(it->first) == 0) {
+            it = m_tenant_usage.erase(it);
+        } else {
+            min_usage = std::min(min_usage, it->second);
+            ++it;
+        }
+    }
+    // a returning or new tenant starts on par with the least served active tenant
+    for (const auto& tenant_id : active_tenants) {
+        m_tenant_usage.emplace(tenant_id, min_usage == std::numeric_limits<double>::max() ? 0.0 : min_usage);
+    }
+
+    std::stable_sort(sequence_groups.begin(), sequence_groups.end(), [this](const SequenceGroup::Ptr& lhs, const SequenceGroup::Ptr& rhs) {
+        return m_tenant_usage.at(lhs->get_sampling_parameters().tenant_id) < m_tenant_usage.at(rhs->get_sampling_parameters().tenant_id);
+    });
+}
+
+void FairShareSchedulingPolicy::on_scheduled(const std::vector<SequenceGroup::Ptr>& sequence_groups, const std::vector<uint64_t>& scheduled_sequence_groups_ids) {
+    for (uint64_t sequence_group_id : scheduled_sequence_groups_ids) {
+        const SequenceGroup::Ptr& sequence_group = sequence_groups[sequence_group_id];
+        const std::string& tenant_id = sequence_group->get_sampling_parameters().tenant_id;
+        size_t num_scheduled_tokens = sequence_group->get_num_scheduled_tokens() * sequence_group->num_running_seqs();
+        m_tenant_usage[tenant_id] += num_scheduled_tokens / static_cast<double>(_get_weight(tenant_id));
+    }
+}
+
+std::shared_ptr<ISchedulingPolicy> create_scheduling_policy(const SchedulerConfig& config) {
+    switch (config.scheduling_policy) {
+    case SchedulingPolicy::FCFS:
+        return std::make_shared<FCFSSchedulingPolicy>();
+    case SchedulingPolicy::PRIORITY:
+        return std::make_shared<PrioritySchedulingPolicy>();
+    case SchedulingPolicy::EARLIEST_DEADLINE_FIRST:
+        return std::make_shared<DeadlineSchedulingPolicy>();
+    case SchedulingPolicy::FAIR_SHARE:
+        return std::make_shared<FairShareSchedulingPolicy>(config.tenant_weights);
+    default:
+        OPENVINO_THROW("Unsupported scheduling policy");
+    }
+}
+
+}
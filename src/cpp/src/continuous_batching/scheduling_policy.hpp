@@ -0,0 +1,119 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "openvino/genai/scheduler_config.hpp"
+#include "sequence_group.hpp"
+
+namespace ov::genai {
+
+/**
+ * @brief Defines the relative importance of the sequence groups processed by the Scheduler. The scheduler admits sequence
+ * groups to the batch in the order established by the policy and, when it runs out of KV cache blocks, preempts the
+ * sequence groups in the reverse order.
+ */
+class ISchedulingPolicy {
+public:
+    virtual ~ISchedulingPolicy() = default;
+
+    /**
+     * Reorders the sequence groups from the most to the least important one. Called at the beginning of each scheduling step.
+     * @param sequence_groups The sequence groups to be scheduled, in the order of arrival for the sequence groups that the
+     * policy treats as equally important.
+     */
+    virtual void order(std::vector<SequenceGroup::Ptr>& sequence_groups) = 0;
+
+    /**
+     * Informs the policy about the sequence groups scheduled at the current step. Called at the end of each scheduling step.
+     * @param sequence_groups The sequence groups passed to order().
+     * @param scheduled_sequence_groups_ids Indices of the scheduled sequence groups in sequence_groups.
+     */
+    virtual void on_scheduled(const std::vector<SequenceGroup::Ptr>& sequence_groups, const std::vector<uint64_t>& scheduled_sequence_groups_ids) {}
+};
+
+/**
+ * @brief Processes sequence groups in the order of arrival, which is the order the sequence groups are passed to the scheduler in.
+ */
+class FCFSSchedulingPolicy : public ISchedulingPolicy {
+public:
+    void order(std::vector<SequenceGroup::Ptr>& sequence_groups) override {}
+};
+
+/**
+ * @brief Processes sequence groups with a higher GenerationConfig::priority first, sequence groups of the same priority
+ * in the order of arrival.
+ */
+class PrioritySchedulingPolicy : public ISchedulingPolicy {
+public:
+    void order(std::vector<SequenceGroup::Ptr>& sequence_groups) override;
+};
+
+/**
+ * @brief Processes sequence groups in the order of the deadlines derived from their latency targets: a sequence group which
+ * has not produced the first token yet is due GenerationConfig::ttft_target_ms after its arrival, a generating sequence group
+ * is due GenerationConfig::tpot_target_ms after it last made progress. Sequence groups without a target go last in the order
+ * of arrival.
+ */
+class DeadlineSchedulingPolicy : public ISchedulingPolicy {
+    using Clock = std::chrono::steady_clock;
+
+    struct Progress {
+        size_t num_processed_tokens;
+        Clock::time_point time;
+    };
+    // the last observed progress of generating sequence groups, per request id
+    std::unordered_map<uint64_t, Progress> m_progress;
+
+public:
+    void order(std::vector<SequenceGroup::Ptr>& sequence_groups) override;
+
+    /**
+     * @param sequence_group The sequence group.
+     * @return The time by which the next token of the sequence group is due, Clock::time_point::max() if there is no target.
+     */
+    Clock::time_point get_deadline(const SequenceGroup::CPtr& sequence_group) const;
+};
+
+/**
+ * @brief Shares the batch between tenants (GenerationConfig::tenant_id) in proportion to their weights from
+ * SchedulerConfig::tenant_weights, so that a tenant with many long requests does not starve the others. Sequence groups
+ * of the tenant which has received the least amount of scheduled tokens relative to its weight go first, sequence groups
+ * of a tenant go in the order of arrival.
+ */
+class FairShareSchedulingPolicy : public ISchedulingPolicy {
+    std::map<std::string, float> m_tenant_weights;
+    // number of scheduled tokens divided by the tenant weight, per tenant with sequence groups in the scheduler
+    std::unordered_map<std::string, double> m_tenant_usage;
+
+    float _get_weight(const std::string& tenant_id) const;
+
+public:
+    explicit FairShareSchedulingPolicy(const std::map<std::string, float>& tenant_weights);
+
+    void order(std::vector<SequenceGroup::Ptr>& sequence_groups) override;
+
+    void on_scheduled(const std::vector<SequenceGroup::Ptr>& sequence_groups, const std::vector<uint64_t>& scheduled_sequence_groups_ids) override;
+
+    /**
+     * @param tenant_id The tenant id.
+     * @return The normalized amount of tokens scheduled for the tenant's sequence groups.
+     */
+    double get_usage(const std::string& tenant_id) const;
+};
+
+/**
+ * Creates the scheduling policy selected by SchedulerConfig::scheduling_policy.
+ * @param config The scheduler configuration.
+ * @return The scheduling policy.
+ */
+std::shared_ptr<ISchedulingPolicy> create_scheduling_policy(const SchedulerConfig& config);
+
+}
@@ -3,28 +3,33 @@
 
 #pragma once
 
-#include <thread>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <queue>
 
 #include "openvino/genai/llm_pipeline.hpp"
 #include "openvino/genai/text_streamer.hpp"
 #include "openvino/genai/tokenizer.hpp"
-#include "synchronized_queue.hpp"
+#include "threadpool.hpp"
 #include "utils.hpp"
 
 namespace ov {
 namespace genai {
 
+/**
+ * @brief Runs the streamer callbacks (including detokenization) asynchronously to the generation on the shared thread pool.
+ * Written tokens are queued and delivered in order by a single drain job, which is scheduled when the first token is written
+ * to an empty queue and finishes once the queue is empty, so no thread is kept busy while the generation produces no tokens.
+ */
 class ThreadedStreamerWrapper {
 public:
     ThreadedStreamerWrapper(const StreamerVariant& streamer, Tokenizer& tokenizer)
         : m_streamer_ptr{utils::create_streamer(streamer, tokenizer)} {}
 
-    void start() {
-        if (!m_streamer_ptr) {
-            return;
-        }
-
-        m_worker_thread = std::make_shared<std::thread>(&ThreadedStreamerWrapper::_worker, this);
+    ~ThreadedStreamerWrapper() {
+        // the generation can be interrupted by an exception before end() is called
+        _wait_for_drain();
     }
 
     void write(const std::vector<int64_t>& tokens) {
@@ -32,7 +37,7 @@ public:
             return;
         }
 
-        m_squeue.push(tokens);
+        _push(tokens);
     }
 
     void write(const int64_t token) {
@@ -40,7 +45,7 @@ public:
             return;
         }
 
-        m_squeue.push(token);
+        _push(token);
     }
 
     void end() {
@@ -48,11 +53,9 @@ public:
             return;
         }
 
-        // push stop token to unblock squeue.pull
-        m_squeue.push(std::monostate());
-
-        if (m_worker_thread && m_worker_thread->joinable()) {
-            m_worker_thread->join();
+        _wait_for_drain();
+        if (m_exception) {
+            std::rethrow_exception(m_exception);
         }
 
         m_streamer_ptr->end();
@@ -68,25 +71,58 @@ public:
 
 private:
     std::shared_ptr<StreamerBase> m_streamer_ptr = nullptr;
-    std::shared_ptr<std::thread> m_worker_thread = nullptr;
-    SynchronizedQueue<std::variant<int64_t, std::vector<int64_t>, std::monostate>> m_squeue;
+    std::queue<std::variant<int64_t, std::vector<int64_t>>> m_queue;
+    // whether the drain job is scheduled or running
+    bool m_drain_scheduled = false;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::exception_ptr m_exception;
 
     std::atomic<StreamingStatus> m_status = StreamingStatus::RUNNING;
 
-    void _worker() {
-        while (m_status == StreamingStatus::RUNNING) {
-            // wait for queue pull
-            std::variant<int64_t, std::vector<int64_t>, std::monostate> token_variant = m_squeue.pull();
+    void _push(std::variant<int64_t, std::vector<int64_t>> token_variant) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queue.push(std::move(token_variant));
+            if (m_drain_scheduled) {
+                return;
+            }
+            m_drain_scheduled = true;
+        }
+        ThreadPool::get_shared().submit({&ThreadedStreamerWrapper::_drain, this});
+    }
+
+    void _wait_for_drain() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this] { return !m_drain_scheduled; });
+    }
+
+    static void _drain(void* context) {
+        auto* self = static_cast<ThreadedStreamerWrapper*>(context);
+        while (true) {
+            std::variant<int64_t, std::vector<int64_t>> token_variant;
+            {
+                std::lock_guard<std::mutex> lock(self->m_mutex);
+                if (self->m_queue.empty() || self->m_status != StreamingStatus::RUNNING || self->m_exception) {
+                    self->m_drain_scheduled = false;
+                    self->m_cv.notify_all();
+                    return;
+                }
+                token_variant = std::move(self->m_queue.front());
+                self->m_queue.pop();
+            }
 
             // wait for streamer_ptr result
-            if (auto token = std::get_if<int64_t>(&token_variant)) {
-                m_status = _get_streaming_status(m_streamer_ptr->write(*token));
-            } else if (auto tokens = std::get_if<std::vector<int64_t>>(&token_variant)) {
-                m_status = _get_streaming_status(m_streamer_ptr->write(*tokens));
-            } else if (auto stop_token = std::get_if<std::monostate>(&token_variant)) {
-                break;
-            } else {
-                OPENVINO_THROW("Internal error: unsupported threaded streamer value");
+            try {
+                if (auto token = std::get_if<int64_t>(&token_variant)) {
+                    self->m_status = self->_get_streaming_status(self->m_streamer_ptr->write(*token));
+                } else {
+                    self->m_status = self->_get_streaming_status(self->m_streamer_ptr->write(std::get<std::vector<int64_t>>(token_variant)));
+                }
+            } catch (...) {
+                // rethrown by end(), the remaining tokens are not streamed
+                std::lock_guard<std::mutex> lock(self->m_mutex);
+                self->m_exception = std::current_exception();
             }
         }
     }
@@ -150,10 +150,18 @@ void GenerationConfig::update_generation_config(const ov::AnyMap& properties) {
     read_anymap_param(properties, "assistant_confidence_threshold", assistant_confidence_threshold);
     read_anymap_param(properties, "num_assistant_tokens", num_assistant_tokens);
     read_anymap_param(properties, "max_ngram_size", max_ngram_size);
+    read_anymap_param(properties, "adaptive_num_assistant_tokens", adaptive_num_assistant_tokens);
+    read_anymap_param(properties, "prompt_lookup_corpus", prompt_lookup_corpus);
 
     // Structured output
     read_anymap_param(properties, "structured_output_config", structured_output_config);
     read_anymap_param(properties, "parsers", parsers);
+
+    // scheduling
+    read_anymap_param(properties, "priority", priority);
+    read_anymap_param(properties, "ttft_target_ms", ttft_target_ms);
+    read_anymap_param(properties, "tpot_target_ms", tpot_target_ms);
+    read_anymap_param(properties, "tenant_id", tenant_id);
 }
 
 
@@ -356,6 +364,10 @@ void GenerationConfig::validate() const {
         OPENVINO_ASSERT(max_ngram_size == 0, "'max_ngram_size' should be set to default value 0 when prompt lookup is disabled");
     }
 
+    if (!is_prompt_lookup()) {
+        OPENVINO_ASSERT(prompt_lookup_corpus.empty(), "'prompt_lookup_corpus' should be empty when prompt lookup is disabled");
+    }
+
     if(is_structured_output_generation()) {
         (*structured_output_config).validate();
     }
@@ -6,13 +6,14 @@
 #include <atomic>
 #include "openvino/genai/continuous_batching_pipeline.hpp"
 #include "openvino/genai/generation_handle.hpp"
-#include "synchronized_queue.hpp"
+#include "lock_free_queue.hpp"
 
 namespace ov::genai {
 class GenerationStream {
     std::mutex m_mutex;
     GenerationStatus m_status = GenerationStatus::RUNNING;
-    SynchronizedQueue<GenerationOutputs> m_output_queue;
+    // written by the pipeline once per step and read by the handle owner, so no locking is needed while outputs are available
+    SPSCQueue<GenerationOutputs> m_output_queue;
 
 public:
     using Ptr = std::shared_ptr<GenerationStream>;
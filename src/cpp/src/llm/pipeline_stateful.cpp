@@ -160,7 +160,7 @@ DecodedResults StatefulLLMPipeline::generate(
             m_history.push_back({{"role", "user"}, {"content", (*input_vector)[0]}});
             constexpr bool add_generation_prompt = true;
             auto new_templated_chat_history = m_tokenizer.apply_chat_template(m_history, add_generation_prompt);
-            auto new_chat_tokens = m_tokenizer.encode(new_templated_chat_history, ov::genai::add_special_tokens(false));
+            auto new_chat_tokens = m_chat_tokenizer.encode(new_templated_chat_history);
 
             if (m_use_full_chat_history) {
                 encoded_input = new_chat_tokens;
@@ -188,7 +188,7 @@ DecodedResults StatefulLLMPipeline::generate(
             constexpr bool add_generation_prompt = true;
             auto new_templated_chat_history = m_tokenizer.apply_chat_template(m_history, add_generation_prompt);
             // Do not add special tokens in chat scenario to be aligned with HF.
-            auto new_chat_tokens = m_tokenizer.encode(new_templated_chat_history, ov::genai::add_special_tokens(false));
+            auto new_chat_tokens = m_chat_tokenizer.encode(new_templated_chat_history);
 
             if (m_use_full_chat_history) {
                 encoded_input = new_chat_tokens;
@@ -252,7 +252,7 @@ DecodedResults StatefulLLMPipeline::generate(
 
     constexpr bool add_generation_prompt = true;
     auto new_templated_chat_history = m_tokenizer.apply_chat_template(m_history, add_generation_prompt);
-    auto new_chat_tokens = m_tokenizer.encode(new_templated_chat_history, ov::genai::add_special_tokens(false));
+    auto new_chat_tokens = m_chat_tokenizer.encode(new_templated_chat_history);
 
     TokenizedInputs encoded_input;
     if (m_use_full_chat_history) {
@@ -493,6 +493,7 @@ void StatefulLLMPipeline::finish_chat() {
         m_model_runner.get_tensor("attention_mask").set_shape({1, 0});
         m_history.clear();
         m_tokenized_chat_history.clear();
+        m_chat_tokenizer.reset();
         m_kv_cache_state.reset_state();
     }
 }
@@ -0,0 +1,180 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+/**
+ * @brief Unbounded multi-producer single-consumer queue. push() may be called from any number of threads and never
+ * blocks (a single atomic exchange), while try_pop() must only be called from one consumer thread at a time.
+ * An element pushed by a producer which is preempted between the exchange and linking the node becomes visible to the
+ * consumer (together with the elements pushed after it) once the producer resumes.
+ */
+template <typename T>
+class MPSCQueue {
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        std::optional<T> value;
+    };
+
+    // the most recently pushed node, shared by producers
+    alignas(64) std::atomic<Node*> m_head;
+    alignas(64) std::atomic<size_t> m_size{0};
+    // the last consumed node, its successor holds the front element
+    alignas(64) Node* m_tail;
+
+public:
+    MPSCQueue() {
+        Node* stub = new Node();
+        m_head.store(stub, std::memory_order_relaxed);
+        m_tail = stub;
+    }
+
+    ~MPSCQueue() {
+        while (m_tail != nullptr) {
+            Node* next = m_tail->next.load(std::memory_order_relaxed);
+            delete m_tail;
+            m_tail = next;
+        }
+    }
+
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    void push(T item) {
+        Node* node = new Node();
+        node->value.emplace(std::move(item));
+        // counted before being linked, so that the size never falls behind the number of elements visible to the consumer
+        m_size.fetch_add(1, std::memory_order_relaxed);
+        Node* prev = m_head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    /**
+     * Consumer side only.
+     * @param item Receives the front element if the queue is not empty.
+     * @return Whether an element was popped.
+     */
+    bool try_pop(T& item) {
+        Node* next = m_tail->next.load(std::memory_order_acquire);
+        if (next == nullptr) {
+            return false;
+        }
+        item = std::move(*next->value);
+        next->value.reset();
+        delete m_tail;
+        m_tail = next;
+        m_size.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * May be called from any thread, the result is a snapshot which can be outdated by the time it is used.
+     */
+    bool empty() const {
+        return m_size.load(std::memory_order_relaxed) == 0;
+    }
+};
+
+/**
+ * @brief Unbounded single-producer single-consumer queue with a blocking pull(). Neither side takes a lock while the
+ * queue is not empty; a mutex is only used to put the consumer to sleep when there is nothing to read.
+ * Pushes from different threads are allowed as long as they are ordered (e.g. by joining a task before submitting the
+ * next one), the same holds for reads.
+ */
+template <typename T>
+class SPSCQueue {
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        std::optional<T> value;
+    };
+
+    // producer side
+    alignas(64) Node* m_head;
+    // consumer side
+    alignas(64) Node* m_tail;
+    std::atomic<bool> m_consumer_waiting{false};
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+
+    // number of unsuccessful attempts to read before the consumer goes to sleep
+    static constexpr size_t SPIN_COUNT = 64;
+
+    Node* _front() const {
+        return m_tail->next.load(std::memory_order_acquire);
+    }
+
+public:
+    SPSCQueue() {
+        m_head = m_tail = new Node();
+    }
+
+    ~SPSCQueue() {
+        while (m_tail != nullptr) {
+            Node* next = m_tail->next.load(std::memory_order_relaxed);
+            delete m_tail;
+            m_tail = next;
+        }
+    }
+
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    void push(T item) {
+        Node* node = new Node();
+        node->value.emplace(std::move(item));
+        m_head->next.store(node, std::memory_order_release);
+        m_head = node;
+        // pairs with the fence in pull(): either the consumer sees the new element or the producer sees the consumer sleeping
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_consumer_waiting.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_cv.notify_one();
+        }
+    }
+
+    bool try_pop(T& item) {
+        Node* next = _front();
+        if (next == nullptr) {
+            return false;
+        }
+        item = std::move(*next->value);
+        next->value.reset();
+        delete m_tail;
+        m_tail = next;
+        return true;
+    }
+
+    /**
+     * Waits for an element and pops it.
+     */
+    T pull() {
+        T item;
+        for (size_t spin = 0; spin < SPIN_COUNT; ++spin) {
+            if (try_pop(item)) {
+                return item;
+            }
+            std::this_thread::yield();
+        }
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_consumer_waiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        m_cv.wait(lock, [this] { return _front() != nullptr; });
+        m_consumer_waiting.store(false, std::memory_order_relaxed);
+        lock.unlock();
+        try_pop(item);
+        return item;
+    }
+
+    /**
+     * Consumer side only.
+     */
+    bool empty() const {
+        return _front() == nullptr;
+    }
+};
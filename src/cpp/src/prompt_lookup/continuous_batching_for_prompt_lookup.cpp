@@ -11,69 +11,70 @@ ContinuousBatchingPipeline::ContinuousBatchingForPromptLookupImpl::get_generated
     for (const auto& request : m_requests) {
         const auto request_id = request->get_request_id();
         auto validation_len = request->get_num_tokens_to_validate();
-        auto generated_len = request->get_num_processed_tokens() - request->get_prompt_len() + 1;
+        // 0 until the prompt is processed
+        auto generated_len = request->get_num_processed_tokens() >= request->get_prompt_len() ?
+                             request->get_num_processed_tokens() - request->get_prompt_len() + 1 : 0;
         result.insert({ request_id, { generated_len, validation_len } });
     }
     return result;
 }
 
-TokenIds ContinuousBatchingPipeline::ContinuousBatchingForPromptLookupImpl::generate_candidates(const TokenIds& input_ids, size_t num_pred_tokens, size_t max_ngram_size) {
-    if (num_pred_tokens == 0) {
-        return std::vector<int64_t>{};
+void ContinuousBatchingPipeline::ContinuousBatchingForPromptLookupImpl::_update_ngram_index(NgramIndex& ngram_index,
+                                                                                          const TokenIds& prompt_ids,
+                                                                                          const TokenIds& generated_ids) {
+    const size_t prompt_len = prompt_ids.size(), sequence_len = prompt_len + generated_ids.size();
+    auto get_token_id = [&](size_t position) {
+        return position < prompt_len ? prompt_ids[position] : generated_ids[position - prompt_len];
+    };
+    // the rejected candidates are removed from the sequence, the validated tokens are not changed
+    ngram_index.truncate(sequence_len);
+    const size_t indexed_len = ngram_index.size();
+    if (indexed_len > 0 && ngram_index.get_token_ids().back() != get_token_id(indexed_len - 1)) {
+        ngram_index = NgramIndex(ngram_index.get_max_ngram_size());
     }
-
-    const size_t input_length = input_ids.size();
-
-    for (int32_t ngram_size = max_ngram_size; ngram_size > 0; ngram_size--) {
-        // extract last ngram_size tokens as search ngram
-        std::vector<int64_t> ngram = std::vector<int64_t>{input_ids.cend() - ngram_size, input_ids.cend()};
-
-        // find ngram match in input_ids
-        size_t ngram_i = 0;
-        for (size_t input_i = 0; input_i < input_length - ngram_size; input_i++) {
-            if (ngram[ngram_i] != input_ids[input_i]) {
-                ngram_i = 0;
-                continue;
-            }
-
-            ngram_i++;
-
-            if (ngram_i < ngram_size) {
-                continue;
-            }
-
-            // match found with the end at input_i
-            size_t avaliable_num_pred = std::min(input_length - (input_i + 1), num_pred_tokens);
-
-            // return candidates with length of avaliable_num_pred
-            return std::vector<int64_t>{input_ids.cbegin() + input_i + 1,
-                                        input_ids.cbegin() + input_i + 1 + avaliable_num_pred};
-        }
+    for (size_t position = ngram_index.size(); position < sequence_len; ++position) {
+        ngram_index.append(get_token_id(position));
     }
-
-    return std::vector<int64_t>{};
 }
 
 void ContinuousBatchingPipeline::ContinuousBatchingForPromptLookupImpl::generate_candidates() {
+    // the indices of the finished sequences and requests are dropped
+    std::map<uint64_t, NgramIndex> ngram_indices, ngram_corpora;
     for (auto& request : m_requests) {
-        const auto prompt = request->get_prompt_ids();
+        const auto& prompt = request->get_prompt_ids();
+        const auto& sampling_params = request->get_sampling_parameters();
+        // the corpus is indexed once per request and shared by its sequences
+        const NgramIndex* ngram_corpus = nullptr;
+        if (!sampling_params.prompt_lookup_corpus.empty()) {
+            auto ngram_corpus_node = m_ngram_corpora.extract(request->get_request_id());
+            if (ngram_corpus_node.empty()) {
+                NgramIndex corpus(sampling_params.max_ngram_size);
+                corpus.append(sampling_params.prompt_lookup_corpus);
+                ngram_corpus = &ngram_corpora.emplace(request->get_request_id(), std::move(corpus)).first->second;
+            } else {
+                ngram_corpus = &ngram_corpora.insert(std::move(ngram_corpus_node)).position->second;
+            }
+        }
         size_t max_validation_len = 0;
         for (auto& running_sequence : request->get_running_sequences()) {
-            const auto generated_tokens = running_sequence->get_generated_ids();
+            const auto& generated_tokens = running_sequence->get_generated_ids();
             if (generated_tokens.empty()) {
                 continue;
             }
-            TokenIds full_input_ids = prompt;
-            full_input_ids.insert(full_input_ids.end(), generated_tokens.begin(), generated_tokens.end());
+            auto ngram_index_it = m_ngram_indices.find(running_sequence->get_id());
+            NgramIndex ngram_index = ngram_index_it != m_ngram_indices.end() ? std::move(ngram_index_it->second) :
+                                                                               NgramIndex(sampling_params.max_ngram_size);
+            _update_ngram_index(ngram_index, prompt, generated_tokens);
 
             size_t min_num_assistant_tokens = 0;
-            const auto sampling_params = request->get_sampling_parameters();
             {
                 const auto generated_len = running_sequence->get_generated_len();
                 const auto left_generated_len = request->get_max_new_tokens() - generated_len - 1;
-                min_num_assistant_tokens = std::min(sampling_params.num_assistant_tokens, left_generated_len);
+                const size_t num_assistant_tokens = speculation_length_controller.get_num_assistant_tokens(request->get_request_id(), sampling_params);
+                min_num_assistant_tokens = std::min(num_assistant_tokens, left_generated_len);
             }
-            TokenIds candidates = generate_candidates(full_input_ids, min_num_assistant_tokens, sampling_params.max_ngram_size);
+            TokenIds candidates = ngram_index.get_candidates(min_num_assistant_tokens, ngram_corpus);
+            ngram_indices.emplace(running_sequence->get_id(), std::move(ngram_index));
 
             if (!candidates.empty()) {
                 for (const auto& candidate : candidates) {
@@ -84,6 +85,8 @@ void ContinuousBatchingPipeline::ContinuousBatchingForPromptLookupImpl::generate
         }
         request->set_num_validated_tokens(max_validation_len);
     }
+    m_ngram_indices = std::move(ngram_indices);
+    m_ngram_corpora = std::move(ngram_corpora);
 }
 
 bool ContinuousBatchingPipeline::ContinuousBatchingForPromptLookupImpl::is_requests_empty() {
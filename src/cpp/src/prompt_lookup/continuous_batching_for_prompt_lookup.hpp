@@ -6,6 +6,8 @@
 #include "openvino/genai/continuous_batching_pipeline.hpp"
 
 #include "continuous_batching/pipeline_impl.hpp"
+#include "prompt_lookup/ngram_index.hpp"
+#include "speculative_decoding/speculation_length_controller.hpp"
 
 namespace ov::genai {
 class ContinuousBatchingPipeline::ContinuousBatchingForPromptLookupImpl : public ContinuousBatchingPipeline::ContinuousBatchingImpl {
@@ -39,7 +41,16 @@ public:
     size_t get_processed_tokens_per_iteration();
 
     using ContinuousBatchingPipeline::ContinuousBatchingImpl::drop_requests;
+
+    // number of candidates generated for the requests with the adaptive number of candidates
+    SpeculationLengthController speculation_length_controller;
 protected:
-    TokenIds generate_candidates(const TokenIds& input_ids, size_t num_pred_tokens, size_t max_ngram_size);
+    // synchronizes the index with the prompt and the generated tokens of the sequence
+    static void _update_ngram_index(NgramIndex& ngram_index, const TokenIds& prompt_ids, const TokenIds& generated_ids);
+
+    // { sequence_id : index of the prompt and the generated tokens }
+    std::map<uint64_t, NgramIndex> m_ngram_indices;
+    // { request_id : index of GenerationConfig::prompt_lookup_corpus }
+    std::map<uint64_t, NgramIndex> m_ngram_corpora;
 };
 }
@@ -0,0 +1,90 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+
+#include "openvino/core/except.hpp"
+#include "prompt_lookup/ngram_index.hpp"
+
+namespace ov::genai {
+
+NgramIndex::NgramIndex(size_t max_ngram_size) : m_max_ngram_size(max_ngram_size) {
+    OPENVINO_ASSERT(max_ngram_size > 0, "max_ngram_size should be greater than 0");
+}
+
+uint64_t NgramIndex::_extend_hash(uint64_t hash, int64_t token_id) {
+    // token ids are shifted by one, so that the n-grams of different sizes have different hashes
+    return hash * 0x9E3779B97F4A7C15ULL + static_cast<uint64_t>(token_id) + 1;
+}
+
+void NgramIndex::append(int64_t token_id) {
+    m_token_ids.push_back(token_id);
+    const size_t end = m_token_ids.size() - 1;
+    const size_t max_ngram_size = std::min(m_max_ngram_size, m_token_ids.size());
+    uint64_t hash = 0;
+    for (size_t ngram_size = 1; ngram_size <= max_ngram_size; ++ngram_size) {
+        hash = _extend_hash(hash, m_token_ids[end + 1 - ngram_size]);
+        if (m_ngram_ends.emplace(hash, end).second) {
+            m_insertions.emplace_back(end, hash);
+        }
+    }
+}
+
+void NgramIndex::append(const TokenIds& token_ids) {
+    m_token_ids.reserve(m_token_ids.size() + token_ids.size());
+    for (const auto token_id : token_ids) {
+        append(token_id);
+    }
+}
+
+void NgramIndex::truncate(size_t size) {
+    if (size >= m_token_ids.size()) {
+        return;
+    }
+    while (!m_insertions.empty() && m_insertions.back().first >= size) {
+        m_ngram_ends.erase(m_insertions.back().second);
+        m_insertions.pop_back();
+    }
+    m_token_ids.resize(size);
+}
+
+TokenIds NgramIndex::get_continuation(const int64_t* ngram, size_t ngram_size, size_t max_num_tokens) const {
+    if (ngram_size == 0 || ngram_size > m_max_ngram_size || max_num_tokens == 0) {
+        return {};
+    }
+    uint64_t hash = 0;
+    for (size_t i = ngram_size; i > 0; --i) {
+        hash = _extend_hash(hash, ngram[i - 1]);
+    }
+    auto it = m_ngram_ends.find(hash);
+    if (it == m_ngram_ends.end()) {
+        return {};
+    }
+    const size_t end = it->second;
+    // the n-gram hashed to the same value is not necessarily the requested one
+    if (!std::equal(ngram, ngram + ngram_size, m_token_ids.begin() + (end + 1 - ngram_size))) {
+        return {};
+    }
+    const size_t num_tokens = std::min(max_num_tokens, m_token_ids.size() - end - 1);
+    return TokenIds(m_token_ids.begin() + end + 1, m_token_ids.begin() + end + 1 + num_tokens);
+}
+
+TokenIds NgramIndex::get_candidates(size_t max_num_tokens, const NgramIndex* corpus) const {
+    if (max_num_tokens == 0) {
+        return {};
+    }
+    for (size_t ngram_size = std::min(m_max_ngram_size, m_token_ids.size()); ngram_size > 0; --ngram_size) {
+        const int64_t* ngram = m_token_ids.data() + m_token_ids.size() - ngram_size;
+        // the earliest occurrence of the suffix is the suffix itself if it does not occur earlier, which has no continuation
+        TokenIds candidates = get_continuation(ngram, ngram_size, max_num_tokens);
+        if (candidates.empty() && corpus != nullptr) {
+            candidates = corpus->get_continuation(ngram, ngram_size, max_num_tokens);
+        }
+        if (!candidates.empty()) {
+            return candidates;
+        }
+    }
+    return {};
+}
+
+}  // namespace ov::genai
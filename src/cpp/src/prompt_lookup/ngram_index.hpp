@@ -0,0 +1,77 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ov::genai {
+
+using TokenIds = std::vector<int64_t>;
+
+/**
+ * @brief Index of the n-grams of a token sequence for prompt lookup decoding.
+ * The earliest occurrence of each n-gram of up to max_ngram_size tokens is stored in a hash map keyed by the hash of the
+ * n-gram, so appending a token costs O(max_ngram_size) and finding the continuation of an n-gram costs O(n) regardless of the
+ * length of the sequence. The sequence can be truncated, which drops the n-grams ending in the removed tokens.
+ * The index of a token sequence is also usable as a corpus, e.g. for GenerationConfig::prompt_lookup_corpus.
+ */
+class NgramIndex {
+public:
+    explicit NgramIndex(size_t max_ngram_size);
+
+    void append(int64_t token_id);
+
+    void append(const TokenIds& token_ids);
+
+    /**
+     * Removes the tokens after the first `size` ones.
+     */
+    void truncate(size_t size);
+
+    size_t size() const {
+        return m_token_ids.size();
+    }
+
+    size_t get_max_ngram_size() const {
+        return m_max_ngram_size;
+    }
+
+    const TokenIds& get_token_ids() const {
+        return m_token_ids;
+    }
+
+    /**
+     * @param ngram The first token of the n-gram.
+     * @param ngram_size The number of tokens in the n-gram, up to max_ngram_size.
+     * @param max_num_tokens The maximum number of returned tokens.
+     * @return The tokens following the earliest occurrence of the n-gram, empty if the n-gram is not found or its earliest
+     * occurrence ends the sequence.
+     */
+    TokenIds get_continuation(const int64_t* ngram, size_t ngram_size, size_t max_num_tokens) const;
+
+    /**
+     * Finds the longest suffix of the indexed sequence which also occurs earlier in the sequence or in the corpus,
+     * trying the n-grams from max_ngram_size tokens down to a single token.
+     * @return The tokens following the earliest occurrence of the suffix, preferring the sequence to the corpus.
+     */
+    TokenIds get_candidates(size_t max_num_tokens, const NgramIndex* corpus = nullptr) const;
+
+private:
+    // the hash of an n-gram is computed from its last token to the first one, so the hashes of all the n-grams ending
+    // at the same position are computed in a single pass
+    static uint64_t _extend_hash(uint64_t hash, int64_t token_id);
+
+    size_t m_max_ngram_size;
+    TokenIds m_token_ids;
+    // { ngram hash : position of the last token of the earliest occurrence }
+    std::unordered_map<uint64_t, size_t> m_ngram_ends;
+    // { position of the last token, ngram hash } for each occurrence stored in m_ngram_ends, in the order of insertion
+    std::vector<std::pair<size_t, uint64_t>> m_insertions;
+};
+
+}  // namespace ov::genai
@@ -54,9 +54,17 @@ void ContinuousBatchingPipeline::PromptLookupImpl::step() {
     m_pipeline_metrics = m_pipeline->get_metrics();
     auto generated_len_after = m_pipeline->get_generated_request_len();
 
+    auto& speculation_length_controller = m_pipeline->speculation_length_controller;
+    bool is_prompt_processed = false;
+    size_t num_validated_tokens = 0;
     for (const auto request : generated_len_before) {
         auto request_id = request.first;
         auto prev_validation_len = request.second.second;
+        is_prompt_processed |= request.second.first == 0;
+        num_validated_tokens += prev_validation_len + 1;
+        if (!generated_len_after.count(request_id)) {
+            speculation_length_controller.remove_request(request_id);
+        }
         if (prev_validation_len == 0) {
             continue;
         }
@@ -68,10 +76,15 @@ void ContinuousBatchingPipeline::PromptLookupImpl::step() {
 
             num_matches = (present_req_len - prev_full_req_len - 1);
             acceptance_rate = static_cast<float>(num_matches) / static_cast<float>(prev_validation_len);
+            speculation_length_controller.register_validation(request_id, prev_validation_len, num_matches);
         }        
         m_sd_metrics.update_acceptance_rate(request_id, acceptance_rate * 100);
         m_sd_metrics.update_draft_accepted_tokens(request_id, num_matches);
     }
+    // the steps processing prompts do not follow the duration model of validation, candidates are looked up on the host
+    if (!is_prompt_processed && !generated_len_before.empty()) {
+        speculation_length_controller.register_main_step(generated_len_before.size(), num_validated_tokens, main_timer.get_duration_microsec() / 1000.0f);
+    }
 
     // update perf metrics
     const auto num_generated_tokens = m_pipeline->get_processed_tokens_per_iteration();
@@ -128,8 +141,6 @@ ContinuousBatchingPipeline::PromptLookupImpl::generate(const std::vector<ov::Ten
 
     auto& generation = generations.at(0);
 
-    streamer_ptr->start();
-
     while (has_non_finished_requests()) {
         try {
             step();
@@ -199,5 +210,6 @@ ContinuousBatchingPipeline::PromptLookupImpl::get_metrics() {
 
 void ContinuousBatchingPipeline::PromptLookupImpl::drop_requests() {
     m_pipeline->drop_requests();
+    m_pipeline->speculation_length_controller.remove_requests();
 }
 }
@@ -47,26 +47,16 @@ public:
         }
 
         if (sampling_params.is_multinomial() || sampling_params.is_greedy_decoding()) {
-            if (sampling_params.repetition_penalty != 1.0f) {
-                std::shared_ptr<LogitTransformers::RepetitionPenaltyTransform> transformer =
-                    std::shared_ptr<LogitTransformers::RepetitionPenaltyTransform>(new LogitTransformers::RepetitionPenaltyTransform(sampling_params.repetition_penalty));
+            if (sampling_params.repetition_penalty != 1.0f || sampling_params.presence_penalty != 0.0f || sampling_params.frequency_penalty != 0.0f) {
+                // all penalties are applied at once to visit the penalized tokens once per step
+                std::shared_ptr<LogitTransformers::CombinedPenaltyTransform> transformer =
+                    std::make_shared<LogitTransformers::CombinedPenaltyTransform>(sampling_params.repetition_penalty,
+                                                                                 sampling_params.presence_penalty,
+                                                                                 sampling_params.frequency_penalty);
                 transformer->set_unique_prompt_token_ids(m_unique_prompt_token_ids);
                 transformer->set_unique_generated_token_ids(m_unique_generated_token_ids);
                 m_logit_transformers.push_back(transformer);
             }
-            if (sampling_params.presence_penalty != 0.0f) {
-                std::shared_ptr<LogitTransformers::PresencePenaltyTransform> transformer = 
-                    std::shared_ptr<LogitTransformers::PresencePenaltyTransform>(new LogitTransformers::PresencePenaltyTransform(sampling_params.presence_penalty)); 
-                transformer->set_unique_generated_token_ids(m_unique_generated_token_ids);
-                m_logit_transformers.push_back(transformer);
-                
-            }
-            if (sampling_params.frequency_penalty != 0.0f) {
-                std::shared_ptr<LogitTransformers::FrequencyPenaltyTransform> transformer = 
-                    std::shared_ptr<LogitTransformers::FrequencyPenaltyTransform>(new LogitTransformers::FrequencyPenaltyTransform(sampling_params.frequency_penalty));
-                transformer->set_unique_generated_token_ids(m_unique_generated_token_ids);
-                m_logit_transformers.push_back(transformer);
-            }
 
             if (sampling_params.is_multinomial()) {
                 m_logit_transformers.emplace_back(new LogitTransformers::TemperatureLogitTransform(sampling_params.temperature));
@@ -5,6 +5,9 @@
 
 #include <algorithm>
 #include <cmath>
+#include <functional>
+#include <limits>
+#include <vector>
 
 #include "openvino/genai/generation_config.hpp"
 
@@ -21,17 +24,80 @@ struct Token {
 struct Logits {
     float * m_data = nullptr;
     size_t m_size;
-    // Late initialized for top_p or top_k transforms
+    // Late initialized for top_p or top_k transforms, holds the selected tokens sorted by descending value
     std::vector<Token> m_vector;
 
     Logits(float* data, size_t size): m_data(data), m_size(size) {}
 
+    /**
+     * Initializes the vector with the top_k largest values sorted in descending order.
+     * The whole vocabulary is not materialized: a threshold which is likely to be slightly below the k-th largest value is
+     * estimated on an evenly strided sample, and only the values above it are collected and sorted.
+     */
+    void initialize_top_k_vector(size_t top_k) {
+        OPENVINO_ASSERT(m_vector.size() == 0, "Logits vector already initialized");
+        OPENVINO_ASSERT(top_k > 0 && top_k <= m_size);
+        std::vector<float>& sample = _get_sample_buffer();
+        const size_t stride = (m_size + MAX_SAMPLE_SIZE - 1) / MAX_SAMPLE_SIZE;
+        sample.clear();
+        for (size_t i = 0; i < m_size; i += stride)
+            sample.push_back(m_data[i]);
+        // the expected rank of the k-th value in the sample with a margin for the sampling error
+        const size_t rank = stride == 1 ? top_k : std::min(sample.size(), top_k / stride * 3 / 2 + 16);
+        std::nth_element(sample.begin(), sample.begin() + (rank - 1), sample.end(), std::greater<float>());
+        float threshold = sample[rank - 1];
+
+        m_vector.reserve(top_k);
+        _collect_not_less(threshold);
+        if (m_vector.size() < top_k) {
+            // the sample has overestimated the threshold
+            m_vector.clear();
+            _collect_not_less(-std::numeric_limits<float>::infinity());
+        }
+        std::nth_element(m_vector.begin(), m_vector.begin() + (top_k - 1), m_vector.end(), is_greater);
+        m_vector.resize(top_k);
+        std::sort(m_vector.begin(), m_vector.end(), is_greater);
+        m_size = m_vector.size();
+    }
 
-    void initialize_vector() {
+    /**
+     * Initializes the vector with the smallest set of the largest probabilities whose sum exceeds top_p (or with all of them
+     * if the sum is never exceeded), sorted in descending order.
+     * Since most of the time huge part of the vocabulary has minimal probabilities, the nucleus is first looked for among
+     * the top 64, 256 and 1024 values. Otherwise only the probabilities above (sum - top_p) / (2 * vocab_size) are sorted:
+     * the rest of the vocabulary sums up to less than sum - top_p, so the nucleus is among them.
+     */
+    void initialize_top_p_vector(double top_p) {
         OPENVINO_ASSERT(m_vector.size() == 0, "Logits vector already initialized");
+        const size_t vocab_size = m_size;
+        for (size_t top_k = 64; top_k <= 1024 && top_k < vocab_size; top_k *= 4) {
+            initialize_top_k_vector(top_k);
+            if (_resize_to_nucleus(top_p))
+                return;
+            m_vector.clear();
+            m_size = vocab_size;
+        }
+
+        double probability_sum = 0.0;
+        for (size_t i = 0; i < m_size; i++)
+            probability_sum += m_data[i];
+        const float threshold = (probability_sum - top_p) / (2 * m_size);
+        if (threshold > 0.0f) {
+            for (size_t i = 0; i < m_size; i++) {
+                if (m_data[i] > threshold)
+                    m_vector.emplace_back(m_data[i], i);
+            }
+            std::sort(m_vector.begin(), m_vector.end(), is_greater);
+            if (_resize_to_nucleus(top_p))
+                return;
+            m_vector.clear();
+        }
+
         m_vector.reserve(m_size);
         for (size_t i = 0; i < m_size; i++)
             m_vector.emplace_back(m_data[i], i);
+        std::sort(m_vector.begin(), m_vector.end(), is_greater);
+        _resize_to_nucleus(top_p);
     }
 
     bool is_vector_initialized() const {
@@ -42,6 +108,54 @@ struct Logits {
         m_size = new_size;
         m_vector.resize(new_size);
     }
+
+    // descending order of values, ties are broken by token index to keep the selection deterministic
+    static bool is_greater(const Token& lhs, const Token& rhs) {
+        return lhs.m_log_prob > rhs.m_log_prob || (lhs.m_log_prob == rhs.m_log_prob && lhs.m_index < rhs.m_index);
+    }
+
+private:
+    // the maximum number of values used to estimate the threshold of the top k values
+    static constexpr size_t MAX_SAMPLE_SIZE = 8192;
+
+    // per-thread buffer for the sample, so that it is not allocated per sequence and step
+    static std::vector<float>& _get_sample_buffer() {
+        thread_local std::vector<float> sample;
+        return sample;
+    }
+
+    void _collect_not_less(float threshold) {
+        constexpr size_t BLOCK_SIZE = 16;
+        size_t i = 0;
+        for (; i + BLOCK_SIZE <= m_size; i += BLOCK_SIZE) {
+            // branch-free check of the whole block, which the compiler turns into SIMD comparisons
+            int has_candidates = 0;
+            for (size_t j = 0; j < BLOCK_SIZE; j++)
+                has_candidates |= m_data[i + j] >= threshold;
+            if (!has_candidates)
+                continue;
+            for (size_t j = i; j < i + BLOCK_SIZE; j++) {
+                if (m_data[j] >= threshold)
+                    m_vector.emplace_back(m_data[j], j);
+            }
+        }
+        for (; i < m_size; i++) {
+            if (m_data[i] >= threshold)
+                m_vector.emplace_back(m_data[i], i);
+        }
+    }
+
+    bool _resize_to_nucleus(double top_p) {
+        float probability_sum = 0.0f;
+        for (size_t i = 0; i < m_vector.size(); i++) {
+            probability_sum += m_vector[i].m_log_prob;
+            if (probability_sum > top_p) {
+                resize(i + 1);
+                return true;
+            }
+        }
+        return false;
+    }
 };
 
 namespace LogitTransformers {
@@ -73,46 +187,8 @@ class TopPFilter : public ILogitTransformer {
 public:
     TopPFilter(double top_p) : m_top_p(top_p) {}
 
-    bool partial_sort_and_resize(Logits& logits) {
-        // Since most of the time huge part of logits vector contains minimal values
-        // expensive sorting of entire vector might be unnecessary, especially for low values of top_p.
-        // This method partially sorts vector finding M top elements and stops when top_p condition is met.
-        // It iterates a few times starting with M = 16 and multiplying it by 2 each iteration until M = 1024.
-        // If top_p is found in considered scope it resizes logits vector and returns true. Otherwise it returns false.
-        // Note that it can we less performant than standard approach if logits value are more evenly distributed across the vector.
-        for (size_t step = 16; step <= 1024; step *= 2) {
-            if (logits.m_vector.size() <= step)
-                break;
-            std::partial_sort(logits.m_vector.begin(), logits.m_vector.begin() + step, logits.m_vector.end(), [](const Token& lhs, const Token& rhs) {return lhs.m_log_prob > rhs.m_log_prob; });
-            float sum = 0.0;
-            for (int i = 0; i < step; i++) {
-                sum += logits.m_vector[i].m_log_prob;
-                if (sum > m_top_p) {
-                    logits.resize(i+1);
-                    return true;
-                }
-            }
-        }
-        return false;
-    }
-
-    void full_sort_and_resize(Logits& logits) {
-        std::sort(logits.m_vector.begin(), logits.m_vector.end(), [](const Token& lhs, const Token& rhs) {return lhs.m_log_prob > rhs.m_log_prob; });
-        float probability_sum = 0.0f;
-        size_t nucleus_size = 0;
-        for (const auto& logit : logits.m_vector) {
-            probability_sum += logit.m_log_prob;
-            nucleus_size += 1;
-            if (probability_sum > m_top_p) break;
-        }
-        logits.resize(nucleus_size);
-    }
-
     void apply(Logits& logits) override {
-        // Initialize and sort vector. Try partial sorting first and if it's not enough, sort entire vector.
-        logits.initialize_vector();
-        if(!partial_sort_and_resize(logits))
-            full_sort_and_resize(logits);
+        logits.initialize_top_p_vector(m_top_p);
     }
 
 protected:
@@ -123,7 +199,7 @@ class TopKFilter : public ILogitTransformer {
 public:
     TopKFilter(size_t top_k) : m_top_k(top_k) {}
 
-    // If this transform is used along with top_p, it should be applied after it since top_p sorts entire vector and top_k does it only partially
+    // If this transform is used along with top_p, it should be applied after it since top_p sorts the selected tokens
     void apply(Logits& logits) override {
 
         if (m_top_k >= logits.m_size)
@@ -131,9 +207,7 @@ public:
 
         // If top_p is also used vector is already initialized and sorted
         if (!logits.is_vector_initialized()) {
-            // Initialize and partially sort vector
-            logits.initialize_vector();
-            std::partial_sort(logits.m_vector.begin(), logits.m_vector.begin() + m_top_k, logits.m_vector.end(), [](const Token& lhs, const Token& rhs) {return lhs.m_log_prob > rhs.m_log_prob; });
+            logits.initialize_top_k_vector(m_top_k);
         }
         logits.resize(m_top_k);
     }
@@ -147,12 +221,7 @@ public:
     TemperatureLogitTransform(double temperature) : m_temperature(temperature) {};
 
     void apply(Logits& logits) override {
-        float max_logit = -std::numeric_limits<float>::infinity();
-        for (size_t i = 0; i < logits.m_size; i++) {
-            if (logits.m_data[i] > max_logit) {
-                max_logit = logits.m_data[i];
-            }
-        }
+        float max_logit = _get_max(logits.m_data, logits.m_size);
 
         float norm_sum = 0.0;
         for (size_t i = 0; i < logits.m_size; i++) {
@@ -167,6 +236,21 @@ public:
 
 protected:
     float m_temperature = 0.f;
+
+    // the maximum is reduced in independent lanes, which the compiler turns into SIMD or at least pipelined comparisons
+    static float _get_max(const float* data, size_t size) {
+        constexpr size_t NUM_LANES = 8;
+        float lanes[NUM_LANES];
+        std::fill(lanes, lanes + NUM_LANES, -std::numeric_limits<float>::infinity());
+        size_t i = 0;
+        for (; i + NUM_LANES <= size; i += NUM_LANES) {
+            for (size_t lane = 0; lane < NUM_LANES; lane++)
+                lanes[lane] = data[i + lane] > lanes[lane] ? data[i + lane] : lanes[lane];
+        }
+        for (; i < size; i++)
+            lanes[0] = data[i] > lanes[0] ? data[i] : lanes[0];
+        return *std::max_element(lanes, lanes + NUM_LANES);
+    }
 };
 
 
@@ -319,5 +403,64 @@ public:
     }
 };
 
+/**
+ * @brief Applies the repetition, presence and frequency penalties in a single sparse pass over the prompt and generated tokens.
+ *
+ * The result is the same as of RepetitionPenaltyTransform, PresencePenaltyTransform and FrequencyPenaltyTransform applied
+ * one after another, but the logits of each penalized token and the token counts are visited once per step.
+ */
+class CombinedPenaltyTransform : public IPenaltyTransformer {
+public:
+    CombinedPenaltyTransform(double repetition_penalty, double presence_penalty, double frequency_penalty) :
+        m_repetition_penalty(repetition_penalty), m_presence_penalty(presence_penalty), m_frequency_penalty(frequency_penalty) {}
+
+    void apply(Logits& logits) override {
+        size_t vocab_size = logits.m_size;
+        const bool has_repetition_penalty = m_repetition_penalty != 1.0;
+        if (has_repetition_penalty) {
+            for (const auto& prompt_id : *m_unique_prompt_token_ids) {
+                OPENVINO_ASSERT((prompt_id >= 0) && (prompt_id < vocab_size), "input_ids token out of bounds");
+                _apply_repetition_penalty(logits.m_data[prompt_id]);
+            }
+        }
+        for (const auto& [input_id, count] : *m_unique_generated_token_ids) {
+            OPENVINO_ASSERT((input_id >= 0) && (input_id < vocab_size), "input_ids token out of bounds");
+            float& logit = logits.m_data[input_id];
+            // repetition_penalty of the prompt tokens was already accounted by the loop above
+            if (has_repetition_penalty && m_unique_prompt_token_ids->count(input_id) == 0) {
+                _apply_repetition_penalty(logit);
+            }
+            if (m_presence_penalty != 0.0) {
+                logit = logit >= 0 ? logit - m_presence_penalty : logit + m_presence_penalty;
+            }
+            if (m_frequency_penalty != 0.0) {
+                logit = logit >= 0 ? logit - m_frequency_penalty * count : logit + m_frequency_penalty * count;
+            }
+        }
+    }
+
+    void set_unique_prompt_token_ids(const std::shared_ptr<std::set<int64_t>>& unique_prompt_token_ids) {
+        if (unique_prompt_token_ids != nullptr) {
+            m_unique_prompt_token_ids = unique_prompt_token_ids;
+        } else {
+            m_unique_prompt_token_ids = std::shared_ptr<std::set<int64_t>>(new std::set<int64_t>);
+        }
+    }
+
+protected:
+    std::shared_ptr<std::set<int64_t>> m_unique_prompt_token_ids = nullptr;
+    double m_repetition_penalty = 1.f;
+    double m_presence_penalty = 0.f;
+    double m_frequency_penalty = 0.f;
+
+    void _apply_repetition_penalty(float& logit) const {
+        if (logit >= 0) {
+            logit /= m_repetition_penalty;
+        } else {
+            logit *= m_repetition_penalty;
+        }
+    }
+};
+
 } // namespace LogitTransformers
 } // namespace ov::genai
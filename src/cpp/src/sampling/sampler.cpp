@@ -1,8 +1,6 @@
 // Copyright (C) 2023-2025 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
-#include <future>
-
 #include "sampling/sampler.hpp"
 #include "tokenizer/tokenizer_impl.hpp"
 
@@ -98,89 +96,91 @@ std::vector<int64_t> encode_and_process_string(const std::string& stop_string, o
     return encoded_stop_string;
 }
 
-struct MatchStopStringResult {
-    size_t to_remove = 0;
-    // int64_t last_token_id = 0;
-    // bool is_to_update_last_token = false;
-    bool is_matched = false;
-};
-
-// Return number of last tokens that match one of the stop_strings. If there's no match 0 is returned.
-MatchStopStringResult match_stop_string(Tokenizer& tokenizer,
-                      const TokenIds& generated_tokens,
-                      const std::pair<size_t, std::set<std::string>>& stop_strings,
-                      bool is_include_to_output,
-                      size_t draft_generated_tokens = 0) {
+MatchStopStringResult match_stop_string(TokenPieces& token_pieces,
+                                        const StopStringMatcher& stop_string_matcher,
+                                        Sequence::Ptr sequence,
+                                        bool is_include_to_output,
+                                        std::optional<int64_t> next_token_id) {
     MatchStopStringResult result;
-    if (generated_tokens.size() >= stop_strings.first) {
-        // draft_generated_tokens is to handle case with >= 1 generated tokens per step
-        size_t offset = generated_tokens.size() - draft_generated_tokens;
-        if (offset < stop_strings.first) {
-            return result;
+    const auto& generated_tokens = sequence->get_generated_ids();
+    auto& states = sequence->get_stop_string_states();
+    const size_t num_tokens = generated_tokens.size() + (next_token_id.has_value() ? 1 : 0);
+    auto get_token_id = [&](size_t position) {
+        return position < generated_tokens.size() ? generated_tokens[position] : *next_token_id;
+    };
+    // the text of the tokens [begin, end), where the tokens before `end - 1` are pending
+    std::string run_piece;
+    auto get_piece = [&](size_t begin, size_t end) -> const std::string& {
+        if (end - begin == 1) {
+            return token_pieces.get(get_token_id(begin));
         }
-        offset -= stop_strings.first;
-        TokenIds buffer(generated_tokens.begin() + offset, generated_tokens.end());
-        std::string decoded_buffer = tokenizer.decode(buffer);
-        for (const auto& stop_string : stop_strings.second) {
-            auto pos = decoded_buffer.find(stop_string);
-            if (pos != std::string::npos) {
-                result.is_matched = true;
-
-                auto stop_string_len = is_include_to_output ? stop_string.length() : 0;
-                decoded_buffer = decoded_buffer.substr(0, pos + stop_string_len);
-                // to remove word splitting symbols from tail
-                while (decoded_buffer.back() == ' ' || decoded_buffer.back() == '\n') {
-                    decoded_buffer.pop_back();
-                }
-                if (decoded_buffer.empty()) {
-                    result.to_remove = buffer.size();
-                    return result;
-                }
+        std::vector<int64_t> token_ids;
+        for (size_t position = begin; position < end; ++position) {
+            token_ids.push_back(get_token_id(position));
+        }
+        run_piece = token_pieces.get(token_ids);
+        return run_piece;
+    };
+    // the first token of the run of pending tokens ending at `end`, or `end` if there are none
+    auto get_run_begin = [&](size_t end) {
+        while (end > 0 && states[end - 1] == StopStringMatcher::PENDING_STATE) {
+            --end;
+        }
+        return end;
+    };
 
-                // find token cnt to be removed from sequence by decoding token by token
-                std::string decoded_partially_string;
-                for (size_t i = 0; i < buffer.size(); ++i) {
-                    decoded_partially_string = tokenizer.decode(TokenIds{buffer.begin(), buffer.begin() + i + 1});
-                    if (decoded_partially_string.find(decoded_buffer) != std::string::npos) {
-                        result.to_remove = buffer.size() - i - 1;
-                        break;
-                    }
-                }
-                return result;
+    size_t run_begin = get_run_begin(states.size());
+    StopStringMatcher::State state = run_begin == 0 ? StopStringMatcher::INITIAL_STATE : states[run_begin - 1];
+    for (size_t position = states.size(); position < num_tokens; ++position) {
+        const std::string& piece = get_piece(run_begin, position + 1);
+        // the bytes of an incomplete character are fed once the character is complete
+        if (TokenPieces::is_incomplete(piece) && position + 1 - run_begin < TokenPieces::MAX_INCOMPLETE_TOKENS) {
+            if (position < generated_tokens.size()) {
+                states.push_back(StopStringMatcher::PENDING_STATE);
             }
+            continue;
         }
-    }
-    return result;
-}
-
-// Return number of last tokens that match one of the stop_strings. If there's no match 0 is returned.
-// Number of tokens might not be exact as if there's no direct token match, we decode generated tokens incrementally expanding decoding scope
-// with 4 next tokens with each iteration until we check all tokens.
-int match_stop_string2(Tokenizer & tokenizer, const TokenIds & generated_tokens, const std::set<std::string> & stop_strings) {
-    for (const auto& stop_string: stop_strings) {
-        auto stop_tokens_ov = tokenizer.encode(stop_string).input_ids;
-        size_t num_tokens = stop_tokens_ov.get_size();
-        if(num_tokens > generated_tokens.size())
+        StopStringMatcher::Match match;
+        state = stop_string_matcher.advance(state, piece, match);
+        if (!match.is_matched()) {
+            // the state after the next token is not stored, as the token is not in the sequence
+            if (position < generated_tokens.size()) {
+                states.push_back(state);
+            }
+            run_begin = position + 1;
             continue;
-
-        // Check direct token match
-        std::vector<int64_t> stop_tokens(stop_tokens_ov.data<int64_t>(), stop_tokens_ov.data<int64_t>() + num_tokens);
-        std::vector<int64_t> last_generated_tokens(generated_tokens.end()-num_tokens, generated_tokens.end());
-        if (stop_tokens == last_generated_tokens)
-            return num_tokens;
-        
-        // Continue checking chunks of 4 tokens
-        num_tokens += 4;
-        while (num_tokens <= generated_tokens.size()) {
-            std::vector<int64_t> last_generated_tokens(generated_tokens.end()-num_tokens, generated_tokens.end());
-            std::string decoded_last_tokens = tokenizer.decode(last_generated_tokens);
-            if (decoded_last_tokens.find(stop_string) != std::string::npos) {
-                return num_tokens;
+        }
+        result.is_matched = true;
+
+        // the number of bytes after the cut point in the text of the tokens up to the current one
+        size_t num_bytes_to_remove = piece.size() - match.end + (is_include_to_output ? 0 : match.length);
+        // the tokens are kept by runs, as the text of a run can not be split between its tokens
+        size_t kept_begin = run_begin, kept_end = position + 1;
+        std::string kept_piece = piece;
+        while (kept_end > 0) {
+            if (num_bytes_to_remove >= kept_piece.size()) {
+                num_bytes_to_remove -= kept_piece.size();
+            } else {
+                // to remove word splitting symbols from tail
+                size_t cut = kept_piece.size() - num_bytes_to_remove;
+                while (cut > 0 && (kept_piece[cut - 1] == ' ' || kept_piece[cut - 1] == '\n')) {
+                    --cut;
+                }
+                if (cut > 0) {
+                    break;
+                }
+                num_bytes_to_remove = 0;
+            }
+            kept_end = kept_begin;
+            if (kept_end > 0) {
+                kept_begin = get_run_begin(kept_end - 1);
+                kept_piece = get_piece(kept_begin, kept_end);
             }
-            num_tokens += 4;
         }
+        result.to_remove = num_tokens - kept_end;
+        break;
     }
-    return 0;
+    return result;
 }
 
 void Sampler::GroupBeamSearcher::finalize(SamplerOutput& sampler_output) {
@@ -206,11 +206,11 @@ void Sampler::GroupBeamSearcher::finalize(SamplerOutput& sampler_output) {
     }
 }
 
-Sampler::GroupBeamSearcher::GroupBeamSearcher(SequenceGroup::Ptr sequence_group, Tokenizer tokenizer)
+Sampler::GroupBeamSearcher::GroupBeamSearcher(SequenceGroup::Ptr sequence_group, std::shared_ptr<TokenPieces> token_pieces)
     : m_sequence_group(sequence_group),
         m_parameters{m_sequence_group->get_sampling_parameters()},
         m_groups{m_parameters.num_beam_groups},
-        m_tokenizer(tokenizer) {
+        m_token_pieces(std::move(token_pieces)) {
     OPENVINO_ASSERT(m_sequence_group->num_running_seqs() == 1);
     assert(m_parameters.num_beams % m_parameters.num_beam_groups == 0 &&
         "number of beams should be divisible by number of groups");
@@ -259,7 +259,7 @@ void Sampler::clear_structured_output_compile_times() {
 
 void Sampler::GroupBeamSearcher::select_next_tokens(const ov::Tensor& logits,
     SamplerOutput& sampler_output,
-    const std::pair<size_t, std::set<std::string>>& stop_strings) {
+    const StopStringMatcher& stop_string_matcher) {
     assert(m_parameters.num_beams % m_parameters.num_beam_groups == 0 &&
         "number of beams should be divisible by number of groups");
     size_t group_size = m_parameters.num_beams / m_parameters.num_beam_groups;
@@ -403,10 +403,8 @@ void Sampler::GroupBeamSearcher::select_next_tokens(const ov::Tensor& logits,
 
             if (!m_parameters.stop_strings.empty()) {
                 // We need to include candidate token to already generated tokens to check if stop string has been generated
-                // There's probably a better way to do that, than copying whole vector...
-                std::vector<int64_t> token_ids = candidate.m_sequence->get_generated_ids();
-                token_ids.push_back(candidate.m_token_id);
-                auto match_result = match_stop_string(m_tokenizer, token_ids, stop_strings, m_parameters.include_stop_str_in_output);
+                auto match_result = match_stop_string(*m_token_pieces, stop_string_matcher, candidate.m_sequence,
+                                                      m_parameters.include_stop_str_in_output, candidate.m_token_id);
                 if (match_result.is_matched) {
                     // If beam_token does not belong to top num_beams tokens, it should not be added
                     if (cand_idx >= group_size)
@@ -541,17 +539,19 @@ Token Sampler::_greedy_sample(const Logits& logits, size_t top_logprobs) const {
 
 std::vector<Token> Sampler::_multinomial_sample(const Logits& logits, size_t num_tokens_per_sequence) {
     // If top_p or top_k was applied we use sorted vector, if not we go with original buffer.
-    std::vector<float> multinomial_weights;
-    multinomial_weights.reserve(logits.m_size);
-    if (logits.is_vector_initialized())
-        for (auto& logit: logits.m_vector) multinomial_weights.emplace_back(logit.m_log_prob);
-    else
-        multinomial_weights.assign(logits.m_data, logits.m_data + logits.m_size);
-
     // std::discrete_distribution returns corrupted results when applied to log probabilities
     // which result returning NAN only logprobs.
     // so log() is applied after this line
-    auto dist = std::discrete_distribution<size_t>(multinomial_weights.begin(), multinomial_weights.end()); // equivalent to multinomial with number of trials == 1
+    std::discrete_distribution<size_t> dist; // equivalent to multinomial with number of trials == 1
+    if (logits.is_vector_initialized()) {
+        std::vector<float> multinomial_weights;
+        multinomial_weights.reserve(logits.m_size);
+        for (auto& logit: logits.m_vector) multinomial_weights.emplace_back(logit.m_log_prob);
+        dist = std::discrete_distribution<size_t>(multinomial_weights.begin(), multinomial_weights.end());
+    } else {
+        // the buffer is not copied, the distribution only keeps the normalized weights
+        dist = std::discrete_distribution<size_t>(logits.m_data, logits.m_data + logits.m_size);
+    }
 
     std::vector<Token> out_tokens;
     for (size_t token_idx = 0; token_idx < num_tokens_per_sequence; ++token_idx) {
@@ -588,9 +588,9 @@ std::vector<int64_t> Sampler::_try_finish_generation(SequenceGroup::Ptr & sequen
         }
 
         if (!sampling_params.stop_strings.empty()) {
-            auto& stop_strings = m_stop_strings.at(sequence_group->get_request_id());
-            auto match_result = match_stop_string(m_tokenizer, running_sequence->get_generated_ids(), stop_strings,
-                                                  sampling_params.include_stop_str_in_output, sequence_group->get_num_tokens_to_validate());
+            const auto& stop_string_matcher = m_stop_strings.at(sequence_group->get_request_id());
+            auto match_result = match_stop_string(*m_token_pieces, stop_string_matcher, running_sequence,
+                                                  sampling_params.include_stop_str_in_output);
             if (match_result.is_matched) {
                 running_sequence->remove_last_tokens(match_result.to_remove);
 
@@ -770,7 +770,7 @@ process_stop_strings(const std::set<std::string>& stop_strings, Tokenizer& token
 }
 
 SequenceGroupSamplingInfo Sampler::sample_from_sequence_group(SequenceGroup::Ptr sequence_group, ov::Tensor sequence_group_logits, 
-                                                              LogitProcessor& logit_processor, const std::pair<size_t, std::set<std::string>>& stop_strings, 
+                                                              LogitProcessor& logit_processor, const StopStringMatcher& stop_string_matcher, 
                                                               bool is_validation_mode_enabled) {
     SequenceGroupSamplingInfo sg_sampling_info;
     // Assistant pipeline info is relevant for speculative and prompt lookup decoding
@@ -902,7 +902,7 @@ SequenceGroupSamplingInfo Sampler::sample_from_sequence_group(SequenceGroup::Ptr
         {
             std::lock_guard<std::mutex> lock(m_beam_search_info_mutex);
             if (m_beam_search_info.find(request_id) == m_beam_search_info.end()) {
-                m_beam_search_info.emplace(request_id, GroupBeamSearcher(sequence_group, m_tokenizer));
+                m_beam_search_info.emplace(request_id, GroupBeamSearcher(sequence_group, m_token_pieces));
             }
             beam_searcher = &m_beam_search_info.at(request_id);
         }
@@ -912,7 +912,7 @@ SequenceGroupSamplingInfo Sampler::sample_from_sequence_group(SequenceGroup::Ptr
         }
 
         // current algorithm already adds new tokens to running sequences and
-        beam_searcher->select_next_tokens(sequence_group_logits, sg_sampling_info.sampler_output, stop_strings);
+        beam_searcher->select_next_tokens(sequence_group_logits, sg_sampling_info.sampler_output, stop_string_matcher);
 
         // check max length stop criteria
         std::vector<Sequence::Ptr> running_sequences = sequence_group->get_running_sequences();
@@ -929,6 +929,39 @@ SequenceGroupSamplingInfo Sampler::sample_from_sequence_group(SequenceGroup::Ptr
     return sg_sampling_info;
 }
 
+void Sampler::_init_request_info(const SequenceGroup::Ptr& sequence_group, size_t vocab_size) {
+    const ov::genai::GenerationConfig& sampling_params = sequence_group->get_sampling_parameters();
+    const auto request_id = sequence_group->get_request_id();
+    if (!m_logit_processors.count(request_id)) {
+        std::shared_ptr<StructuredOutputController> structured_output_controller = nullptr;
+        if (m_tokenizer.m_pimpl != nullptr) {
+            structured_output_controller = m_tokenizer.m_pimpl->get_structured_output_controller(vocab_size);
+        }
+        m_logit_processors.insert({request_id, LogitProcessor(sampling_params, sequence_group->get_prompt_ids(), structured_output_controller)});
+    }
+    if (!m_stop_strings.count(request_id)) {
+        if (!sampling_params.stop_strings.empty()) {
+            OPENVINO_ASSERT(m_tokenizer.m_pimpl != nullptr, "Stop strings require a valid tokenizer");
+            auto processed_stop_string = process_stop_strings(sampling_params.stop_strings, m_tokenizer);
+            m_stop_strings.emplace(static_cast<int64_t>(request_id), StopStringMatcher(processed_stop_string.second));
+            sequence_group->set_stream_window_size(processed_stop_string.first);
+        } else {
+            m_stop_strings.emplace(static_cast<int64_t>(request_id), StopStringMatcher());
+        }
+    }
+}
+
+void Sampler::prepare(const std::vector<SequenceGroup::Ptr> & sequence_groups, size_t vocab_size) {
+    if (vocab_size == 0) {
+        return;
+    }
+    for (const auto& sequence_group : sequence_groups) {
+        if (sequence_group->has_finished() || sequence_group->handle_stopped() || sequence_group->handle_cancelled())
+            continue;
+        _init_request_info(sequence_group, vocab_size);
+    }
+}
+
 SamplerOutput Sampler::sample(const std::vector<SequenceGroup::Ptr> & sequence_groups,
                               ov::Tensor logits,
                               bool is_validation_mode_enabled) {
@@ -938,7 +971,13 @@ SamplerOutput Sampler::sample(const std::vector<SequenceGroup::Ptr> & sequence_g
     size_t vocab_size = logits_shape[2];
 
     SamplerOutput sampler_output;
-    std::unordered_map<uint64_t, std::future<SequenceGroupSamplingInfo>> sg_sampling_future_map;
+    struct SamplingTask {
+        SequenceGroup::Ptr sequence_group;
+        ov::Tensor logits;
+        LogitProcessor* logit_processor;
+        const StopStringMatcher* stop_string_matcher;
+    };
+    std::vector<SamplingTask> sampling_tasks;
     for (size_t sequence_group_id = 0, currently_processed_tokens = 0; sequence_group_id < sequence_groups.size(); ++sequence_group_id) {
         SequenceGroup::Ptr sequence_group = sequence_groups[sequence_group_id];
         if (!sequence_group->is_scheduled())
@@ -949,31 +988,13 @@ SamplerOutput Sampler::sample(const std::vector<SequenceGroup::Ptr> & sequence_g
         const ov::genai::GenerationConfig& sampling_params = sequence_group->get_sampling_parameters();
 
         const auto request_id = sequence_group->get_request_id();
-        if (!m_logit_processors.count(request_id)) {
-            std::shared_ptr<StructuredOutputController> structured_output_controller = nullptr;
-            if (m_tokenizer.m_pimpl != nullptr) {
-                structured_output_controller = m_tokenizer.m_pimpl->get_structured_output_controller(vocab_size);
-            }
-            m_logit_processors.insert({request_id, LogitProcessor(sampling_params, sequence_group->get_prompt_ids(), structured_output_controller)});
-        }
-        if (!m_stop_strings.count(request_id)) {
-            if (!sampling_params.stop_strings.empty()) {
-                OPENVINO_ASSERT(m_tokenizer.m_pimpl != nullptr, "Stop strings require a valid tokenizer");
-                auto processed_stop_string = process_stop_strings(sampling_params.stop_strings, m_tokenizer);
-                m_stop_strings.insert({static_cast<int64_t>(request_id), processed_stop_string});
-                sequence_group->set_stream_window_size(processed_stop_string.first);
-            } else {
-                m_stop_strings.insert({static_cast<int64_t>(request_id), {size_t(0), {}}});
-            }
-        }
-        const auto& stop_strings = m_stop_strings.at(request_id);
+        _init_request_info(sequence_group, vocab_size);
+        const auto& stop_string_matcher = m_stop_strings.at(request_id);
         auto& logit_processor = m_logit_processors.at(request_id);
         const void * sequence_group_logits_data = logits_data + vocab_size * currently_processed_tokens;
         ov::Tensor sequence_group_logits(ov::element::f32, ov::Shape{num_running_sequences, output_seq_len, vocab_size}, (void *)sequence_group_logits_data);
         if (sequence_group->requires_sampling()) {
-            // Call sample_from_sequence_group asynchronously
-            sg_sampling_future_map[request_id] = m_thread_pool.submit(&Sampler::sample_from_sequence_group, this, sequence_group, sequence_group_logits,
-                                                                      logit_processor, stop_strings, is_validation_mode_enabled);
+            sampling_tasks.push_back({sequence_group, sequence_group_logits, &logit_processor, &stop_string_matcher});
         } else {
             // we are in prompt processing phase when prompt is split into chunks and processed step by step
         }
@@ -981,15 +1002,24 @@ SamplerOutput Sampler::sample(const std::vector<SequenceGroup::Ptr> & sequence_g
         currently_processed_tokens += output_seq_len * num_running_sequences;
     }
 
+    // Sample sequence groups in parallel on the shared thread pool, the calling thread takes part in sampling
+    std::vector<SequenceGroupSamplingInfo> sg_sampling_infos(sampling_tasks.size());
+    ThreadPool::get_shared().parallel_for(sampling_tasks.size(), [&](size_t task_id) {
+        const SamplingTask& task = sampling_tasks[task_id];
+        // the generated length of the processor is updated only after sampling is finished (see below), so sampling works on a copy
+        LogitProcessor logit_processor = *task.logit_processor;
+        sg_sampling_infos[task_id] = sample_from_sequence_group(task.sequence_group, task.logits, logit_processor, *task.stop_string_matcher,
+                                                                is_validation_mode_enabled);
+    }, m_num_threads);
+
     // Update sequence groups internal states after sampling is done
-    for (auto& sequence_group : sequence_groups) {
+    for (size_t sequence_group_id = 0, task_id = 0; sequence_group_id < sequence_groups.size(); ++sequence_group_id) {
+        const SequenceGroup::Ptr& sequence_group = sequence_groups[sequence_group_id];
         if (!sequence_group->is_scheduled())
             continue;
         SequenceGroupSamplingInfo sg_sampling_info;
-        const auto request_id = sequence_group->get_request_id();
-        if (sg_sampling_future_map.find(request_id) != sg_sampling_future_map.end()) {
-            // If there is a future assigned to a sequence group we read it's result (blocking if results not available yet)
-            sg_sampling_info = sg_sampling_future_map[request_id].get();
+        if (task_id < sampling_tasks.size() && sampling_tasks[task_id].sequence_group == sequence_group) {
+            sg_sampling_info = std::move(sg_sampling_infos[task_id++]);
             sampler_output.num_generated_tokens += sg_sampling_info.sampler_output.num_generated_tokens;
 
             // Merge sampler output from sequence group to the main one
@@ -11,6 +11,7 @@
 #include <map>
 #include <algorithm>
 #include <cmath>
+#include <optional>
 #include <random>
 #include <set>
 
@@ -18,6 +19,7 @@
 
 #include "sampling/logit_transformers.hpp"
 #include "sampling/logit_processor.hpp"
+#include "sampling/stop_string_matcher.hpp"
 #include "continuous_batching/scheduler.hpp"
 #include "sequence_group.hpp"
 #include "threadpool.hpp"
@@ -45,6 +47,19 @@ inline bool is_stop_token_id_hit_in_sequence_group(SequenceGroup::Ptr sequence_g
 
 std::vector<Token> log_softmax(const ov::Tensor& logits, size_t batch_idx);
 
+struct MatchStopStringResult {
+    size_t to_remove = 0;
+    bool is_matched = false;
+};
+
+// Feeds the generated tokens which are not fed yet to the stop strings matcher, followed by `next_token_id` if it is set.
+// Returns the number of last tokens to be removed if one of the stop strings is matched.
+MatchStopStringResult match_stop_string(TokenPieces& token_pieces,
+                                        const StopStringMatcher& stop_string_matcher,
+                                        Sequence::Ptr sequence,
+                                        bool is_include_to_output,
+                                        std::optional<int64_t> next_token_id = std::nullopt);
+
 struct SamplerOutput {
     // IDs of sequences that need to be dropped
     std::vector<uint64_t> m_dropped_sequences;
@@ -81,8 +96,10 @@ class Sampler {
     bool validate_candidate(Sequence::Ptr running_sequence, size_t& token_idx, Token& sampled_token,
                             bool& is_extend_sequence, size_t& max_removed_tokens, bool do_sample, bool has_real_probolities);
 
+    void _init_request_info(const SequenceGroup::Ptr& sequence_group, size_t vocab_size);
+
     SequenceGroupSamplingInfo sample_from_sequence_group(SequenceGroup::Ptr sequence_group, ov::Tensor sequence_group_logits,
-                                                        LogitProcessor& logit_processor, const std::pair<size_t, std::set<std::string>>& stop_strings,
+                                                        LogitProcessor& logit_processor, const StopStringMatcher& stop_string_matcher,
                                                         bool is_validation_mode_enabled);
 
     // request ID => beam search tracking information
@@ -93,20 +110,31 @@ class Sampler {
     size_t seed = rng_engine.default_seed;
     // { request_id, logit_processor }
     std::map<uint64_t, LogitProcessor> m_logit_processors;
-    // { request_id, { max_encoded_len, { stop_strings }}}
-    std::map<int64_t, std::pair<size_t, std::set<std::string>>> m_stop_strings;
+    // { request_id, stop_strings_matcher }
+    std::map<int64_t, StopStringMatcher> m_stop_strings;
 
     Tokenizer m_tokenizer;
+    // the text of the tokens fed to the stop strings matchers
+    std::shared_ptr<TokenPieces> m_token_pieces = std::make_shared<TokenPieces>(m_tokenizer);
 
-    ThreadPool m_thread_pool;
+    // the maximum number of threads of the shared pool used to sample sequence groups in parallel
+    size_t m_num_threads;
     std::shared_ptr<ov::op::v0::Constant> m_d2t_mapping; // Tensor to store draft_id_to_target_id mapping for eagle model, adding offsets to draft tokens after sampling
 public:
     Sampler(const Sampler& rhs) = delete;
     Sampler(Sampler&& rhs) = delete;
-    Sampler(size_t num_threads = 1): m_thread_pool(num_threads) {};
-    explicit Sampler(const Tokenizer & tokenizer, size_t num_threads = 1) : m_tokenizer(tokenizer), m_thread_pool(num_threads) {};
+    Sampler(size_t num_threads = 1): m_num_threads(num_threads) {};
+    explicit Sampler(const Tokenizer & tokenizer, size_t num_threads = 1) : m_tokenizer(tokenizer), m_num_threads(num_threads) {};
 
     SamplerOutput sample(const std::vector<SequenceGroup::Ptr> & sequence_groups, ov::Tensor logits, bool is_validation_mode_enabled = false);
+
+    /**
+     * Performs the per-request initialization which does not depend on the logits (logit processors, structured output grammars,
+     * stop string encoding) ahead of the `sample` call, so that it can be overlapped with the model inference.
+     * @param sequence_groups Sequence groups to be prepared; already prepared ones are skipped.
+     * @param vocab_size The vocabulary size of the logits which will be passed to `sample`. Nothing is done if it is 0.
+     */
+    void prepare(const std::vector<SequenceGroup::Ptr> & sequence_groups, size_t vocab_size);
     void set_seed(size_t new_seed) {
         rng_engine.seed(new_seed);
         seed = new_seed;
@@ -115,6 +143,7 @@ public:
 
     void set_tokenizer(const Tokenizer& tokenizer) {
         m_tokenizer = tokenizer;
+        m_token_pieces = std::make_shared<TokenPieces>(m_tokenizer);
     }
 
     void clear_request_info(uint64_t request_id);
@@ -168,11 +197,11 @@ class Sampler::GroupBeamSearcher {
     SequenceGroup::Ptr m_sequence_group;
     ov::genai::GenerationConfig m_parameters;
     std::vector<Group> m_groups;
-    Tokenizer m_tokenizer;
+    std::shared_ptr<TokenPieces> m_token_pieces;
 public:
-    explicit GroupBeamSearcher(SequenceGroup::Ptr sequence_group, Tokenizer tokenizer);
+    explicit GroupBeamSearcher(SequenceGroup::Ptr sequence_group, std::shared_ptr<TokenPieces> token_pieces);
 
-    void select_next_tokens(const ov::Tensor& logits, SamplerOutput& sampler_output, const std::pair<size_t, std::set<std::string>>& stop_strings);
+    void select_next_tokens(const ov::Tensor& logits, SamplerOutput& sampler_output, const StopStringMatcher& stop_string_matcher);
     void finalize(SamplerOutput& sampler_output);
     std::map<size_t, int32_t> get_beam_idxs();
 };
@@ -0,0 +1,115 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <queue>
+
+#include "sampling/stop_string_matcher.hpp"
+
+namespace ov::genai {
+
+StopStringMatcher::StopStringMatcher(const std::set<std::string>& stop_strings) : m_nodes(1) {
+    for (const auto& stop_string : stop_strings) {
+        State state = INITIAL_STATE;
+        for (const char byte : stop_string) {
+            auto child_it = m_nodes[state].children.find(byte);
+            if (child_it == m_nodes[state].children.end()) {
+                child_it = m_nodes[state].children.emplace(byte, m_nodes.size()).first;
+                m_nodes.emplace_back();
+            }
+            state = child_it->second;
+        }
+        if (state != INITIAL_STATE) {
+            m_nodes[state].match_length = stop_string.size();
+        }
+    }
+
+    // the failure links are set in breadth-first order, so the failure link of a node is set before its children are visited
+    std::queue<State> queue;
+    for (const auto& [byte, child] : m_nodes[INITIAL_STATE].children) {
+        queue.push(child);
+    }
+    while (!queue.empty()) {
+        const State state = queue.front();
+        queue.pop();
+        for (const auto& [byte, child] : m_nodes[state].children) {
+            State fail = m_nodes[state].fail;
+            while (fail != INITIAL_STATE && !m_nodes[fail].children.count(byte)) {
+                fail = m_nodes[fail].fail;
+            }
+            auto fail_child_it = m_nodes[fail].children.find(byte);
+            m_nodes[child].fail = fail_child_it != m_nodes[fail].children.end() ? fail_child_it->second : INITIAL_STATE;
+            // a stop string ending at the node is longer than the ones ending at its failure link
+            if (m_nodes[child].match_length == 0) {
+                m_nodes[child].match_length = m_nodes[m_nodes[child].fail].match_length;
+            }
+            queue.push(child);
+        }
+    }
+}
+
+StopStringMatcher::State StopStringMatcher::_next(State state, char byte) const {
+    while (true) {
+        auto child_it = m_nodes[state].children.find(byte);
+        if (child_it != m_nodes[state].children.end()) {
+            return child_it->second;
+        }
+        if (state == INITIAL_STATE) {
+            return INITIAL_STATE;
+        }
+        state = m_nodes[state].fail;
+    }
+}
+
+StopStringMatcher::State StopStringMatcher::advance(State state, const std::string& piece, Match& match) const {
+    match = Match{};
+    for (size_t i = 0; i < piece.size(); ++i) {
+        state = _next(state, piece[i]);
+        if (m_nodes[state].match_length > 0) {
+            match.end = i + 1;
+            match.length = m_nodes[state].match_length;
+            break;
+        }
+    }
+    return state;
+}
+
+TokenPieces::TokenPieces(const Tokenizer& tokenizer) {
+    m_decode = [tokenizer = tokenizer](const std::vector<int64_t>& token_ids) mutable {
+        return tokenizer.decode(token_ids);
+    };
+}
+
+std::string TokenPieces::_decode_piece(const std::vector<int64_t>& token_ids) const {
+    // the tokens are decoded after themselves, as some detokenizers remove the leading space of the first token
+    const std::string single = m_decode(token_ids);
+    std::vector<int64_t> repeated_ids = token_ids;
+    repeated_ids.insert(repeated_ids.end(), token_ids.begin(), token_ids.end());
+    const std::string repeated = m_decode(repeated_ids);
+    return repeated.size() >= single.size() ? repeated.substr(single.size()) : single;
+}
+
+const std::string& TokenPieces::get(int64_t token_id) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto piece_it = m_pieces.find(token_id);
+        if (piece_it != m_pieces.end()) {
+            return piece_it->second;
+        }
+    }
+    std::string piece = _decode_piece({token_id});
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pieces.emplace(token_id, std::move(piece)).first->second;
+}
+
+std::string TokenPieces::get(const std::vector<int64_t>& token_ids) const {
+    return _decode_piece(token_ids);
+}
+
+bool TokenPieces::is_incomplete(const std::string& piece) {
+    static const std::string replacement_character = "\xEF\xBF\xBD";
+    return piece.size() >= replacement_character.size() &&
+           piece.compare(piece.size() - replacement_character.size(), replacement_character.size(), replacement_character) == 0;
+}
+
+}  // namespace ov::genai
@@ -0,0 +1,103 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "openvino/genai/tokenizer.hpp"
+
+namespace ov::genai {
+
+/**
+ * @brief Aho-Corasick automaton over the bytes of the stop strings of a request.
+ * The text of the generated tokens is fed piece by piece, so a stop string is found in O(1) per byte
+ * without decoding the generated tokens again. The state after each generated token is stored in the sequence,
+ * so only the new tokens are fed at each step.
+ */
+class StopStringMatcher {
+public:
+    using State = size_t;
+    static constexpr State INITIAL_STATE = 0;
+    // the state stored for a token whose text is not fed yet, as it ends with an incomplete character
+    static constexpr State PENDING_STATE = std::numeric_limits<State>::max();
+
+    struct Match {
+        // the number of bytes of the piece up to the end of the stop string
+        size_t end = 0;
+        // the length of the matched stop string, 0 if there is no match
+        size_t length = 0;
+
+        bool is_matched() const {
+            return length > 0;
+        }
+    };
+
+    StopStringMatcher() : StopStringMatcher(std::set<std::string>{}) {}
+
+    // empty stop strings are ignored
+    explicit StopStringMatcher(const std::set<std::string>& stop_strings);
+
+    /**
+     * Feeds the piece to the automaton until the end of the first stop string.
+     * If several stop strings end at the same byte, the longest one is matched.
+     * @return The state after the piece, meaningful only if there is no match.
+     */
+    State advance(State state, const std::string& piece, Match& match) const;
+
+private:
+    struct Node {
+        std::map<char, State> children;
+        State fail = INITIAL_STATE;
+        // the length of the longest stop string ending at the node, 0 if there is none
+        size_t match_length = 0;
+    };
+
+    State _next(State state, char byte) const;
+
+    std::vector<Node> m_nodes;
+};
+
+/**
+ * @brief The text of each token in the middle of a decoded sequence, which is decoded once and shared by all the requests.
+ * A character can be split into several byte tokens, whose text is an incomplete character replaced by U+FFFD by
+ * the detokenizer, so such tokens are decoded together.
+ */
+class TokenPieces {
+public:
+    using DecodeFunction = std::function<std::string(const std::vector<int64_t>&)>;
+
+    // a UTF-8 character is at most 4 bytes long, so it is split into at most 4 tokens
+    static constexpr size_t MAX_INCOMPLETE_TOKENS = 4;
+
+    explicit TokenPieces(const Tokenizer& tokenizer);
+
+    explicit TokenPieces(DecodeFunction decode) : m_decode(std::move(decode)) {}
+
+    // thread safe, the returned reference stays valid for the lifetime of the object
+    const std::string& get(int64_t token_id);
+
+    // the text of several tokens, e.g. of the bytes of a character, which is not cached
+    std::string get(const std::vector<int64_t>& token_ids) const;
+
+    // whether the text ends with an incomplete character, i.e. with U+FFFD
+    static bool is_incomplete(const std::string& piece);
+
+private:
+    std::string _decode_piece(const std::vector<int64_t>& token_ids) const;
+
+    DecodeFunction m_decode;
+    std::mutex m_mutex;
+    std::unordered_map<int64_t, std::string> m_pieces;
+};
+
+}  // namespace ov::genai
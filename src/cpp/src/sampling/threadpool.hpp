@@ -1,73 +0,0 @@
-#include <condition_variable>
-#include <functional>
-#include <future>
-#include <iostream>
-#include <mutex>
-#include <queue>
-#include <thread>
-#include <utility>
-#include <atomic>
-
-class ThreadPool {
-
-private:
-    std::vector<std::thread> threads;
-    std::queue<std::function<void()>> tasks;
-    std::mutex queue_mutex;
-    std::condition_variable cv;
-    bool stop{false};
-
-public:
-    ThreadPool(const ThreadPool& rhs) = delete;
-    ThreadPool(ThreadPool&& rhs) = delete;
-    ThreadPool(size_t num_threads = std::thread::hardware_concurrency())
-    {
-        for (size_t i = 0; i < num_threads; ++i) {
-            threads.emplace_back([this] {
-                while (true) {
-                    std::function<void()> task;
-                    {
-                        std::unique_lock<std::mutex> lock(queue_mutex);
-                        cv.wait(lock, [this] {
-                            return !tasks.empty() || stop;
-                        });
-                        if (stop && tasks.empty()) {
-                            return;
-                        }
-                        task = std::move(tasks.front());
-                        tasks.pop();
-                    }
-                    task();
-                }
-            });
-        }
-    }
-
-    ~ThreadPool()
-    {
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex);
-            stop = true;
-        }
-        cv.notify_all();
-        for (auto& thread : threads) {
-            thread.join();
-        }
-    }
-
-    template <typename F, typename... Args>
-    auto submit(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>>
-    {
-        using return_type = std::invoke_result_t<F, Args...>;
-        auto task = std::make_shared<std::packaged_task<return_type()>>(
-            std::bind(std::forward<F>(f), std::forward<Args>(args)...)
-        );
-        std::future<return_type> result = task->get_future();
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex);
-            tasks.emplace([task]() { (*task)(); });
-        }
-        cv.notify_one();
-        return result;
-    }
-};
@@ -19,6 +19,7 @@ size_t Sequence::_make_hash(size_t content_length) {
 
         // hash of current block depends on prefix hashes
         std::vector<int64_t> content;
+        content.reserve(1 + content_length - block_start_idx);
         size_t filled_blocks_count = block_start_idx / block_size;
         OPENVINO_ASSERT(filled_blocks_count <= m_prefix_hashes.size());
         if (filled_blocks_count > 0) {
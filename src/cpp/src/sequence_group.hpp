@@ -5,6 +5,7 @@
 
 #include <vector>
 #include <cassert>
+#include <chrono>
 #include <set>
 #include <cstdlib>
 #include <string_view>
@@ -56,6 +57,9 @@ class Sequence {
     size_t m_hidden_size;
     std::vector<ov::Tensor> m_position_ids_list;
     int64_t m_rope_delta;
+    // the state of the stop strings matcher after each generated token, filled by the sampler;
+    // the tokens of an incomplete character have StopStringMatcher::PENDING_STATE
+    std::vector<size_t> m_stop_string_states;
 
     // Embeddings hash calculation params
     static constexpr size_t m_embeddings_hash_max_num_values = 10; // max number of values used for embeddings hash calculation
@@ -80,7 +84,8 @@ class Sequence {
         m_prefix_hashes(seq.m_prefix_hashes),
         m_generated_ids_embeds(seq.m_generated_ids_embeds),
         m_position_ids_list(seq.m_position_ids_list),
-        m_rope_delta(seq.m_rope_delta)
+        m_rope_delta(seq.m_rope_delta),
+        m_stop_string_states(seq.m_stop_string_states)
          {
         OPENVINO_ASSERT(seq.m_id != m_id);
     }
@@ -161,6 +166,9 @@ public:
             m_generated_log_probs.pop_back();
             m_generated_ids.pop_back();
         }
+        if (m_stop_string_states.size() > m_generated_ids.size()) {
+            m_stop_string_states.resize(m_generated_ids.size());
+        }
     }
 
     GenerationOutput get_last_generation_output(size_t token_cnt = 1, size_t num_token_to_ignore = 0) {
@@ -200,6 +208,10 @@ public:
         return m_generated_log_probs;
     }
 
+    std::vector<size_t>& get_stop_string_states() {
+        return m_stop_string_states;
+    }
+
     float get_cumulative_log_prob() const {
         return m_cumulative_log_prob;
     }
@@ -343,6 +355,9 @@ class SequenceGroup  : public std::enable_shared_from_this<SequenceGroup> {
 
     size_t m_num_streamed_tokens = 0, m_stream_window_size = 0;
 
+    // time of the request submission, used by scheduling policies with latency targets
+    std::chrono::steady_clock::time_point m_arrival_time = std::chrono::steady_clock::now();
+
     SequenceGroup(uint64_t request_id, const ov::genai::GenerationConfig& sampling_params, std::size_t block_size)
         : m_request_id(request_id),
           m_sampling_params(sampling_params),
@@ -572,6 +587,10 @@ public:
         return running_seqs;
     }
 
+    std::chrono::steady_clock::time_point get_arrival_time() const {
+        return m_arrival_time;
+    }
+
     uint64_t get_request_id() const {
         return m_request_id;
     }
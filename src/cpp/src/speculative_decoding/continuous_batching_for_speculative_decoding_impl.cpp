@@ -31,6 +31,7 @@ ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::finish
         }
     }
     m_sampler->clear_request_info(request->get_request_id());
+    speculation_length_controller.remove_request(request->get_request_id());
     request->set_generation_status(GenerationStatus::STOP);
 }
 
@@ -242,7 +243,8 @@ ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::init_r
 UpdateRequestResult
 ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::update_request(uint64_t request_id,
                                                                                          const GeneratedSequences& candidates,
-                                                                                         bool is_update_logit_processor) {
+                                                                                         bool is_update_logit_processor,
+                                                                                         bool is_keep_generated_ahead) {
     UpdateRequestResult result{0, 0};
     for (auto& request : m_requests) {
         if (request_id != request->get_request_id()) {
@@ -268,6 +270,11 @@ ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::update
             // update existing sequences by the candidates
             auto& logit_processor = m_sampler->get_logit_processor(request_id);
             std::tie(min_generated_tokens, min_candidate_len) = get_prefix_len(running_sequences, candidates);
+            // the candidates are a prefix of the tokens generated ahead of them, which are kept as the next candidates
+            if (is_keep_generated_ahead && running_sequences.size() == 1 && min_generated_tokens == min_candidate_len &&
+                running_sequences.front()->get_generated_len() > min_candidate_len) {
+                break;
+            }
 
             for (auto& running_sequence : running_sequences) {
                 if (!candidates.count(running_sequence->get_grouped_id())) {
@@ -348,14 +355,36 @@ size_t ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl:
 
 void
 ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::pull_awaiting_requests(bool is_pause_request) {
-    std::lock_guard<std::mutex> lock{m_awaiting_requests_mutex};
+    _drain_awaiting_requests_queue();
     if (is_pause_request) {
         for (auto& awaiting_request : m_awaiting_requests) {
             awaiting_request->pause_generation(true);
         }
     }
-    m_requests.insert(m_requests.end(), m_awaiting_requests.begin(), m_awaiting_requests.end());
-    m_awaiting_requests.clear();
+    _move_awaiting_requests();
+}
+
+size_t ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::resume_generation_ahead() {
+    if (eagle_mode_enabled) {
+        // hidden states of the tokens generated ahead are not kept
+        return 0;
+    }
+    size_t num_resumed_requests = 0;
+    for (auto& request : m_requests) {
+        const auto& sampling_params = request->get_sampling_parameters();
+        const size_t num_processed_tokens = request->get_num_processed_tokens(), prompt_len = request->get_prompt_len();
+        if (request->has_finished() || request->num_running_seqs() != 1 ||
+            !sampling_params.is_assisting_generation() || sampling_params.num_return_sequences != 1 ||
+            // no tokens of the request are validated by the main model yet
+            num_processed_tokens <= prompt_len || request->get_max_new_tokens() == 0 ||
+            num_processed_tokens - prompt_len + 1 >= request->get_max_new_tokens() - 1 ||
+            is_stop_token_id_hit_in_sequence_group(request, sampling_params.stop_token_ids)) {
+            continue;
+        }
+        request->pause_generation(false);
+        ++num_resumed_requests;
+    }
+    return num_resumed_requests;
 }
 
 void ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::multistep() {
@@ -392,7 +421,8 @@ void ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::m
                 request->pause_generation(true);
             } else if (request->get_num_processed_tokens() == 0 && sampling_params.num_return_sequences > 1) {
                 request->pause_generation(true);
-            } else if (sampling_params.num_assistant_tokens <= generated_tokens_cnt && sampling_params.assistant_confidence_threshold == 0.f) {
+            } else if (speculation_length_controller.get_num_assistant_tokens(request->get_request_id(), sampling_params) <= generated_tokens_cnt &&
+                       sampling_params.assistant_confidence_threshold == 0.f) {
                 request->pause_generation(true);
             } else if (request->get_max_new_tokens() == 0) {
                 request->pause_generation(true);
@@ -6,6 +6,7 @@
 #include "openvino/genai/continuous_batching_pipeline.hpp"
 
 #include "continuous_batching/pipeline_impl.hpp"
+#include "speculative_decoding/speculation_length_controller.hpp"
 #include "speculative_decoding/update_request_structs.hpp"
 
 namespace ov::genai {
@@ -28,14 +29,23 @@ public:
     void finish_request(int64_t request_id = -1);
     void pull_awaiting_requests(bool is_pause_request = false);
     GeneratedRequests get_generated_requests();
-    UpdateRequestResult update_request(uint64_t request_id, const GeneratedSequences& candidates, bool is_update_logit_processor);
+    UpdateRequestResult update_request(uint64_t request_id, const GeneratedSequences& candidates, bool is_update_logit_processor, bool is_keep_generated_ahead = false);
     bool is_requests_empty();
 
     size_t get_processed_tokens_per_iteration();
 
     UpdateRequestResult init_request_by_candidate(uint64_t request_id, const GeneratedSequences& candidates);
 
+    /**
+     * Resumes the generation of the requests paused by multistep() after their candidates, so that the next multistep()
+     * continues the candidates. Only the requests generating a single sequence are resumed.
+     * @return The number of resumed requests.
+     */
+    size_t resume_generation_ahead();
+
     RawPerfMetrics raw_perf_metrics;
+    // number of candidates generated by multistep() for the requests with the adaptive number of candidates
+    SpeculationLengthController speculation_length_controller;
 
 protected:
     void finish_request(SequenceGroup::Ptr request);
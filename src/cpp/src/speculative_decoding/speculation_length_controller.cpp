@@ -0,0 +1,95 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+
+#include "speculative_decoding/speculation_length_controller.hpp"
+
+namespace ov::genai {
+
+namespace {
+
+// weight of the previous measurements when a new one is registered
+constexpr float DECAY_FACTOR = 0.9f;
+// weight of a new measurement in the smoothed draft step duration
+constexpr float SMOOTHING_FACTOR = 0.25f;
+
+}  // namespace
+
+void SpeculationLengthController::register_validation(uint64_t request_id, size_t num_candidates, size_t num_accepted_candidates) {
+    if (num_candidates == 0) {
+        return;
+    }
+    auto& acceptance = m_acceptance[request_id];
+    acceptance.num_accepted = DECAY_FACTOR * acceptance.num_accepted + num_accepted_candidates;
+    acceptance.num_rejected = DECAY_FACTOR * acceptance.num_rejected + (num_accepted_candidates < num_candidates ? 1.0f : 0.0f);
+}
+
+void SpeculationLengthController::register_draft_step(float duration_ms) {
+    m_draft_step_duration_ms = m_draft_step_duration_ms < 0.0f ? duration_ms :
+                               m_draft_step_duration_ms + SMOOTHING_FACTOR * (duration_ms - m_draft_step_duration_ms);
+}
+
+void SpeculationLengthController::register_main_step(size_t num_requests, size_t num_tokens, float duration_ms) {
+    if (num_requests == 0) {
+        return;
+    }
+    const float x = static_cast<float>(num_tokens);
+    m_main_weight = DECAY_FACTOR * m_main_weight + 1.0f;
+    m_main_tokens = DECAY_FACTOR * m_main_tokens + x;
+    m_main_duration = DECAY_FACTOR * m_main_duration + duration_ms;
+    m_main_tokens_sq = DECAY_FACTOR * m_main_tokens_sq + x * x;
+    m_main_tokens_duration = DECAY_FACTOR * m_main_tokens_duration + x * duration_ms;
+    m_num_requests = num_requests;
+}
+
+void SpeculationLengthController::remove_request(uint64_t request_id) {
+    m_acceptance.erase(request_id);
+}
+
+void SpeculationLengthController::remove_requests() {
+    m_acceptance.clear();
+}
+
+size_t SpeculationLengthController::get_num_assistant_tokens(uint64_t request_id, const GenerationConfig& sampling_params) const {
+    const size_t num_assistant_tokens = sampling_params.num_assistant_tokens;
+    auto acceptance_it = m_acceptance.find(request_id);
+    if (!sampling_params.adaptive_num_assistant_tokens || num_assistant_tokens == 0 ||
+        sampling_params.assistant_confidence_threshold > 0.0f || acceptance_it == m_acceptance.end() || m_main_weight == 0.0f) {
+        return num_assistant_tokens;
+    }
+
+    // a prior of one accepted and one rejected candidate keeps the probability below 1
+    const auto& acceptance = acceptance_it->second;
+    const float acceptance_rate = (acceptance.num_accepted + 1.0f) / (acceptance.num_accepted + acceptance.num_rejected + 2.0f);
+
+    // main step duration = base + per_token * num_tokens
+    const float mean_tokens = m_main_tokens / m_main_weight, mean_duration = m_main_duration / m_main_weight;
+    const float tokens_variance = m_main_tokens_sq / m_main_weight - mean_tokens * mean_tokens;
+    float per_token_ms = 0.0f;
+    if (tokens_variance > 1e-3f * std::max(mean_tokens * mean_tokens, 1.0f)) {
+        per_token_ms = std::max((m_main_tokens_duration / m_main_weight - mean_tokens * mean_duration) / tokens_variance, 0.0f);
+    }
+    float base_ms = mean_duration - per_token_ms * mean_tokens;
+    if (base_ms < 0.0f) {
+        base_ms = 0.0f;
+        per_token_ms = mean_duration / std::max(mean_tokens, 1.0f);
+    }
+    const float draft_step_ms = std::max(m_draft_step_duration_ms, 0.0f);
+
+    size_t best_num_candidates = 1;
+    float best_rate = 0.0f;
+    for (size_t num_candidates = 1; num_candidates <= 2 * num_assistant_tokens; ++num_candidates) {
+        const float expected_tokens = (1.0f - std::pow(acceptance_rate, num_candidates + 1.0f)) / (1.0f - acceptance_rate);
+        const float duration_ms = (base_ms + draft_step_ms * num_candidates) / m_num_requests + per_token_ms * (num_candidates + 1);
+        const float rate = expected_tokens / std::max(duration_ms, 1e-6f);
+        if (rate > best_rate) {
+            best_rate = rate;
+            best_num_candidates = num_candidates;
+        }
+    }
+    return best_num_candidates;
+}
+
+}  // namespace ov::genai
@@ -0,0 +1,71 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+#include "openvino/genai/generation_config.hpp"
+
+namespace ov::genai {
+
+/**
+ * @brief Chooses the number of candidates generated for the requests with GenerationConfig::adaptive_num_assistant_tokens.
+ * Each candidate is assumed to be accepted with the probability estimated for the request, so validating k candidates yields
+ * (1 - a^(k + 1)) / (1 - a) tokens on average (including the token generated by the main model). The duration of a step is
+ * modelled as k draft model steps plus a main model step, whose duration is linear in the number of validated tokens, both
+ * shared between the requests of the batch. The number of candidates maximizing the tokens per unit of time is chosen.
+ * The acceptance probabilities and the durations are estimated from the recent steps.
+ */
+class SpeculationLengthController {
+public:
+    /**
+     * Updates the acceptance probability of the request.
+     * @param request_id The request the candidates were validated for.
+     * @param num_candidates The number of validated candidates.
+     * @param num_accepted_candidates The number of candidates accepted by the main model.
+     */
+    void register_validation(uint64_t request_id, size_t num_candidates, size_t num_accepted_candidates);
+
+    /**
+     * Updates the duration model of the draft model step generating a candidate for each request of the batch.
+     */
+    void register_draft_step(float duration_ms);
+
+    /**
+     * Updates the duration model of the main model step validating the candidates.
+     * @param num_requests The number of requests in the batch.
+     * @param num_tokens The number of tokens processed by the main model, i.e. the candidates plus a token per request.
+     * @param duration_ms The duration of the step.
+     */
+    void register_main_step(size_t num_requests, size_t num_tokens, float duration_ms);
+
+    void remove_request(uint64_t request_id);
+
+    void remove_requests();
+
+    /**
+     * @return The number of candidates to be generated for the request at the next step,
+     * GenerationConfig::num_assistant_tokens if the request does not use the adaptive number of candidates or it is not measured yet.
+     */
+    size_t get_num_assistant_tokens(uint64_t request_id, const GenerationConfig& sampling_params) const;
+
+private:
+    // exponentially decayed counts of the accepted candidates and the rejections
+    struct Acceptance {
+        float num_accepted = 0.0f;
+        float num_rejected = 0.0f;
+    };
+    std::map<uint64_t, Acceptance> m_acceptance;
+
+    // negative until measured
+    float m_draft_step_duration_ms = -1.0f;
+
+    // exponentially decayed sums for the least squares fit of the main model step duration to the number of tokens
+    float m_main_weight = 0.0f, m_main_tokens = 0.0f, m_main_duration = 0.0f, m_main_tokens_sq = 0.0f, m_main_tokens_duration = 0.0f;
+    size_t m_num_requests = 1;
+};
+
+}  // namespace ov::genai
@@ -190,6 +190,8 @@ ContinuousBatchingPipeline::Eagle3DecodingImpl::Eagle3DecodingImpl(const ov::gen
 
     ov::AnyMap draft_properties =
         draft_model_desc.properties.empty() ? main_model_desc.properties : draft_model_desc.properties;
+    // candidates are not generated concurrently to the validation, as the draft model needs the hidden states of the main model
+    extract_concurrent_draft_from_config(draft_properties);
 
     // main and draft model use same tokenizer, but could differ in configurations
     // for example, llama3 draft model has different eos_token_id in config.json
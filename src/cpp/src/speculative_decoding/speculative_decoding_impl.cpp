@@ -1,12 +1,15 @@
 // Copyright (C) 2023-2025 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#include <condition_variable>
+#include <functional>
 #include <thread>
 
 #include "openvino/genai/text_streamer.hpp"
 #include "openvino/pass/sdpa_to_paged_attention.hpp"
 #include "speculative_decoding_impl.hpp"
 #include "continuous_batching/paged_attention_transformations.hpp"
+#include "threadpool.hpp"
 #include "utils.hpp"
 
 
@@ -14,6 +17,66 @@ namespace ov::genai {
 template<class... Ts> struct overloaded : Ts... {using Ts::operator()...;};
 template<class... Ts> overloaded(Ts...) -> overloaded<Ts...>;
 
+namespace {
+
+// Runs a function on the shared thread pool, the destructor waits for the function to finish
+class AsyncTask {
+public:
+    explicit AsyncTask(std::function<void()> function) : m_function(std::move(function)) {
+        ThreadPool::get_shared().submit({&AsyncTask::_run, this});
+    }
+
+    ~AsyncTask() {
+        _wait_for_finish();
+    }
+
+    // waits for the function to finish and rethrows its exception
+    void wait() {
+        _wait_for_finish();
+        if (m_exception) {
+            std::rethrow_exception(m_exception);
+        }
+    }
+
+private:
+    std::function<void()> m_function;
+    std::exception_ptr m_exception;
+    bool m_is_finished = false;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+
+    void _wait_for_finish() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this] { return m_is_finished; });
+    }
+
+    static void _run(void* context) {
+        auto* self = static_cast<AsyncTask*>(context);
+        std::exception_ptr exception;
+        try {
+            self->m_function();
+        } catch (...) {
+            exception = std::current_exception();
+        }
+        // the waiting thread may destroy the task as soon as the mutex is released
+        std::lock_guard<std::mutex> lock(self->m_mutex);
+        self->m_exception = exception;
+        self->m_is_finished = true;
+        self->m_cv.notify_all();
+    }
+};
+
+}  // namespace
+
+bool extract_concurrent_draft_from_config(ov::AnyMap& config) {
+    bool res = false;
+    if (config.find(ov::genai::concurrent_draft.name()) != config.end()) {
+        res = config.at(ov::genai::concurrent_draft.name()).as<bool>();
+        config.erase(ov::genai::concurrent_draft.name());
+    }
+    return res;
+}
+
 bool are_tokenizers_equal(Tokenizer& lhs, Tokenizer& rhs) {
     std::string test_string = "Could you please tell me something about OpenVINO.GenAI?";
     ov::Tensor encoded_string_lhs = lhs.encode(test_string).input_ids,
@@ -106,6 +169,7 @@ ContinuousBatchingPipeline::SpeculativeDecodingImpl::SpeculativeDecodingImpl(con
     OPENVINO_ASSERT(are_tokenizers_equal(main_model_tokenizer, draft_model_tokenizer), "Tokenizers for draft and main models are different!");
     m_tokenizer = main_model_tokenizer;
     ov::AnyMap draft_properties = draft_model_desc.properties.empty() ? main_model_desc.properties : draft_model_desc.properties;
+    m_is_concurrent_draft_enabled = extract_concurrent_draft_from_config(draft_properties);
     // to create `main_pipeline` with enabled validation_mode and `draft_pipeline` with disabled validation mode
     m_main_pipeline = std::make_shared<ContinuousBatchingForSpeculativeDecodingImpl>(
         main_model_desc.model, main_model_tokenizer, main_model_desc.generation_config,
@@ -172,9 +236,20 @@ void ContinuousBatchingPipeline::SpeculativeDecodingImpl::step() {
     m_draft_pipeline->pull_awaiting_requests(true);
     m_main_pipeline->pull_awaiting_requests();
 
+    auto& speculation_length_controller = m_draft_pipeline->speculation_length_controller;
+    // registers the durations of the draft model steps done since the given number of steps
+    auto register_draft_steps = [&](size_t num_draft_steps) {
+        const auto& draft_step_durations = m_draft_pipeline->raw_perf_metrics.m_durations;
+        for (size_t i = num_draft_steps; i < draft_step_durations.size(); ++i) {
+            speculation_length_controller.register_draft_step(draft_step_durations[i].count() / 1000.0f);
+        }
+    };
+
     // generate candidates by draft model
     const auto draft_start = std::chrono::steady_clock::now();
+    size_t num_draft_steps = m_draft_pipeline->raw_perf_metrics.m_durations.size();
     m_draft_pipeline->multistep();
+    register_draft_steps(num_draft_steps);
     const auto draft_end = std::chrono::steady_clock::now();
     m_sd_metrics.draft_duration += PerfMetrics::get_microsec(draft_end - draft_start) / 1e6;
     m_pipeline_metrics = m_main_pipeline->get_metrics();
@@ -189,19 +264,40 @@ void ContinuousBatchingPipeline::SpeculativeDecodingImpl::step() {
     }
 
     const auto main_start = std::chrono::steady_clock::now();
-    m_main_pipeline->step();
-    const auto main_end = std::chrono::steady_clock::now();
+    auto main_end = main_start;
+    if (m_is_concurrent_draft_enabled && m_draft_pipeline->resume_generation_ahead() > 0) {
+        // the draft model continues the candidates while the main model validates them,
+        // the continuation is kept as the next candidates if all the candidates are accepted
+        AsyncTask main_step([this, &main_end] {
+            m_main_pipeline->step();
+            main_end = std::chrono::steady_clock::now();
+        });
+        num_draft_steps = m_draft_pipeline->raw_perf_metrics.m_durations.size();
+        m_draft_pipeline->multistep();
+        register_draft_steps(num_draft_steps);
+        const auto draft_ahead_end = std::chrono::steady_clock::now();
+        main_step.wait();
+        // the time overlapped with the main step is already counted in main_duration,
+        // only the part of the draft steps outlasting it adds to the step time
+        if (draft_ahead_end > main_end) {
+            m_sd_metrics.draft_duration += PerfMetrics::get_microsec(draft_ahead_end - main_end) / 1e6;
+        }
+    } else {
+        m_main_pipeline->step();
+        main_end = std::chrono::steady_clock::now();
+    }
     const auto main_duration = PerfMetrics::get_microsec(main_end - main_start);
     m_sd_metrics.main_duration += main_duration / 1e6;
     m_pipeline_metrics = m_main_pipeline->get_metrics();
 
     auto main_generated_requests = m_main_pipeline->get_generated_requests();
     for (const auto& checked_sequence : main_generated_requests) {
-        auto update_result = m_draft_pipeline->update_request(checked_sequence.first, checked_sequence.second, true);
+        auto update_result = m_draft_pipeline->update_request(checked_sequence.first, checked_sequence.second, true, m_is_concurrent_draft_enabled);
         update_sequence_info[checked_sequence.first].removed_tokens_cnt = update_result.removed_tokens_cnt;
     }
 
     // finish draft request if the generation was completed
+    size_t num_validated_requests = 0, num_validated_tokens = 0;
     for (const auto& draft_request : draft_generated_requests) {
         auto request_id = draft_request.first;
         if (!main_generated_requests.count(request_id)) {
@@ -216,9 +312,26 @@ void ContinuousBatchingPipeline::SpeculativeDecodingImpl::step() {
         if (updated_seq_info.inserted_tokens_cnt == 0 || main_generated_requests.empty()) {
             continue;
         }
-        float acceptance_rate = 1 - static_cast<float>(updated_seq_info.removed_tokens_cnt) / updated_seq_info.inserted_tokens_cnt;
+        size_t num_accepted_tokens = updated_seq_info.inserted_tokens_cnt - updated_seq_info.removed_tokens_cnt;
+        auto main_request_it = main_generated_requests.find(request_id);
+        if (main_request_it != main_generated_requests.end() && !main_request_it->second.empty() && !draft_request.second.empty()) {
+            // the draft model could generate tokens ahead of the candidates, so the accepted ones are counted by the main model:
+            // the candidates followed the validated tokens and the main model appended a token to the accepted ones
+            const size_t num_validated_prefix_tokens = draft_request.second.begin()->second.token_ids.size() - updated_seq_info.inserted_tokens_cnt,
+                         main_generated_len = main_request_it->second.begin()->second.token_ids.size();
+            num_accepted_tokens = main_generated_len > num_validated_prefix_tokens ?
+                                  std::min(main_generated_len - num_validated_prefix_tokens - 1, updated_seq_info.inserted_tokens_cnt) : 0;
+            speculation_length_controller.register_validation(request_id, updated_seq_info.inserted_tokens_cnt, num_accepted_tokens);
+            ++num_validated_requests;
+            num_validated_tokens += updated_seq_info.inserted_tokens_cnt + 1;
+        }
+        float acceptance_rate = static_cast<float>(num_accepted_tokens) / updated_seq_info.inserted_tokens_cnt;
         m_sd_metrics.update_acceptance_rate(request_id, acceptance_rate * 100);
-        m_sd_metrics.update_draft_accepted_tokens(request_id, (updated_seq_info.inserted_tokens_cnt - updated_seq_info.removed_tokens_cnt));
+        m_sd_metrics.update_draft_accepted_tokens(request_id, num_accepted_tokens);
+    }
+    // the steps processing prompts do not follow the duration model of validation
+    if (num_validated_requests > 0 && num_validated_requests == main_generated_requests.size()) {
+        speculation_length_controller.register_main_step(num_validated_requests, num_validated_tokens, main_duration / 1000.0f);
     }
 
     const auto step_end = std::chrono::steady_clock::now();
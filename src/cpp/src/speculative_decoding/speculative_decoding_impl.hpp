@@ -11,6 +11,12 @@
 #include "utils.hpp"
 
 namespace ov::genai {
+/**
+ * Extracts the ov::genai::concurrent_draft property from the draft model properties.
+ * @return Whether the concurrent generation of candidates is requested.
+ */
+bool extract_concurrent_draft_from_config(ov::AnyMap& config);
+
 struct GenerateStrategy {
     std::function<void(size_t,
                        const ov::Tensor& in_ids,
@@ -74,7 +80,6 @@ std::vector<EncodedGenerationResult> generate_common(
     auto all_requests = self->get_awaiting_requests();
     GenerationHandle& generation = main_generations.at(0);
 
-    streamer_ptr->start();
     while (self->has_non_finished_requests()) {
         try {
             self->step();
@@ -146,6 +151,9 @@ protected:
     std::mutex m_draft_generations_mutex;
     std::map<uint64_t, GenerationHandle> m_draft_generations;
 
+    // whether the draft model generates the next candidates while the main model validates the current ones
+    bool m_is_concurrent_draft_enabled = false;
+
     void drop_requests();
     bool is_requests_empty();
     std::vector<SequenceGroup::Ptr> get_awaiting_requests();
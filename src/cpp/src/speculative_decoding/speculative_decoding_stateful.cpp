@@ -14,6 +14,7 @@ template<class... Ts> struct overloaded : Ts... {using Ts::operator()...;};
 template<class... Ts> overloaded(Ts...) -> overloaded<Ts...>;
 
 bool are_tokenizers_equal(ov::genai::Tokenizer& lhs, ov::genai::Tokenizer& rhs);
+bool extract_concurrent_draft_from_config(ov::AnyMap& config);
 } // ov::genai
 
 namespace {
@@ -388,6 +389,8 @@ StatefulSpeculativeLLMPipeline::StatefulSpeculativeLLMPipeline(
     if (draft_model_desc_copy.properties.empty() && (draft_model_desc_copy.device == main_model_desc.device)) {
         draft_model_desc_copy.properties = main_model_desc.properties;
     }
+    // the models run one after another in this pipeline
+    extract_concurrent_draft_from_config(draft_model_desc_copy.properties);
     m_draft_request = std::make_unique<LLMInferWrapper>(draft_model_desc_copy);
     OPENVINO_ASSERT(m_draft_request != nullptr, "Failed to create draft model inference wrapper");
 
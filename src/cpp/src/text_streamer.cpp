@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "openvino/genai/text_streamer.hpp"
+#include "text_streamer_impl.hpp"
 
 namespace {
 bool is_incomplete(std::string& text) {
@@ -12,6 +13,9 @@ bool is_incomplete(std::string& text) {
 
 constexpr size_t delay_n_tokens = 3;
 
+// the number of printed tokens which are decoded again with each new token before the window start is moved
+constexpr size_t max_window_context_tokens = 16;
+
 }  // namespace
 
 namespace ov {
@@ -23,22 +27,31 @@ TextStreamer::TextStreamer(const Tokenizer& tokenizer,
     m_tokenizer = tokenizer;
     m_subword_callback = std::move(callback);
     m_additional_detokenization_params = detokenization_params;
+    m_impl = std::make_unique<TextStreamerImpl>([this](const std::vector<int64_t>& tokens) {
+        return m_tokenizer.decode(tokens, m_additional_detokenization_params);
+    });
 }
 
+TextStreamer::~TextStreamer() = default;
+
 StreamingStatus TextStreamer::write(int64_t token) {
     std::stringstream res;
     m_tokens_cache.push_back(token);
-    std::string text = m_tokenizer.decode(m_tokens_cache, m_additional_detokenization_params);
-    m_decoded_lengths.push_back(text.length());
+    std::string text = m_impl->decode_window(m_tokens_cache, m_tokens_cache.size());
+    const size_t text_len = m_impl->get_text_len(text.size());
+    m_decoded_lengths.push_back(text_len);
+    // the text of the window starts inside the printed text
+    const size_t printed_window_len = m_impl->get_window_text_len(m_printed_len);
 
-    if (!text.empty() && '\n' == text.back() && text.size() > m_printed_len) {
+    if (!text.empty() && '\n' == text.back() && text_len > m_printed_len) {
         // Flush the cache after the new line symbol
-        res << std::string_view{text.data() + m_printed_len, text.size() - m_printed_len};
+        res << std::string_view{text.data() + printed_window_len, text.size() - printed_window_len};
 
         auto res_status = run_callback_if_needed(res.str());
         m_tokens_cache.clear();
         m_decoded_lengths.clear();
         m_printed_len = 0;
+        m_impl->reset();
         return res_status;
     }
 
@@ -55,14 +68,15 @@ StreamingStatus TextStreamer::write(int64_t token) {
         return run_callback_if_needed(res.str());
     }
 
-    compute_decoded_length_for_position(m_decoded_lengths.size() - delay_n_tokens);
+    const size_t print_position = m_decoded_lengths.size() - delay_n_tokens;
+    compute_decoded_length_for_position(print_position);
 
-    auto print_until = m_decoded_lengths[m_decoded_lengths.size() - delay_n_tokens];
+    auto print_until = std::min(m_decoded_lengths[print_position], static_cast<int64_t>(text_len));
 
     if (print_until > -1 && print_until > m_printed_len) {
         // It is possible to have a shorter text after adding new token.
         // Print to output only if text length is increased.
-        res << std::string_view{text.data() + m_printed_len, print_until - m_printed_len} << std::flush;
+        res << std::string_view{text.data() + printed_window_len, print_until - m_printed_len} << std::flush;
     }
     
     auto status = run_callback_if_needed(res.str());
@@ -70,6 +84,9 @@ StreamingStatus TextStreamer::write(int64_t token) {
     if (print_until > -1 && print_until > m_printed_len) {
         m_printed_len = print_until;
     }
+    if (m_decoded_lengths[print_position] > -1 && m_decoded_lengths[print_position] <= m_printed_len) {
+        m_impl->move_window(m_tokens_cache, print_position, m_decoded_lengths[print_position]);
+    }
     return status;
 }
 
@@ -79,13 +96,12 @@ void TextStreamer::compute_decoded_length_for_position(size_t cache_position) {
         return;
     }
 
-    auto cache_for_position = std::vector(m_tokens_cache.begin(), m_tokens_cache.begin() + cache_position + 1);
-    std::string text_for_position = m_tokenizer.decode(cache_for_position, m_additional_detokenization_params);
+    std::string text_for_position = m_impl->decode_window(m_tokens_cache, cache_position + 1);
 
     if (is_incomplete(text_for_position)) {
         m_decoded_lengths[cache_position] = -1;
     } else {
-        m_decoded_lengths[cache_position] = text_for_position.size();
+        m_decoded_lengths[cache_position] = m_impl->get_text_len(text_for_position.size());
     }
 };
 
@@ -119,20 +135,58 @@ StreamingStatus TextStreamer::run_callback_if_needed(const std::string& text) {
 }
 
 void TextStreamer::end() {
+    if (m_tokens_cache.empty())
+        return;
     std::stringstream res;
-    std::string text = m_tokenizer.decode(m_tokens_cache, m_additional_detokenization_params);
-    if (text.size() <= m_printed_len)
+    std::string text = m_impl->decode_window(m_tokens_cache, m_tokens_cache.size());
+    if (m_impl->get_text_len(text.size()) <= m_printed_len)
         return;
-    res << std::string_view{text.data() + m_printed_len, text.size() - m_printed_len} << std::flush;
+    const size_t printed_window_len = m_impl->get_window_text_len(m_printed_len);
+    res << std::string_view{text.data() + printed_window_len, text.size() - printed_window_len} << std::flush;
     m_tokens_cache.clear();
     m_decoded_lengths.clear();
     m_printed_len = 0;
+    m_impl->reset();
     m_subword_callback(res.str());
     return;
 }
 
 StreamerBase::~StreamerBase() = default;
 
+std::string TextStreamer::TextStreamerImpl::decode_window(const std::vector<int64_t>& tokens, size_t end_position) const {
+    OPENVINO_ASSERT(m_window_start < end_position && end_position <= tokens.size());
+    return m_decode(std::vector<int64_t>(tokens.begin() + m_window_start, tokens.begin() + end_position));
+}
+
+size_t TextStreamer::TextStreamerImpl::get_text_len(size_t window_text_len) const {
+    // the text of the context can be shortened by the following tokens
+    return window_text_len + m_window_offset > m_window_context_len ? window_text_len + m_window_offset - m_window_context_len : 0;
+}
+
+size_t TextStreamer::TextStreamerImpl::get_window_text_len(size_t text_len) const {
+    return text_len - m_window_offset + m_window_context_len;
+}
+
+void TextStreamer::TextStreamerImpl::move_window(const std::vector<int64_t>& tokens, size_t printed_position, size_t text_len) {
+    if (printed_position < m_window_start + max_window_context_tokens) {
+        return;
+    }
+    // the context is decoded alone, as some detokenizers remove the leading space of the first token
+    std::string context_text = m_decode(std::vector<int64_t>{tokens[printed_position]});
+    if (is_incomplete(context_text)) {
+        return;
+    }
+    m_window_start = printed_position;
+    m_window_offset = text_len;
+    m_window_context_len = context_text.size();
+}
+
+void TextStreamer::TextStreamerImpl::reset() {
+    m_window_start = 0;
+    m_window_offset = 0;
+    m_window_context_len = 0;
+}
+
 // Is used to hide internal states of TextParserStreamer
 class TextParserStreamer::TextParserStreamerImpl {
 public:
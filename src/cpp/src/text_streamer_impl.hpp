@@ -0,0 +1,53 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "openvino/genai/text_streamer.hpp"
+
+namespace ov::genai {
+
+/**
+ * @brief Hides the state of decoding the tokens cache of TextStreamer from a window start, so that the decoded text
+ * does not grow with the tokens cache. The first token of the window is already printed and only gives the context
+ * to the following ones. The lengths of the window text are mapped to the lengths of the text of the whole cache,
+ * so the decoded lengths and the printed length of TextStreamer keep their meaning.
+ */
+class TextStreamer::TextStreamerImpl {
+public:
+    using DecodeFunction = std::function<std::string(const std::vector<int64_t>&)>;
+
+    explicit TextStreamerImpl(DecodeFunction decode) : m_decode(std::move(decode)) {}
+
+    // decodes the tokens from the window start to the given position (exclusive)
+    std::string decode_window(const std::vector<int64_t>& tokens, size_t end_position) const;
+
+    // the length of the text of the tokens cache corresponding to the text decoded from the window start
+    size_t get_text_len(size_t window_text_len) const;
+
+    // the length of the text decoded from the window start corresponding to the text of the tokens cache
+    size_t get_window_text_len(size_t text_len) const;
+
+    // moves the window start to the printed position if the window is long enough,
+    // the text of the tokens up to the position (inclusive) is text_len long
+    void move_window(const std::vector<int64_t>& tokens, size_t printed_position, size_t text_len);
+
+    void reset();
+
+private:
+    DecodeFunction m_decode;
+
+    // the text of the window start token is m_window_context_len long when decoded alone
+    // and ends at m_window_offset in the text of the tokens cache
+    size_t m_window_start = 0;
+    size_t m_window_offset = 0;
+    size_t m_window_context_len = 0;
+};
+
+}  // namespace ov::genai
@@ -0,0 +1,160 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include "threadpool.hpp"
+
+namespace ov::genai {
+
+namespace {
+
+// the pool and the index of the worker running on the current thread
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local size_t current_worker_id = 0;
+
+size_t get_num_available_cpus() {
+#ifdef __linux__
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0) {
+        return static_cast<size_t>(CPU_COUNT(&cpu_set));
+    }
+#endif
+    return std::thread::hardware_concurrency();
+}
+
+}  // namespace
+
+ThreadPool::ThreadPool(size_t num_threads, size_t queue_capacity) {
+    for (size_t i = 0; i < num_threads; ++i) {
+        m_queues.push_back(std::make_unique<WorkerQueue>());
+        m_queues.back()->jobs.resize(std::max<size_t>(queue_capacity, 1));
+    }
+    for (size_t i = 0; i < num_threads; ++i) {
+        m_threads.emplace_back(&ThreadPool::_worker_loop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleep_mutex);
+        m_stop = true;
+    }
+    m_sleep_cv.notify_all();
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+ThreadPool& ThreadPool::get_shared() {
+    // the calling thread takes part in parallel_for, so one CPU is left to it;
+    // workers are not pinned to CPUs to avoid competing with the thread binding of the inference plugins.
+    // The pool is intentionally never destroyed: jobs may still be submitted from destructors of other static objects.
+    static ThreadPool* shared_pool = new ThreadPool(std::max<size_t>(get_num_available_cpus(), 2) - 1);
+    return *shared_pool;
+}
+
+void ThreadPool::submit(Job job) {
+    if (m_queues.empty()) {
+        job.function(job.context);
+        return;
+    }
+
+    size_t queue_id = current_pool == this ? current_worker_id : m_next_queue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+    WorkerQueue& queue = *m_queues[queue_id];
+    // counted before the job becomes visible, so that a worker taking it never sees the counter at zero
+    m_num_pending_jobs.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.size < queue.jobs.size()) {
+            queue.jobs[(queue.begin + queue.size) % queue.jobs.size()] = job;
+            ++queue.size;
+            job.function = nullptr;
+        }
+    }
+
+    if (job.function != nullptr) {
+        // the queue is full, the job is executed right away instead of growing the queue
+        m_num_pending_jobs.fetch_sub(1);
+        job.function(job.context);
+        return;
+    }
+
+    // pairs with the check of the pending jobs by a worker going to sleep
+    if (m_num_sleeping_workers.load() > 0) {
+        std::lock_guard<std::mutex> lock(m_sleep_mutex);
+        m_sleep_cv.notify_one();
+    }
+}
+
+bool ThreadPool::_try_pop(size_t worker_id, Job& job) {
+    // the most recently submitted job of the own queue is the most likely one to have its data in cache
+    {
+        WorkerQueue& queue = *m_queues[worker_id];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.size > 0) {
+            --queue.size;
+            job = queue.jobs[(queue.begin + queue.size) % queue.jobs.size()];
+            return true;
+        }
+    }
+    // the oldest jobs of the neighbours are stolen
+    for (size_t offset = 1; offset < m_queues.size(); ++offset) {
+        WorkerQueue& queue = *m_queues[(worker_id + offset) % m_queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.size > 0) {
+            job = queue.jobs[queue.begin];
+            queue.begin = (queue.begin + 1) % queue.jobs.size();
+            --queue.size;
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t ThreadPool::_cancel(void* context) {
+    size_t num_cancelled = 0;
+    for (auto& queue : m_queues) {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        for (size_t i = 0; i < queue->size; ++i) {
+            Job& job = queue->jobs[(queue->begin + i) % queue->jobs.size()];
+            if (job.context == context && job.function != nullptr) {
+                // the slot is released when a worker takes it
+                job.function = nullptr;
+                ++num_cancelled;
+            }
+        }
+    }
+    return num_cancelled;
+}
+
+void ThreadPool::_worker_loop(size_t worker_id) {
+    current_pool = this;
+    current_worker_id = worker_id;
+
+    while (true) {
+        Job job;
+        if (_try_pop(worker_id, job)) {
+            m_num_pending_jobs.fetch_sub(1);
+            if (job.function != nullptr) {
+                job.function(job.context);
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleep_mutex);
+        m_num_sleeping_workers.fetch_add(1);
+        m_sleep_cv.wait(lock, [this] {
+            return m_stop || m_num_pending_jobs.load() > 0;
+        });
+        m_num_sleeping_workers.fetch_sub(1);
+        if (m_stop && m_num_pending_jobs.load() == 0) {
+            return;
+        }
+    }
+}
+
+}
@@ -0,0 +1,178 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ov::genai {
+
+/**
+ * @brief Work-stealing thread pool shared by the host-side parts of the pipelines (sampling, streaming, feature extraction),
+ * so that they use a single set of threads instead of each component creating its own on top of the inference threads.
+ * Each worker has its own job queue: a worker takes the most recently pushed job from its own queue and steals the oldest
+ * job from the queues of other workers (starting with its neighbours) when its own queue is empty.
+ * Jobs are plain function pointers with a context, so that submitting a job does not allocate; the caller keeps the context
+ * alive until the job has finished.
+ */
+class ThreadPool {
+public:
+    struct Job {
+        void (*function)(void* context) = nullptr;
+        void* context = nullptr;
+    };
+
+    /**
+     * @param num_threads The number of worker threads.
+     * @param queue_capacity The maximum number of pending jobs per worker, a job submitted to a full queue is executed by the caller.
+     */
+    explicit ThreadPool(size_t num_threads, size_t queue_capacity = 1024);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @return The process-wide pool with a worker per CPU available to the process (according to its affinity mask).
+     */
+    static ThreadPool& get_shared();
+
+    size_t get_num_threads() const {
+        return m_threads.size();
+    }
+
+    /**
+     * Schedules a job for asynchronous execution. Jobs submitted from a worker go to the queue of that worker.
+     * @param job The job, its context must stay valid until the job has finished.
+     */
+    void submit(Job job);
+
+    /**
+     * Calls function(i) for each i in [0, n) using the calling thread and up to max_concurrency - 1 workers, and waits for
+     * all calls to finish. The first exception thrown by a call is rethrown after all calls have finished.
+     * Can be called from a worker thread.
+     * @param n The number of iterations.
+     * @param function The function to be called for each iteration.
+     * @param max_concurrency The maximum number of threads running the iterations, including the calling thread.
+     */
+    template <typename F>
+    void parallel_for(size_t n, F&& function, size_t max_concurrency = std::numeric_limits<size_t>::max()) {
+        if (n == 0) {
+            return;
+        }
+        size_t num_helpers = std::min({n, max_concurrency, get_num_threads() + 1}) - 1;
+        if (num_helpers == 0) {
+            for (size_t i = 0; i < n; ++i) {
+                function(i);
+            }
+            return;
+        }
+
+        ParallelForContext<std::remove_reference_t<F>> context(function, n, num_helpers);
+        for (size_t i = 0; i < num_helpers; ++i) {
+            submit({&ParallelForContext<std::remove_reference_t<F>>::run_helper, &context});
+        }
+        context.run();
+        // helpers which have not started yet are not needed anymore, they must not be waited for
+        context.finish_helpers(_cancel(&context));
+        context.wait();
+    }
+
+private:
+    struct ParallelForState {
+        size_t n;
+        std::atomic<size_t> next_index{0};
+        size_t num_running_helpers;
+        std::exception_ptr exception;
+        std::mutex mutex;
+        std::condition_variable cv;
+
+        ParallelForState(size_t n, size_t num_helpers) : n(n), num_running_helpers(num_helpers) {}
+
+        void finish_helpers(size_t num_finished) {
+            if (num_finished == 0) {
+                return;
+            }
+            // the waiting thread may destroy the state as soon as the mutex is released
+            std::lock_guard<std::mutex> lock(mutex);
+            num_running_helpers -= num_finished;
+            if (num_running_helpers == 0) {
+                cv.notify_one();
+            }
+        }
+
+        void set_exception(std::exception_ptr current_exception) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!exception) {
+                exception = current_exception;
+            }
+            // the remaining iterations are skipped
+            next_index.store(n);
+        }
+
+        void wait() {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [this] { return num_running_helpers == 0; });
+            if (exception) {
+                std::rethrow_exception(exception);
+            }
+        }
+    };
+
+    template <typename F>
+    struct ParallelForContext : ParallelForState {
+        F& function;
+
+        ParallelForContext(F& function, size_t n, size_t num_helpers) : ParallelForState(n, num_helpers), function(function) {}
+
+        void run() {
+            try {
+                for (size_t i = next_index.fetch_add(1); i < n; i = next_index.fetch_add(1)) {
+                    function(i);
+                }
+            } catch (...) {
+                set_exception(std::current_exception());
+            }
+        }
+
+        static void run_helper(void* context) {
+            auto* self = static_cast<ParallelForContext*>(context);
+            self->run();
+            self->finish_helpers(1);
+        }
+    };
+
+    // fixed-capacity ring of jobs, guarded by a per-worker mutex
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::vector<Job> jobs;
+        size_t begin = 0, size = 0;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    std::vector<std::thread> m_threads;
+    // queue for the next job submitted from outside of the pool
+    std::atomic<size_t> m_next_queue{0};
+
+    std::atomic<size_t> m_num_pending_jobs{0};
+    std::atomic<size_t> m_num_sleeping_workers{0};
+    std::mutex m_sleep_mutex;
+    std::condition_variable m_sleep_cv;
+    bool m_stop = false;
+
+    void _worker_loop(size_t worker_id);
+    bool _try_pop(size_t worker_id, Job& job);
+    size_t _cancel(void* context);
+};
+
+}
@@ -0,0 +1,202 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <iterator>
+#include <regex>
+#include <tuple>
+
+#include "openvino/core/except.hpp"
+#include "tokenizer/incremental_chat_tokenizer.hpp"
+
+namespace ov::genai {
+
+namespace {
+
+// the text around a candidate marker when checking that it is encoded independently
+const std::vector<std::string> MARKER_PROBES = {"x", " x", "\nx"};
+
+}  // namespace
+
+IncrementalChatTokenizer::IncrementalChatTokenizer(const Tokenizer& tokenizer) : m_tokenizer(tokenizer) {
+    m_encode = [tokenizer = tokenizer](const std::string& text) mutable {
+        const ov::Tensor input_ids = tokenizer.encode(text, ov::genai::add_special_tokens(false)).input_ids;
+        return std::vector<int64_t>(input_ids.data<int64_t>(), input_ids.data<int64_t>() + input_ids.get_size());
+    };
+}
+
+IncrementalChatTokenizer::IncrementalChatTokenizer(EncodeFunction encode, const std::map<std::string, int64_t>& markers)
+    : m_encode(std::move(encode)) {
+    _set_markers(markers);
+}
+
+std::set<std::string> IncrementalChatTokenizer::find_marker_candidates(const std::string& chat_template) {
+    static const std::regex marker_regex(R"(<\|[^<>|\s]+\|>|<[^<>|\s'"{}%]+>|\[/?[A-Z_]+\])");
+    std::set<std::string> candidates;
+    for (auto it = std::sregex_iterator(chat_template.begin(), chat_template.end(), marker_regex); it != std::sregex_iterator(); ++it) {
+        candidates.insert(it->str());
+    }
+    return candidates;
+}
+
+void IncrementalChatTokenizer::_set_markers(const std::map<std::string, int64_t>& markers) {
+    m_markers.clear();
+    m_marker_ids.clear();
+    m_max_marker_size = 0;
+    for (const auto& [text, token_id] : markers) {
+        if (text.empty()) {
+            continue;
+        }
+        m_markers.push_back({text, token_id});
+        m_marker_ids.insert(token_id);
+        m_max_marker_size = std::max(m_max_marker_size, text.size());
+    }
+    std::stable_sort(m_markers.begin(), m_markers.end(), [](const Marker& lhs, const Marker& rhs) {
+        return lhs.text.size() > rhs.text.size();
+    });
+    reset();
+}
+
+std::optional<int64_t> IncrementalChatTokenizer::_get_marker_id(const std::string& text) const {
+    const std::vector<int64_t> token_ids = m_encode(text);
+    if (token_ids.size() != 1) {
+        return std::nullopt;
+    }
+    const int64_t token_id = token_ids[0];
+    for (const auto& probe : MARKER_PROBES) {
+        // the text before the marker is encoded independently, and the text after it is encoded as if it started with the marker
+        std::vector<int64_t> expected = m_encode(probe);
+        const std::vector<int64_t> marker_and_probe = m_encode(text + probe);
+        if (marker_and_probe.empty() || marker_and_probe[0] != token_id) {
+            return std::nullopt;
+        }
+        expected.insert(expected.end(), marker_and_probe.begin(), marker_and_probe.end());
+        if (m_encode(probe + text + probe) != expected) {
+            return std::nullopt;
+        }
+    }
+    return token_id;
+}
+
+void IncrementalChatTokenizer::_update_markers() {
+    if (!m_tokenizer) {
+        return;
+    }
+    std::string chat_template = m_tokenizer->get_chat_template();
+    if (m_chat_template == chat_template) {
+        return;
+    }
+    std::set<std::string> candidates = find_marker_candidates(chat_template);
+    // bos and eos tokens are usually added by the chat template
+    for (const auto& special_token : {m_tokenizer->get_bos_token(), m_tokenizer->get_eos_token()}) {
+        if (!special_token.empty()) {
+            candidates.insert(special_token);
+        }
+    }
+    std::map<std::string, int64_t> markers;
+    for (const auto& candidate : candidates) {
+        if (auto token_id = _get_marker_id(candidate)) {
+            markers.emplace(candidate, *token_id);
+        }
+    }
+    _set_markers(markers);
+    m_chat_template = std::move(chat_template);
+}
+
+void IncrementalChatTokenizer::reset() {
+    m_text.clear();
+    m_token_ids.clear();
+    m_marker_positions.clear();
+    m_is_aligned = true;
+    m_is_verified = false;
+}
+
+void IncrementalChatTokenizer::_disable_markers() {
+    m_markers.clear();
+    m_marker_ids.clear();
+    m_max_marker_size = 0;
+    m_marker_positions.clear();
+}
+
+void IncrementalChatTokenizer::_find_markers(size_t text_begin, size_t token_begin) {
+    size_t token_position = token_begin;
+    for (size_t text_position = text_begin; text_position < m_text.size() && m_is_aligned;) {
+        auto marker_it = std::find_if(m_markers.begin(), m_markers.end(), [&](const Marker& marker) {
+            return m_text.compare(text_position, marker.text.size(), marker.text) == 0;
+        });
+        if (marker_it == m_markers.end()) {
+            ++text_position;
+            continue;
+        }
+        while (token_position < m_token_ids.size() && !m_marker_ids.count(m_token_ids[token_position])) {
+            ++token_position;
+        }
+        // the marker in the text is not encoded as the marker token, e.g. it is a part of a longer special token
+        m_is_aligned = token_position < m_token_ids.size() && m_token_ids[token_position] == marker_it->token_id;
+        m_marker_positions.emplace_back(text_position, token_position);
+        text_position += marker_it->text.size();
+        ++token_position;
+    }
+    m_is_aligned = m_is_aligned && std::none_of(m_token_ids.begin() + std::min(token_position, m_token_ids.size()), m_token_ids.end(),
+                                                [&](int64_t token_id) {
+                                                    return m_marker_ids.count(token_id) > 0;
+                                                });
+}
+
+std::vector<int64_t> IncrementalChatTokenizer::encode_ids(const std::string& templated_history) {
+    _update_markers();
+
+    const size_t common_prefix_size = std::mismatch(m_text.begin(), m_text.begin() + std::min(m_text.size(), templated_history.size()),
+                                                    templated_history.begin()).first - m_text.begin();
+    // the marker is followed by at least m_max_marker_size unchanged bytes, so the same marker is found at the same position of the new text
+    auto marker_it = m_marker_positions.begin();
+    if (m_is_aligned && !m_markers.empty() && common_prefix_size >= m_max_marker_size) {
+        marker_it = std::upper_bound(m_marker_positions.begin(), m_marker_positions.end(), common_prefix_size - m_max_marker_size,
+                                     [](size_t position, const std::pair<size_t, size_t>& marker_position) {
+                                         return position < marker_position.first;
+                                     });
+    }
+
+    size_t text_begin = 0, token_begin = 0;
+    if (marker_it != m_marker_positions.begin()) {
+        std::tie(text_begin, token_begin) = *std::prev(marker_it);
+        m_marker_positions.erase(std::prev(marker_it), m_marker_positions.end());
+        m_token_ids.resize(token_begin);
+        const std::vector<int64_t> new_token_ids = m_encode(templated_history.substr(text_begin));
+        m_token_ids.insert(m_token_ids.end(), new_token_ids.begin(), new_token_ids.end());
+    } else {
+        m_marker_positions.clear();
+        m_token_ids = m_encode(templated_history);
+        m_is_aligned = true;
+    }
+    m_text = templated_history;
+    _find_markers(text_begin, token_begin);
+
+#ifdef NDEBUG
+    const bool verify = text_begin > 0 && !m_is_verified;
+#else
+    const bool verify = text_begin > 0;
+#endif
+    if (verify) {
+        std::vector<int64_t> token_ids = m_encode(m_text);
+        if (token_ids != m_token_ids) {
+            // the markers passed the check, but the tokenizer still encodes the text after them differently,
+            // e.g. it adds a prefix to each text, so the whole history is encoded from now on
+            _disable_markers();
+            m_token_ids = std::move(token_ids);
+        }
+        m_is_verified = true;
+    }
+    return m_token_ids;
+}
+
+TokenizedInputs IncrementalChatTokenizer::encode(const std::string& templated_history) {
+    std::vector<int64_t> token_ids = encode_ids(templated_history);
+    ov::Tensor input_ids(ov::element::i64, {1, token_ids.size()});
+    std::copy(token_ids.begin(), token_ids.end(), input_ids.data<int64_t>());
+    ov::Tensor attention_mask(ov::element::i64, {1, token_ids.size()});
+    std::fill_n(attention_mask.data<int64_t>(), attention_mask.get_size(), 1);
+    return {input_ids, attention_mask};
+}
+
+}  // namespace ov::genai
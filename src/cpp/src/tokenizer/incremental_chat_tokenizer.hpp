@@ -0,0 +1,92 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "openvino/genai/tokenizer.hpp"
+
+namespace ov::genai {
+
+/**
+ * @brief Encodes the templated chat history of a chat session, re-encoding only the text after the last unchanged marker.
+ * A marker is a special token of the chat template, e.g. <|im_start|>, which the tokenizer never merges with the text
+ * around it, so the text before a marker is encoded independently of the text after it. The history is re-rendered at
+ * each turn and differs from the previous one only at the end, so the tokens up to the last marker in the unchanged
+ * prefix are reused and only the rest is encoded. If there is no such marker, the whole history is encoded.
+ * The markers are the special tokens of the chat template which pass a check that the tokenizer encodes the text
+ * around them independently. The first incremental encode of each session is verified against encoding the whole
+ * history, and if they differ, the markers are disabled and the whole history is encoded at each turn. In debug builds,
+ * each incremental encode is verified.
+ * The history is encoded without special tokens, as the chat template adds them.
+ */
+class IncrementalChatTokenizer {
+public:
+    using EncodeFunction = std::function<std::vector<int64_t>(const std::string&)>;
+
+    // the markers are found in the chat template of the tokenizer on the first encode() and whenever the chat template changes
+    explicit IncrementalChatTokenizer(const Tokenizer& tokenizer);
+
+    // the markers are used as is, without checking them
+    IncrementalChatTokenizer(EncodeFunction encode, const std::map<std::string, int64_t>& markers);
+
+    TokenizedInputs encode(const std::string& templated_history);
+
+    std::vector<int64_t> encode_ids(const std::string& templated_history);
+
+    // drops the previous history, e.g. at the end of the chat
+    void reset();
+
+    // the candidate markers of a chat template: <|...|>, <...> and [...] tags
+    static std::set<std::string> find_marker_candidates(const std::string& chat_template);
+
+private:
+    struct Marker {
+        std::string text;
+        int64_t token_id;
+    };
+
+    void _set_markers(const std::map<std::string, int64_t>& markers);
+
+    void _update_markers();
+
+    // the markers are dropped, e.g. if an incremental encode differs from encoding the whole history
+    void _disable_markers();
+
+    // the token of the text if the text is a single token which is encoded independently of the text around it
+    std::optional<int64_t> _get_marker_id(const std::string& text) const;
+
+    // finds the markers of m_text and m_token_ids starting from the given text and token positions
+    void _find_markers(size_t text_begin, size_t token_begin);
+
+    std::optional<Tokenizer> m_tokenizer;
+    std::optional<std::string> m_chat_template;
+    EncodeFunction m_encode;
+
+    // sorted by length in descending order, so the longest marker is matched
+    std::vector<Marker> m_markers;
+    std::unordered_set<int64_t> m_marker_ids;
+    size_t m_max_marker_size = 0;
+
+    // the previous history and its tokens
+    std::string m_text;
+    std::vector<int64_t> m_token_ids;
+    // the start of each marker in m_text and the position of its token in m_token_ids
+    std::vector<std::pair<size_t, size_t>> m_marker_positions;
+    // false if the markers of the text and the tokens do not match, so the tokens can not be reused
+    bool m_is_aligned = true;
+    // true if an incremental encode of the session matched encoding the whole history
+    bool m_is_verified = false;
+};
+
+}  // namespace ov::genai
@@ -0,0 +1,123 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "openvino/core/except.hpp"
+
+namespace ov::genai {
+
+/**
+ * @brief Coalesces concurrent calls with the same key into batches, so that e.g. many single prompt tokenizer calls run as
+ * one batched inference. The first call of a batch becomes its leader, which executes the batch for all of its calls.
+ * If all the max_concurrency batches are being executed, the leader waits for more calls up to the window or until the
+ * batch is full, otherwise it executes the batch immediately, so sequential calls are never delayed.
+ * The other calls of the batch wait for the leader and get their outputs or the exception thrown by the batch.
+ */
+template <typename Input, typename Output>
+class RequestCoalescer {
+public:
+    // gets the inputs of a batch and returns an output per input
+    using BatchFunction = std::function<std::vector<Output>(const std::vector<const Input*>&)>;
+
+    RequestCoalescer(std::chrono::microseconds window, size_t max_batch_size, size_t max_concurrency)
+        : m_window(window), m_max_batch_size(max_batch_size), m_max_concurrency(max_concurrency) {
+        OPENVINO_ASSERT(max_batch_size > 0 && max_concurrency > 0, "max_batch_size and max_concurrency should be greater than 0");
+    }
+
+    RequestCoalescer(const RequestCoalescer&) = delete;
+    RequestCoalescer& operator=(const RequestCoalescer&) = delete;
+
+    /**
+     * Adds the input to the pending batch of the key and waits for the batch to be executed.
+     * @param run_batch The function executing the batch, only the function of the leader is called, so the calls with
+     * the same key should pass equivalent functions.
+     */
+    Output submit(const std::string& key, const Input& input, const BatchFunction& run_batch) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        auto pending_it = m_pending_batches.find(key);
+        if (pending_it != m_pending_batches.end()) {
+            std::shared_ptr<Batch> batch = pending_it->second;
+            const size_t index = batch->inputs.size();
+            batch->inputs.push_back(&input);
+            if (batch->inputs.size() == m_max_batch_size) {
+                // the next calls start a new batch
+                m_pending_batches.erase(pending_it);
+                m_cv.notify_all();
+            }
+            m_cv.wait(lock, [&batch] {
+                return batch->is_done;
+            });
+            if (batch->exception) {
+                std::rethrow_exception(batch->exception);
+            }
+            return std::move(batch->outputs[index]);
+        }
+
+        std::shared_ptr<Batch> batch = std::make_shared<Batch>();
+        batch->inputs.push_back(&input);
+        if (m_max_batch_size > 1) {
+            m_pending_batches.emplace(key, batch);
+            m_cv.wait_for(lock, m_window, [this, &batch] {
+                return batch->inputs.size() == m_max_batch_size || m_num_running_batches < m_max_concurrency;
+            });
+            auto it = m_pending_batches.find(key);
+            if (it != m_pending_batches.end() && it->second == batch) {
+                m_pending_batches.erase(it);
+            }
+        }
+        ++m_num_running_batches;
+        lock.unlock();
+
+        // the inputs are not changed after the batch is removed from the pending ones
+        std::vector<Output> outputs;
+        std::exception_ptr exception;
+        try {
+            outputs = run_batch(batch->inputs);
+            OPENVINO_ASSERT(outputs.size() == batch->inputs.size(), "The batch function should return an output per input");
+        } catch (...) {
+            exception = std::current_exception();
+        }
+
+        lock.lock();
+        batch->outputs = std::move(outputs);
+        batch->exception = exception;
+        batch->is_done = true;
+        --m_num_running_batches;
+        m_cv.notify_all();
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+        return std::move(batch->outputs[0]);
+    }
+
+private:
+    struct Batch {
+        std::vector<const Input*> inputs;
+        std::vector<Output> outputs;
+        std::exception_ptr exception;
+        bool is_done = false;
+    };
+
+    const std::chrono::microseconds m_window;
+    const size_t m_max_batch_size;
+    const size_t m_max_concurrency;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::unordered_map<std::string, std::shared_ptr<Batch>> m_pending_batches;
+    size_t m_num_running_batches = 0;
+};
+
+}  // namespace ov::genai
@@ -1,14 +1,60 @@
 // Copyright (C) 2025 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#include <cctype>
+
 #include "tokenizer/tokenizer_impl.hpp"
 #include "add_second_input_pass.hpp"
 #include "sampling/structured_output/structured_output_controller.hpp"
 #include "openvino/genai/version.hpp"
+#include "threadpool.hpp"
 
 namespace ov {
 namespace genai {
 
+namespace {
+
+// concurrent calls are coalesced while all the infer requests are busy
+constexpr std::chrono::microseconds COALESCING_WINDOW{200};
+constexpr size_t MAX_COALESCED_BATCH_SIZE = 64;
+
+// texts of at least LONG_TEXT_SIZE bytes are split at line breaks into chunks of about LONG_TEXT_CHUNK_SIZE bytes,
+// which are encoded in parallel, if the wider check of any split fails, the text is encoded at once
+constexpr size_t LONG_TEXT_SIZE = 100000;
+constexpr size_t LONG_TEXT_CHUNK_SIZE = 16384;
+constexpr size_t MAX_SPLIT_CANDIDATES = 4;
+// the number of bytes on each side of a split which are encoded to check the split
+constexpr size_t SPLIT_CHECK_WINDOW = 256;
+// the accepted splits are checked again with a wider window while the chunks are encoded
+constexpr size_t SPLIT_VERIFY_WINDOW = 4 * SPLIT_CHECK_WINDOW;
+
+// the add_special_tokens flag if the other parameters are not set, as they change the padding of a batch
+std::optional<bool> get_batchable_add_special_tokens(const ov::AnyMap& tokenization_params) {
+    for (const auto& [name, value] : tokenization_params) {
+        if (name != add_special_tokens.name()) {
+            return std::nullopt;
+        }
+    }
+    bool add_special_tokens_flag = true;
+    ov::genai::utils::read_anymap_param(tokenization_params, add_special_tokens.name(), add_special_tokens_flag);
+    return add_special_tokens_flag;
+}
+
+std::vector<int64_t> to_vector(const ov::Tensor& input_ids) {
+    const int64_t* data = input_ids.data<int64_t>();
+    return std::vector<int64_t>(data, data + input_ids.get_size());
+}
+
+TokenizedInputs to_tokenized_inputs(const std::vector<int64_t>& token_ids) {
+    ov::Tensor input_ids(ov::element::i64, {1, token_ids.size()});
+    std::copy(token_ids.begin(), token_ids.end(), input_ids.data<int64_t>());
+    ov::Tensor attention_mask(ov::element::i64, {1, token_ids.size()});
+    std::fill_n(attention_mask.data<int64_t>(), attention_mask.get_size(), 1);
+    return {input_ids, attention_mask};
+}
+
+}  // namespace
+
 void check_arguments(const ov::AnyMap& parameters, std::set<std::string> allowed_argnames) {
     for (const auto& [key, value] : parameters) {
         if (allowed_argnames.find(key) == allowed_argnames.end()) {
@@ -407,11 +453,14 @@ void Tokenizer::TokenizerImpl::setup_tokenizer(const std::pair<std::shared_ptr<o
         ov::CompiledModel tokenizer = core.compile_model(ov_tokenizer, device, properties);
         ov::genai::utils::print_compiled_model_properties(tokenizer, "OV Tokenizer");
 
+        m_num_tokenizer_requests = tokenizer.get_property(ov::optimal_number_of_infer_requests);
         m_ireq_queue_tokenizer = std::make_unique<CircularBufferQueue<ov::InferRequest>>(
-            tokenizer.get_property(ov::optimal_number_of_infer_requests),
+            m_num_tokenizer_requests,
             [&tokenizer]() -> ov::InferRequest {
                 return tokenizer.create_infer_request();
             });
+        m_encode_coalescer = std::make_unique<RequestCoalescer<std::string, TokenizedInputs>>(
+            COALESCING_WINDOW, MAX_COALESCED_BATCH_SIZE, m_num_tokenizer_requests);
 
         const ov::AnyMap& rt_info = ov_tokenizer->get_rt_info();
         m_pad_token_id = find_or_fallback(rt_info, "pad_token_id", m_pad_token_id);
@@ -434,8 +483,9 @@ void Tokenizer::TokenizerImpl::setup_tokenizer(const std::pair<std::shared_ptr<o
         ov::CompiledModel detokenizer = core.compile_model(ov_detokenizer, device, properties);
         ov::genai::utils::print_compiled_model_properties(detokenizer, "OV Detokenizer");
 
+        const size_t num_detokenizer_requests = detokenizer.get_property(ov::optimal_number_of_infer_requests);
         m_ireq_queue_detokenizer = std::make_unique<CircularBufferQueue<ov::InferRequest>>(
-            detokenizer.get_property(ov::optimal_number_of_infer_requests),
+            num_detokenizer_requests,
             [&detokenizer]() -> ov::InferRequest {
                 return detokenizer.create_infer_request();
             });
@@ -450,6 +500,11 @@ void Tokenizer::TokenizerImpl::setup_tokenizer(const std::pair<std::shared_ptr<o
         // Initialize detokenizer's cache to save time later.
         decode({1, 33, 199, 42, 42});
 
+        // Sequences of different lengths are decoded in one batch only if the padding does not change their text.
+        m_is_padding_skipped = m_pad_token_id != -1 && decode_one({42}, {}) == decode_one({42, m_pad_token_id}, {});
+        m_decode_coalescer = std::make_unique<RequestCoalescer<std::vector<int64_t>, std::string>>(
+            COALESCING_WINDOW, MAX_COALESCED_BATCH_SIZE, num_detokenizer_requests);
+
         m_vocab = read_vocab_from_detokenizer_model(ov_detokenizer);
     }
 }
@@ -578,6 +633,20 @@ TokenizedInputs Tokenizer::TokenizerImpl::encode(const std::string& prompt, cons
     OPENVINO_ASSERT(m_ireq_queue_tokenizer, "Either openvino_tokenizer.xml was not provided or it was not loaded correctly. "
                                             "Tokenizer::encode is not available");
 
+    const std::optional<bool> add_special_tokens_flag = get_batchable_add_special_tokens(tokenization_params);
+    if (!add_special_tokens_flag || !m_encode_coalescer || m_older_than_24_5) {
+        return encode_one(prompt, tokenization_params);
+    }
+    if (prompt.size() >= LONG_TEXT_SIZE) {
+        return encode_long_text(prompt, *add_special_tokens_flag);
+    }
+    return m_encode_coalescer->submit(*add_special_tokens_flag ? add_special_tokens.name() : "", prompt,
+                                      [&](const std::vector<const std::string*>& prompts) {
+                                          return encode_batch(prompts, tokenization_params);
+                                      });
+}
+
+TokenizedInputs Tokenizer::TokenizerImpl::encode_one(const std::string& prompt, const ov::AnyMap& tokenization_params) {
     CircularBufferQueueElementGuard<ov::InferRequest> infer_request_guard(m_ireq_queue_tokenizer.get());
     set_state_if_necessary(infer_request_guard, tokenization_params);
     size_t batch_size = 1;
@@ -600,6 +669,142 @@ TokenizedInputs Tokenizer::TokenizerImpl::encode(const std::string& prompt, cons
     );
 }
 
+std::vector<TokenizedInputs> Tokenizer::TokenizerImpl::encode_batch(const std::vector<const std::string*>& prompts, const ov::AnyMap& tokenization_params) {
+    if (prompts.size() == 1) {
+        return {encode_one(*prompts[0], tokenization_params)};
+    }
+    std::vector<std::string> batch;
+    batch.reserve(prompts.size());
+    for (const std::string* prompt : prompts) {
+        batch.push_back(*prompt);
+    }
+    TokenizedInputs padded = encode(batch, tokenization_params);
+
+    // the tokens of a prompt are the unmasked ones of its row, regardless of the padding side
+    const size_t row_size = padded.input_ids.get_shape().at(1);
+    const int64_t* input_ids = padded.input_ids.data<int64_t>();
+    const int64_t* attention_mask = padded.attention_mask.data<int64_t>();
+    std::vector<TokenizedInputs> results;
+    results.reserve(prompts.size());
+    for (size_t row = 0; row < prompts.size(); ++row) {
+        std::vector<int64_t> token_ids;
+        for (size_t i = row * row_size; i < (row + 1) * row_size; ++i) {
+            if (attention_mask[i] != 0) {
+                token_ids.push_back(input_ids[i]);
+            }
+        }
+        results.push_back(to_tokenized_inputs(token_ids));
+    }
+    return results;
+}
+
+TokenizedInputs Tokenizer::TokenizerImpl::encode_long_text(const std::string& prompt, bool add_special_tokens_flag) {
+    const ov::AnyMap without_special_tokens = {ov::genai::add_special_tokens(false)};
+
+    std::vector<int64_t> prefix, suffix;
+    if (add_special_tokens_flag) {
+        // the special tokens are the ones around the tokens of a probe text
+        const std::vector<int64_t> probe_with_special_tokens = to_vector(encode_one("a", {ov::genai::add_special_tokens(true)}).input_ids);
+        const std::vector<int64_t> probe_without_special_tokens = to_vector(encode_one("a", without_special_tokens).input_ids);
+        auto probe_it = std::search(probe_with_special_tokens.begin(), probe_with_special_tokens.end(),
+                                    probe_without_special_tokens.begin(), probe_without_special_tokens.end());
+        if (probe_without_special_tokens.empty() || probe_it == probe_with_special_tokens.end()) {
+            return encode_one(prompt, {ov::genai::add_special_tokens(true)});
+        }
+        prefix.assign(probe_with_special_tokens.begin(), probe_it);
+        suffix.assign(probe_it + probe_without_special_tokens.size(), probe_with_special_tokens.end());
+    }
+
+    // the candidate splits follow the last line breaks before each multiple of the chunk size
+    std::vector<std::vector<size_t>> candidates;
+    for (size_t target = LONG_TEXT_CHUNK_SIZE; target + LONG_TEXT_CHUNK_SIZE / 2 < prompt.size(); target += LONG_TEXT_CHUNK_SIZE) {
+        std::vector<size_t>& target_candidates = candidates.emplace_back();
+        for (size_t position = target; position > target - LONG_TEXT_CHUNK_SIZE / 2 && target_candidates.size() < MAX_SPLIT_CANDIDATES; --position) {
+            if (prompt[position - 1] == '\n' && !std::isspace(static_cast<unsigned char>(prompt[position]))) {
+                target_candidates.push_back(position);
+            }
+        }
+    }
+
+    // all the candidates are checked in one batch, the first valid candidate of each target is the split
+    std::vector<size_t> all_candidates;
+    for (const auto& target_candidates : candidates) {
+        all_candidates.insert(all_candidates.end(), target_candidates.begin(), target_candidates.end());
+    }
+    const std::vector<bool> is_valid = check_splits(prompt, all_candidates, SPLIT_CHECK_WINDOW);
+    std::vector<size_t> splits = {0};
+    size_t candidate_idx = 0;
+    for (const auto& target_candidates : candidates) {
+        auto valid_it = std::find(is_valid.begin() + candidate_idx, is_valid.begin() + candidate_idx + target_candidates.size(), true);
+        if (valid_it != is_valid.begin() + candidate_idx + target_candidates.size()) {
+            splits.push_back(all_candidates[valid_it - is_valid.begin()]);
+        }
+        candidate_idx += target_candidates.size();
+    }
+    splits.push_back(prompt.size());
+    if (splits.size() == 2) {
+        return encode_one(prompt, {ov::genai::add_special_tokens(add_special_tokens_flag)});
+    }
+
+    // the last task checks the splits with a wider window, as a tokenizer may merge the text across a split farther from it
+    const std::vector<size_t> inner_splits(splits.begin() + 1, splits.end() - 1);
+    bool is_verified = false;
+    std::vector<std::vector<int64_t>> chunk_token_ids(splits.size() - 1);
+    ThreadPool::get_shared().parallel_for(chunk_token_ids.size() + 1, [&](size_t i) {
+        if (i == chunk_token_ids.size()) {
+            const std::vector<bool> is_verified_split = check_splits(prompt, inner_splits, SPLIT_VERIFY_WINDOW);
+            is_verified = std::all_of(is_verified_split.begin(), is_verified_split.end(), [](bool value) { return value; });
+            return;
+        }
+        const std::string chunk = prompt.substr(splits[i], splits[i + 1] - splits[i]);
+        chunk_token_ids[i] = to_vector(encode_one(chunk, without_special_tokens).input_ids);
+    }, m_num_tokenizer_requests);
+    if (!is_verified) {
+        return encode_one(prompt, {ov::genai::add_special_tokens(add_special_tokens_flag)});
+    }
+
+    std::vector<int64_t> token_ids = std::move(prefix);
+    for (const auto& chunk : chunk_token_ids) {
+        token_ids.insert(token_ids.end(), chunk.begin(), chunk.end());
+    }
+    token_ids.insert(token_ids.end(), suffix.begin(), suffix.end());
+
+#ifndef NDEBUG
+    OPENVINO_ASSERT(token_ids == to_vector(encode_one(prompt, {ov::genai::add_special_tokens(add_special_tokens_flag)}).input_ids),
+                    "Encoding the long text in ", chunk_token_ids.size(), " chunks differs from encoding it at once");
+#endif
+    return to_tokenized_inputs(token_ids);
+}
+
+std::vector<bool> Tokenizer::TokenizerImpl::check_splits(const std::string& prompt, const std::vector<size_t>& positions, size_t window) {
+    if (positions.empty()) {
+        return {};
+    }
+    // a split is valid if the text around it is encoded the same way with and without the split
+    std::vector<std::string> probes;
+    for (const size_t position : positions) {
+        const size_t begin = position - std::min(position, window);
+        const size_t end = std::min(prompt.size(), position + window);
+        probes.push_back(prompt.substr(begin, end - begin));
+        probes.push_back(prompt.substr(begin, position - begin));
+        probes.push_back(prompt.substr(position, end - position));
+    }
+    std::vector<const std::string*> probe_ptrs;
+    for (const auto& probe : probes) {
+        probe_ptrs.push_back(&probe);
+    }
+    const std::vector<TokenizedInputs> probe_tokens = encode_batch(probe_ptrs, {ov::genai::add_special_tokens(false)});
+
+    std::vector<bool> is_valid;
+    for (size_t probe_idx = 0; probe_idx < probe_tokens.size(); probe_idx += 3) {
+        std::vector<int64_t> split_tokens = to_vector(probe_tokens[probe_idx + 1].input_ids);
+        const std::vector<int64_t> right_tokens = to_vector(probe_tokens[probe_idx + 2].input_ids);
+        split_tokens.insert(split_tokens.end(), right_tokens.begin(), right_tokens.end());
+        is_valid.push_back(split_tokens == to_vector(probe_tokens[probe_idx].input_ids));
+    }
+    return is_valid;
+}
+
 TokenizedInputs Tokenizer::TokenizerImpl::encode(const std::vector<std::pair<std::string, std::string>>& prompts_pairs, const ov::AnyMap& tokenization_params) {
     OPENVINO_ASSERT(m_ireq_queue_tokenizer, "Either openvino_tokenizer.xml was not provided or it was not loaded correctly. "
                                             "Tokenizer::encode is not available");
@@ -690,6 +895,30 @@ TokenizedInputs Tokenizer::TokenizerImpl::get_copied_results(ov::Tensor input_id
 std::string Tokenizer::TokenizerImpl::decode(const std::vector<int64_t>& tokens, const ov::AnyMap& detokenization_params) {
     OPENVINO_ASSERT(m_ireq_queue_detokenizer, "Detokenizer model has not been provided. Tokenizer::decode is not available");
 
+    if (!m_decode_coalescer || m_older_than_24_5) {
+        return decode_one(tokens, detokenization_params);
+    }
+    bool skip_special_tokens_flag = true;
+    ov::genai::utils::read_anymap_param(detokenization_params, skip_special_tokens.name(), skip_special_tokens_flag);
+    // the shorter sequences of a batch are padded, so if the padding is not skipped only the sequences of the same length are coalesced
+    std::string key = skip_special_tokens_flag ? skip_special_tokens.name() : "";
+    if (!skip_special_tokens_flag || !m_is_padding_skipped) {
+        key += ":" + std::to_string(tokens.size());
+    }
+    return m_decode_coalescer->submit(key, tokens, [&](const std::vector<const std::vector<int64_t>*>& batch) {
+        if (batch.size() == 1) {
+            return std::vector<std::string>{decode_one(*batch[0], detokenization_params)};
+        }
+        std::vector<std::vector<int64_t>> lines;
+        lines.reserve(batch.size());
+        for (const auto* line : batch) {
+            lines.push_back(*line);
+        }
+        return decode(lines, detokenization_params);
+    });
+}
+
+std::string Tokenizer::TokenizerImpl::decode_one(const std::vector<int64_t>& tokens, const ov::AnyMap& detokenization_params) {
     CircularBufferQueueElementGuard<ov::InferRequest> infer_request_guard(this->m_ireq_queue_detokenizer.get());
     set_state_if_necessary(infer_request_guard, detokenization_params);
     size_t batch_size = 1;
@@ -761,8 +990,8 @@ std::string Tokenizer::TokenizerImpl::apply_chat_template(
     OPENVINO_ASSERT(resolved_extra_context.is_object(),
                     "Extra context should be an object-like JsonContainer, got: ", resolved_extra_context.type_name());
 
-    minja::chat_template minja_template(chat_tpl, m_bos_token, m_eos_token);
-    
+    const auto minja_template = get_minja_template(chat_tpl);
+
     minja::chat_template_inputs minja_inputs;
     minja_inputs.messages = history.get_messages();
     if (!resolved_tools.empty()) {
@@ -779,7 +1008,7 @@ std::string Tokenizer::TokenizerImpl::apply_chat_template(
     
     std::string result;
     try {
-        result = minja_template.apply(minja_inputs);
+        result = minja_template->apply(minja_inputs);
     } catch (const std::exception& error) {
         OPENVINO_THROW("Minja failed to apply chat template. Possible solutions are\n"
                         "* Provide a simplified chat template with set_chat_template().\n"
@@ -794,6 +1023,27 @@ std::string Tokenizer::TokenizerImpl::apply_chat_template(
     return result;
 }
 
+std::shared_ptr<const minja::chat_template> Tokenizer::TokenizerImpl::get_minja_template(const std::string& chat_template) const {
+    // the number of cached templates is bounded in case a different template is passed to each call
+    constexpr size_t max_num_minja_templates = 16;
+    std::string key = m_bos_token + '\0' + m_eos_token + '\0' + chat_template;
+    {
+        std::lock_guard<std::mutex> lock(m_minja_templates_mutex);
+        auto template_it = m_minja_templates.find(key);
+        if (template_it != m_minja_templates.end()) {
+            return template_it->second;
+        }
+    }
+    // parsing errors are thrown before the template is cached
+    auto minja_template = std::make_shared<const minja::chat_template>(chat_template, m_bos_token, m_eos_token);
+
+    std::lock_guard<std::mutex> lock(m_minja_templates_mutex);
+    if (m_minja_templates.size() >= max_num_minja_templates) {
+        m_minja_templates.clear();
+    }
+    return m_minja_templates.emplace(std::move(key), std::move(minja_template)).first->second;
+}
+
 void Tokenizer::TokenizerImpl::set_chat_template(const std::string& chat_template) {
     m_original_chat_template = chat_template;
     m_chat_template = remap_template(chat_template);
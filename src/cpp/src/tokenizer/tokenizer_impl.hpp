@@ -5,6 +5,8 @@
 #include <filesystem>
 #include <fstream>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include "minja/minja.hpp"
 #include "minja/chat-template.hpp"
@@ -15,6 +17,7 @@
 #include "gguf_utils/gguf_tokenizer.hpp"
 #include "tokenizer/chat_template_fallback_map.hpp"
 #include "tokenizer/make_tokenizer_stateful.hpp"
+#include "tokenizer/request_coalescer.hpp"
 #include "tokenizer/tokenizers_path.hpp"
 #include "circular_buffer_queue.hpp"
 #include "json_utils.hpp"
@@ -31,6 +34,12 @@ class Tokenizer::TokenizerImpl {
 public:
     std::unique_ptr<CircularBufferQueue<ov::InferRequest>> m_ireq_queue_tokenizer;
     std::unique_ptr<CircularBufferQueue<ov::InferRequest>> m_ireq_queue_detokenizer;
+    size_t m_num_tokenizer_requests = 1;
+    // concurrent single prompt encode() and decode() calls are coalesced into batched inferences
+    std::unique_ptr<RequestCoalescer<std::string, TokenizedInputs>> m_encode_coalescer;
+    std::unique_ptr<RequestCoalescer<std::vector<int64_t>, std::string>> m_decode_coalescer;
+    // true if the pad tokens appended to the shorter sequences of a decoded batch are skipped with skip_special_tokens
+    bool m_is_padding_skipped = false;
     std::unordered_map<ov::InferRequest*, ov::AnyMap> m_request_to_state_flags;
     std::shared_ptr<void> m_shared_object_ov_tokenizers = nullptr;
     bool is_paired_input = false;
@@ -46,6 +55,11 @@ public:
     std::vector<std::string> m_vocab = {};
     std::shared_ptr<StructuredOutputController> m_structured_output_controller = nullptr;
 
+    // { bos_token, eos_token and chat template : parsed chat template }, parsing includes rendering of the probe
+    // conversations to detect the capabilities of the template, so it is done once per template
+    mutable std::unordered_map<std::string, std::shared_ptr<const minja::chat_template>> m_minja_templates;
+    mutable std::mutex m_minja_templates_mutex;
+
     template <typename T>
     void set_state_value(ov::VariableState& state, std::optional<T> value, ov::AnyMap& state_flags);
 
@@ -67,18 +81,28 @@ public:
     TokenizedInputs encode(const std::vector<std::string>& prompts_1, const std::vector<std::string>& prompts_2, const ov::AnyMap& tokenization_params = {});
     TokenizedInputs encode(const std::vector<std::string>& prompts, const ov::AnyMap& tokenization_params = {});
 
+    TokenizedInputs encode_one(const std::string& prompt, const ov::AnyMap& tokenization_params);
+    std::vector<TokenizedInputs> encode_batch(const std::vector<const std::string*>& prompts, const ov::AnyMap& tokenization_params);
+    TokenizedInputs encode_long_text(const std::string& prompt, bool add_special_tokens_flag);
+    // whether the text around each position is encoded the same way with and without splitting it at the position
+    std::vector<bool> check_splits(const std::string& prompt, const std::vector<size_t>& positions, size_t window);
+
     TokenizedInputs get_copied_results(ov::Tensor input_ids, ov::Tensor attention_mask);
 
     std::string decode(const std::vector<int64_t>& tokens, const ov::AnyMap& detokenization_params = {});
     std::vector<std::string> decode(const ov::Tensor& tokens, const ov::AnyMap& detokenization_params = {});
     std::vector<std::string> decode(const std::vector<std::vector<int64_t>>& lines, const ov::AnyMap& detokenization_params = {});
 
+    std::string decode_one(const std::vector<int64_t>& tokens, const ov::AnyMap& detokenization_params);
+
     std::string apply_chat_template(const ChatHistory& history,
                                     bool add_generation_prompt,
                                     const std::string& chat_template,
                                     const std::optional<JsonContainer>& tools,
                                     const std::optional<JsonContainer>& extra_context) const;
 
+    std::shared_ptr<const minja::chat_template> get_minja_template(const std::string& chat_template) const;
+
     void set_chat_template(const std::string& chat_template);
     std::string get_chat_template() const;
     std::string get_original_chat_template() const;
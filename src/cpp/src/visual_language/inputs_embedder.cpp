@@ -38,6 +38,7 @@ std::pair<ov::Tensor, std::optional<int64_t>> InputsEmbedder::IInputsEmbedder::g
 
 void InputsEmbedder::IInputsEmbedder::start_chat(const std::string& system_message) {
     m_is_chat_conversation = true;
+    m_chat_tokenizer.reset();
     if (!m_kv_cache_state.get_state().empty()) {
         m_kv_cache_state.reset_state();
     }
@@ -60,6 +61,7 @@ void InputsEmbedder::IInputsEmbedder::update_chat_history(const std::string& dec
 
 void InputsEmbedder::IInputsEmbedder::finish_chat() {
     m_is_chat_conversation = false;
+    m_chat_tokenizer.reset();
     m_kv_cache_state.reset_state();
 }
 
@@ -102,7 +104,10 @@ ov::Tensor InputsEmbedder::IInputsEmbedder::apply_chat_template_tokenize(const s
     if (m_is_chat_conversation) {
         std::string prompt_to_encode = prompt;
         auto start_tokenizer_time = std::chrono::steady_clock::now();
-        ov::Tensor new_chat_tokens = m_tokenizer.encode(prompt_to_encode, ov::genai::add_special_tokens(add_special_tokens)).input_ids;
+        // the templated history is encoded incrementally only without special tokens, as they would be added to each new turn
+        ov::Tensor new_chat_tokens = add_special_tokens
+            ? m_tokenizer.encode(prompt_to_encode, ov::genai::add_special_tokens(add_special_tokens)).input_ids
+            : m_chat_tokenizer.encode(prompt_to_encode).input_ids;
         auto end_tokenizer_time = std::chrono::steady_clock::now();
         metrics.raw_metrics.tokenization_durations.emplace_back(PerfMetrics::get_microsec(end_tokenizer_time - start_tokenizer_time));
         return new_chat_tokens;
@@ -17,6 +17,7 @@
 #include "visual_language/vlm_config.hpp"
 #include "visual_language/embedding_model.hpp"
 #include "visual_language/vision_encoder.hpp"
+#include "tokenizer/incremental_chat_tokenizer.hpp"
 
 namespace ov::genai {
 struct VLMPerfMetrics;
@@ -127,6 +128,8 @@ private:
         EmbeddingsModel::Ptr m_embedding;
         // A tokenizer encoding a prompt.
         Tokenizer m_tokenizer;
+        // Encodes only the new turns of the templated chat history.
+        IncrementalChatTokenizer m_chat_tokenizer{m_tokenizer};
         // True if chat mode is activated to save conversation
         // history between generate() calls.
         bool m_is_chat_conversation = false;
@@ -21,6 +21,7 @@
 
 #include "json_utils.hpp"
 #include "openvino/genai/visibility.hpp"
+#include "threadpool.hpp"
 
 namespace {
 using ov::genai::WhisperFeatures;
@@ -362,25 +363,8 @@ WhisperFeatures mel_spectrogram_convert_audio(const std::vector<float>& raw_spee
     features.n_frames = (padded_raw_speech.size() - n_fft) / hop_length;
     features.data.resize(features.feature_size * features.n_frames);
 
-    {
-        std::vector<std::thread> workers(n_threads - 1);
-        for (int iw = 0; iw < n_threads - 1; ++iw) {
-            workers[iw] = std::thread(log_mel_spectrogram_worker_thread,
-                                      iw + 1,
-                                      std::cref(hann),
-                                      padded_raw_speech,
-                                      raw_speech.size() + reflect_pad_size,
-                                      n_fft,
-                                      hop_length,
-                                      n_threads,
-                                      std::cref(mel_filter),
-                                      std::ref(features),
-                                      std::cref(sin_vals),
-                                      std::cref(cos_vals));
-        }
-
-        // main thread
-        log_mel_spectrogram_worker_thread(0,
+    ov::genai::ThreadPool::get_shared().parallel_for(n_threads, [&](size_t ith) {
+        log_mel_spectrogram_worker_thread(ith,
                                           hann,
                                           padded_raw_speech,
                                           raw_speech.size() + reflect_pad_size,
@@ -391,11 +375,7 @@ WhisperFeatures mel_spectrogram_convert_audio(const std::vector<float>& raw_spee
                                           features,
                                           sin_vals,
                                           cos_vals);
-
-        for (int iw = 0; iw < n_threads - 1; ++iw) {
-            workers[iw].join();
-        }
-    }
+    });
 
     // clamping and normalization
     double mmax = -1e20;
@@ -112,6 +112,7 @@ from .py_openvino_genai import (
     GenerationResult,
     GenerationStatus,
     SchedulerConfig,
+    SchedulingPolicy,
     CacheEvictionConfig,
     AggregationMode,
     SparseAttentionMode,
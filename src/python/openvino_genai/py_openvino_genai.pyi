@@ -5,7 +5,7 @@ from __future__ import annotations
 import collections.abc
 import openvino._pyopenvino
 import typing
-__all__: list[str] = ['Adapter', 'AdapterConfig', 'AggregationMode', 'AutoencoderKL', 'CLIPTextModel', 'CLIPTextModelWithProjection', 'CacheEvictionConfig', 'ChatHistory', 'ChunkStreamerBase', 'ContinuousBatchingPipeline', 'CppStdGenerator', 'DecodedResults', 'DeepSeekR1ReasoningIncrementalParser', 'DeepSeekR1ReasoningParser', 'EncodedGenerationResult', 'EncodedResults', 'ExtendedPerfMetrics', 'FluxTransformer2DModel', 'GenerationConfig', 'GenerationFinishReason', 'GenerationHandle', 'GenerationOutput', 'GenerationResult', 'GenerationStatus', 'Generator', 'Image2ImagePipeline', 'ImageGenerationConfig', 'ImageGenerationPerfMetrics', 'IncrementalParser', 'InpaintingPipeline', 'KVCrushAnchorPointMode', 'KVCrushConfig', 'LLMPipeline', 'Llama3JsonToolParser', 'Llama3PythonicToolParser', 'MeanStdPair', 'Parser', 'PerfMetrics', 'Phi4ReasoningIncrementalParser', 'Phi4ReasoningParser', 'PipelineMetrics', 'RawImageGenerationPerfMetrics', 'RawPerfMetrics', 'ReasoningIncrementalParser', 'ReasoningParser', 'SD3Transformer2DModel', 'SDPerModelsPerfMetrics', 'SDPerfMetrics', 'Scheduler', 'SchedulerConfig', 'SparseAttentionConfig', 'SparseAttentionMode', 'SpeechGenerationConfig', 'SpeechGenerationPerfMetrics', 'StopCriteria', 'StreamerBase', 'StreamingStatus', 'StructuralTagItem', 'StructuralTagsConfig', 'StructuredOutputConfig', 'SummaryStats', 'T5EncoderModel', 'Text2ImagePipeline', 'Text2SpeechDecodedResults', 'Text2SpeechPipeline', 'TextEmbeddingPipeline', 'TextParserStreamer', 'TextRerankPipeline', 'TextStreamer', 'TokenizedInputs', 'Tokenizer', 'TorchGenerator', 'UNet2DConditionModel', 'VLMDecodedResults', 'VLMPerfMetrics', 'VLMPipeline', 'VLMRawPerfMetrics', 'WhisperDecodedResultChunk', 'WhisperDecodedResults', 'WhisperGenerationConfig', 'WhisperPerfMetrics', 'WhisperPipeline', 'WhisperRawPerfMetrics', 'draft_model', 'get_version']
+__all__: list[str] = ['Adapter', 'AdapterConfig', 'AggregationMode', 'AutoencoderKL', 'CLIPTextModel', 'CLIPTextModelWithProjection', 'CacheEvictionConfig', 'ChatHistory', 'ChunkStreamerBase', 'ContinuousBatchingPipeline', 'CppStdGenerator', 'DecodedResults', 'DeepSeekR1ReasoningIncrementalParser', 'DeepSeekR1ReasoningParser', 'EncodedGenerationResult', 'EncodedResults', 'ExtendedPerfMetrics', 'FluxTransformer2DModel', 'GenerationConfig', 'GenerationFinishReason', 'GenerationHandle', 'GenerationOutput', 'GenerationResult', 'GenerationStatus', 'Generator', 'Image2ImagePipeline', 'ImageGenerationConfig', 'ImageGenerationPerfMetrics', 'IncrementalParser', 'InpaintingPipeline', 'KVCrushAnchorPointMode', 'KVCrushConfig', 'LLMPipeline', 'Llama3JsonToolParser', 'Llama3PythonicToolParser', 'MeanStdPair', 'Parser', 'PerfMetrics', 'Phi4ReasoningIncrementalParser', 'Phi4ReasoningParser', 'PipelineMetrics', 'RawImageGenerationPerfMetrics', 'RawPerfMetrics', 'ReasoningIncrementalParser', 'ReasoningParser', 'SD3Transformer2DModel', 'SDPerModelsPerfMetrics', 'SDPerfMetrics', 'Scheduler', 'SchedulerConfig', 'SchedulingPolicy', 'SparseAttentionConfig', 'SparseAttentionMode', 'SpeechGenerationConfig', 'SpeechGenerationPerfMetrics', 'StopCriteria', 'StreamerBase', 'StreamingStatus', 'StructuralTagItem', 'StructuralTagsConfig', 'StructuredOutputConfig', 'SummaryStats', 'T5EncoderModel', 'Text2ImagePipeline', 'Text2SpeechDecodedResults', 'Text2SpeechPipeline', 'TextEmbeddingPipeline', 'TextParserStreamer', 'TextRerankPipeline', 'TextStreamer', 'TokenizedInputs', 'Tokenizer', 'TorchGenerator', 'UNet2DConditionModel', 'VLMDecodedResults', 'VLMPerfMetrics', 'VLMPipeline', 'VLMRawPerfMetrics', 'WhisperDecodedResultChunk', 'WhisperDecodedResults', 'WhisperGenerationConfig', 'WhisperPerfMetrics', 'WhisperPipeline', 'WhisperRawPerfMetrics', 'draft_model', 'get_version']
 class Adapter:
     """
     Immutable LoRA Adapter that carries the adaptation matrices and serves as unique adapter identifier.
@@ -537,6 +537,14 @@ class ContinuousBatchingPipeline:
         ...
     def has_non_finished_requests(self) -> bool:
         ...
+    def load_prefix_cache(self, path: os.PathLike | str | bytes) -> int:
+        ...
+    @typing.overload
+    def save_prefix_cache(self, path: os.PathLike | str | bytes) -> None:
+        ...
+    @typing.overload
+    def save_prefix_cache(self, path: os.PathLike | str | bytes, input_ids: openvino._pyopenvino.Tensor) -> None:
+        ...
     def start_chat(self, system_message: str = '') -> None:
         ...
     def step(self) -> None:
@@ -865,8 +873,24 @@ class GenerationConfig:
         top_k:              the number of highest probability vocabulary tokens to keep for top-k-filtering.
         do_sample:          whether or not to use multinomial random sampling that add up to `top_p` or higher are kept.
         num_return_sequences: the number of sequences to generate from a single prompt.
+    
+        Assisting generation parameters:
+        assistant_confidence_threshold: the lower token probability of candidate to be validated by main model in case of dynamic strategy candidates number update.
+        num_assistant_tokens: the defined candidates number to be generated by draft model/prompt lookup in case of static strategy candidates number update.
+        max_ngram_size:     maximum ngram to use when looking for matches in the prompt.
+        adaptive_num_assistant_tokens: if true, ContinuousBatching backend adjusts the number of candidates of the request every step between 1 and
+            2 * num_assistant_tokens from the observed acceptance rate and the measured durations of draft and main model steps.
+        prompt_lookup_corpus: token ids looked up by prompt lookup in addition to the prompt and the generated tokens, e.g. the tokenized
+            documents retrieved for the request.
+    
+        Scheduling parameters (used by ContinuousBatching backend depending on SchedulerConfig.scheduling_policy):
+        priority:           importance of the request for SchedulingPolicy.PRIORITY, requests with a higher value are processed first.
+        ttft_target_ms:     time to first token target in milliseconds for SchedulingPolicy.EARLIEST_DEADLINE_FIRST, 0 means no target.
+        tpot_target_ms:     time per output token target in milliseconds for SchedulingPolicy.EARLIEST_DEADLINE_FIRST, 0 means no target.
+        tenant_id:          the tenant the request belongs to for SchedulingPolicy.FAIR_SHARE.
     """
     adapters: openvino_genai.py_openvino_genai.AdapterConfig | None
+    adaptive_num_assistant_tokens: bool
     apply_chat_template: bool
     do_sample: bool
     echo: bool
@@ -874,6 +898,7 @@ class GenerationConfig:
     include_stop_str_in_output: bool
     stop_criteria: StopCriteria
     structured_output_config: openvino_genai.py_openvino_genai.StructuredOutputConfig | None
+    tenant_id: str
     @typing.overload
     def __init__(self, json_path: os.PathLike | str | bytes) -> None:
         """
@@ -1001,6 +1026,18 @@ class GenerationConfig:
     def presence_penalty(self, arg0: typing.SupportsFloat) -> None:
         ...
     @property
+    def priority(self) -> int:
+        ...
+    @priority.setter
+    def priority(self, arg0: typing.SupportsInt) -> None:
+        ...
+    @property
+    def prompt_lookup_corpus(self) -> list[int]:
+        ...
+    @prompt_lookup_corpus.setter
+    def prompt_lookup_corpus(self, arg0: collections.abc.Sequence[typing.SupportsInt]) -> None:
+        ...
+    @property
     def repetition_penalty(self) -> float:
         ...
     @repetition_penalty.setter
@@ -1042,6 +1079,18 @@ class GenerationConfig:
     @top_p.setter
     def top_p(self, arg0: typing.SupportsFloat) -> None:
         ...
+    @property
+    def tpot_target_ms(self) -> int:
+        ...
+    @tpot_target_ms.setter
+    def tpot_target_ms(self, arg0: typing.SupportsInt) -> None:
+        ...
+    @property
+    def ttft_target_ms(self) -> int:
+        ...
+    @ttft_target_ms.setter
+    def ttft_target_ms(self, arg0: typing.SupportsInt) -> None:
+        ...
 class GenerationFinishReason:
     """
     Members:
@@ -2316,10 +2365,29 @@ class SchedulerConfig:
         cache_eviction_config       Cache eviction configuration struct.
         use_sparse_attention        Whether to use sparse attention during prefill.
         sparse_attention_config     Sparse attention configuration struct.
+        swap_space:                 total size of host memory swap space for preempted sequences in GB.
+            When set, KV-cache of preempted sequences is swapped out to host memory instead of being recomputed.
+        prefix_cache_disk_size:     total size of the disk tier of the prefix cache in GB.
+            When set together with enable_prefix_caching, fully filled KV-cache blocks evicted from the prefix cache
+            are stored to a memory-mapped file and loaded back when a new prompt starts with the same prefix.
+        prefix_cache_disk_dir:      directory for the prefix cache disk tier file, system temporary directory is used when empty.
+        prefix_cache_snapshot_path: path to a prefix cache snapshot created by ContinuousBatchingPipeline.save_prefix_cache()
+            to warm-start the prefix cache from. Ignored with a warning if created for a different model or KV-cache precision.
+        scheduling_policy:          order in which requests are admitted to a batch and preempted, see SchedulingPolicy.
+        tenant_weights:             relative batch shares of tenants (GenerationConfig.tenant_id) for SchedulingPolicy.FAIR_SHARE,
+            tenants which are not listed have a weight of 1.0.
+        num_scheduler_steps:        number of consecutive generation steps scheduled at once when all running requests are
+            in the generation phase. Requests added meanwhile wait for the next full scheduling step.
+        inter_token_latency_target_ms: target duration in milliseconds of the steps generating tokens for running requests.
+            When set together with dynamic_split_fuse, the number of prompt tokens scheduled together with generated tokens
+            is adapted to the measured step durations to keep this target.
     """
     cache_eviction_config: CacheEvictionConfig
     dynamic_split_fuse: bool
     enable_prefix_caching: bool
+    prefix_cache_disk_dir: str
+    prefix_cache_snapshot_path: str
+    scheduling_policy: SchedulingPolicy
     sparse_attention_config: SparseAttentionConfig
     use_cache_eviction: bool
     use_sparse_attention: bool
@@ -2334,6 +2402,12 @@ class SchedulerConfig:
     def cache_size(self, arg0: typing.SupportsInt) -> None:
         ...
     @property
+    def inter_token_latency_target_ms(self) -> int:
+        ...
+    @inter_token_latency_target_ms.setter
+    def inter_token_latency_target_ms(self, arg0: typing.SupportsInt) -> None:
+        ...
+    @property
     def max_num_batched_tokens(self) -> int:
         ...
     @max_num_batched_tokens.setter
@@ -2351,6 +2425,80 @@ class SchedulerConfig:
     @num_kv_blocks.setter
     def num_kv_blocks(self, arg0: typing.SupportsInt) -> None:
         ...
+    @property
+    def num_scheduler_steps(self) -> int:
+        ...
+    @num_scheduler_steps.setter
+    def num_scheduler_steps(self, arg0: typing.SupportsInt) -> None:
+        ...
+    @property
+    def prefix_cache_disk_size(self) -> int:
+        ...
+    @prefix_cache_disk_size.setter
+    def prefix_cache_disk_size(self, arg0: typing.SupportsInt) -> None:
+        ...
+    @property
+    def swap_space(self) -> int:
+        ...
+    @swap_space.setter
+    def swap_space(self, arg0: typing.SupportsInt) -> None:
+        ...
+    @property
+    def tenant_weights(self) -> dict[str, float]:
+        ...
+    @tenant_weights.setter
+    def tenant_weights(self, arg0: collections.abc.Mapping[str, typing.SupportsFloat]) -> None:
+        ...
+class SchedulingPolicy:
+    """
+    Represents the order in which requests are admitted to a batch and preempted when KV-cache blocks run out.
+                                   :param SchedulingPolicy.FCFS: Requests are processed in the order of arrival.
+                                   :param SchedulingPolicy.PRIORITY: Requests with a higher GenerationConfig.priority go first, requests of the same priority in the order of arrival.
+                                   :param SchedulingPolicy.EARLIEST_DEADLINE_FIRST: Requests go in the order of the deadlines derived from GenerationConfig.ttft_target_ms before the first token is generated and from GenerationConfig.tpot_target_ms afterwards. Requests without a target go last.
+                                   :param SchedulingPolicy.FAIR_SHARE: Batch is shared between tenants (GenerationConfig.tenant_id) in proportion to SchedulerConfig.tenant_weights.
+    
+    
+    Members:
+    
+      FCFS
+    
+      PRIORITY
+    
+      EARLIEST_DEADLINE_FIRST
+    
+      FAIR_SHARE
+    """
+    EARLIEST_DEADLINE_FIRST: typing.ClassVar[SchedulingPolicy]  # value = <SchedulingPolicy.EARLIEST_DEADLINE_FIRST: 2>
+    FAIR_SHARE: typing.ClassVar[SchedulingPolicy]  # value = <SchedulingPolicy.FAIR_SHARE: 3>
+    FCFS: typing.ClassVar[SchedulingPolicy]  # value = <SchedulingPolicy.FCFS: 0>
+    PRIORITY: typing.ClassVar[SchedulingPolicy]  # value = <SchedulingPolicy.PRIORITY: 1>
+    __members__: typing.ClassVar[dict[str, SchedulingPolicy]]  # value = {'FCFS': <SchedulingPolicy.FCFS: 0>, 'PRIORITY': <SchedulingPolicy.PRIORITY: 1>, 'EARLIEST_DEADLINE_FIRST': <SchedulingPolicy.EARLIEST_DEADLINE_FIRST: 2>, 'FAIR_SHARE': <SchedulingPolicy.FAIR_SHARE: 3>}
+    def __eq__(self, other: typing.Any) -> bool:
+        ...
+    def __getstate__(self) -> int:
+        ...
+    def __hash__(self) -> int:
+        ...
+    def __index__(self) -> int:
+        ...
+    def __init__(self, value: typing.SupportsInt) -> None:
+        ...
+    def __int__(self) -> int:
+        ...
+    def __ne__(self, other: typing.Any) -> bool:
+        ...
+    def __repr__(self) -> str:
+        ...
+    def __setstate__(self, state: typing.SupportsInt) -> None:
+        ...
+    def __str__(self) -> str:
+        ...
+    @property
+    def name(self) -> str:
+        ...
+    @property
+    def value(self) -> int:
+        ...
 class SparseAttentionConfig:
     """
     
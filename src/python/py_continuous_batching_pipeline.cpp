@@ -29,6 +29,7 @@ using ov::genai::GenerationOutput;
 using ov::genai::GenerationFinishReason;
 using ov::genai::GenerationStatus;
 using ov::genai::SchedulerConfig;
+using ov::genai::SchedulingPolicy;
 using ov::genai::PipelineMetrics;
 using ov::genai::KVCrushAnchorPointMode;
 using ov::genai::KVCrushConfig;
@@ -124,6 +125,22 @@ auto scheduler_config_docstring = R"(
     cache_eviction_config       Cache eviction configuration struct.
     use_sparse_attention        Whether to use sparse attention during prefill.
     sparse_attention_config     Sparse attention configuration struct.
+    swap_space:                 total size of host memory swap space for preempted sequences in GB.
+        When set, KV-cache of preempted sequences is swapped out to host memory instead of being recomputed.
+    prefix_cache_disk_size:     total size of the disk tier of the prefix cache in GB.
+        When set together with enable_prefix_caching, fully filled KV-cache blocks evicted from the prefix cache
+        are stored to a memory-mapped file and loaded back when a new prompt starts with the same prefix.
+    prefix_cache_disk_dir:      directory for the prefix cache disk tier file, system temporary directory is used when empty.
+    prefix_cache_snapshot_path: path to a prefix cache snapshot created by ContinuousBatchingPipeline.save_prefix_cache()
+        to warm-start the prefix cache from. Ignored with a warning if created for a different model or KV-cache precision.
+    scheduling_policy:          order in which requests are admitted to a batch and preempted, see SchedulingPolicy.
+    tenant_weights:             relative batch shares of tenants (GenerationConfig.tenant_id) for SchedulingPolicy.FAIR_SHARE,
+        tenants which are not listed have a weight of 1.0.
+    num_scheduler_steps:        number of consecutive generation steps scheduled at once when all running requests are
+        in the generation phase. Requests added meanwhile wait for the next full scheduling step.
+    inter_token_latency_target_ms: target duration in milliseconds of the steps generating tokens for running requests.
+        When set together with dynamic_split_fuse, the number of prompt tokens scheduled together with generated tokens
+        is adapted to the measured step durations to keep this target.
 )";
 
 auto generation_result_docstring = R"(
@@ -370,6 +387,18 @@ void init_continuous_batching_pipeline(py::module_& m) {
             .def_readwrite("xattention_stride", &SparseAttentionConfig::xattention_stride)
             .def("to_string", &SparseAttentionConfig::to_string);
 
+    py::enum_<SchedulingPolicy>(m, "SchedulingPolicy",
+                            R"(Represents the order in which requests are admitted to a batch and preempted when KV-cache blocks run out.
+                               :param SchedulingPolicy.FCFS: Requests are processed in the order of arrival.
+                               :param SchedulingPolicy.PRIORITY: Requests with a higher GenerationConfig.priority go first, requests of the same priority in the order of arrival.
+                               :param SchedulingPolicy.EARLIEST_DEADLINE_FIRST: Requests go in the order of the deadlines derived from GenerationConfig.ttft_target_ms before the first token is generated and from GenerationConfig.tpot_target_ms afterwards. Requests without a target go last.
+                               :param SchedulingPolicy.FAIR_SHARE: Batch is shared between tenants (GenerationConfig.tenant_id) in proportion to SchedulerConfig.tenant_weights.
+)")
+            .value("FCFS", SchedulingPolicy::FCFS)
+            .value("PRIORITY", SchedulingPolicy::PRIORITY)
+            .value("EARLIEST_DEADLINE_FIRST", SchedulingPolicy::EARLIEST_DEADLINE_FIRST)
+            .value("FAIR_SHARE", SchedulingPolicy::FAIR_SHARE);
+
     py::class_<SchedulerConfig>(m, "SchedulerConfig", scheduler_config_docstring)
         .def(py::init<>())
         .def_readwrite("max_num_batched_tokens", &SchedulerConfig::max_num_batched_tokens)
@@ -382,6 +411,14 @@ void init_continuous_batching_pipeline(py::module_& m) {
         .def_readwrite("cache_eviction_config", &SchedulerConfig::cache_eviction_config)
         .def_readwrite("use_sparse_attention", &SchedulerConfig::use_sparse_attention)
         .def_readwrite("sparse_attention_config", &SchedulerConfig::sparse_attention_config)
+        .def_readwrite("swap_space", &SchedulerConfig::swap_space)
+        .def_readwrite("prefix_cache_disk_size", &SchedulerConfig::prefix_cache_disk_size)
+        .def_readwrite("prefix_cache_disk_dir", &SchedulerConfig::prefix_cache_disk_dir)
+        .def_readwrite("prefix_cache_snapshot_path", &SchedulerConfig::prefix_cache_snapshot_path)
+        .def_readwrite("scheduling_policy", &SchedulerConfig::scheduling_policy)
+        .def_readwrite("tenant_weights", &SchedulerConfig::tenant_weights)
+        .def_readwrite("num_scheduler_steps", &SchedulerConfig::num_scheduler_steps)
+        .def_readwrite("inter_token_latency_target_ms", &SchedulerConfig::inter_token_latency_target_ms)
         .def("to_string", &SchedulerConfig::to_string);
 
     py::class_<PipelineMetrics>(m, "PipelineMetrics", pipeline_metrics_docstring)
@@ -427,6 +464,9 @@ void init_continuous_batching_pipeline(py::module_& m) {
 
         .def("start_chat", &ContinuousBatchingPipeline::start_chat, py::arg("system_message") = "")
         .def("finish_chat", &ContinuousBatchingPipeline::finish_chat)
+        .def("save_prefix_cache", py::overload_cast<const std::filesystem::path&>(&ContinuousBatchingPipeline::save_prefix_cache), py::arg("path"))
+        .def("save_prefix_cache", py::overload_cast<const std::filesystem::path&, const ov::Tensor&>(&ContinuousBatchingPipeline::save_prefix_cache), py::arg("path"), py::arg("input_ids"))
+        .def("load_prefix_cache", &ContinuousBatchingPipeline::load_prefix_cache, py::arg("path"))
 
         .def(
             "generate",
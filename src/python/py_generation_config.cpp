@@ -193,6 +193,21 @@ char generation_config_docstring[] = R"(
     top_k:              the number of highest probability vocabulary tokens to keep for top-k-filtering.
     do_sample:          whether or not to use multinomial random sampling that add up to `top_p` or higher are kept.
     num_return_sequences: the number of sequences to generate from a single prompt.
+
+    Assisting generation parameters:
+    assistant_confidence_threshold: the lower token probability of candidate to be validated by main model in case of dynamic strategy candidates number update.
+    num_assistant_tokens: the defined candidates number to be generated by draft model/prompt lookup in case of static strategy candidates number update.
+    max_ngram_size:     maximum ngram to use when looking for matches in the prompt.
+    adaptive_num_assistant_tokens: if true, ContinuousBatching backend adjusts the number of candidates of the request every step between 1 and
+        2 * num_assistant_tokens from the observed acceptance rate and the measured durations of draft and main model steps.
+    prompt_lookup_corpus: token ids looked up by prompt lookup in addition to the prompt and the generated tokens, e.g. the tokenized
+        documents retrieved for the request.
+
+    Scheduling parameters (used by ContinuousBatching backend depending on SchedulerConfig.scheduling_policy):
+    priority:           importance of the request for SchedulingPolicy.PRIORITY, requests with a higher value are processed first.
+    ttft_target_ms:     time to first token target in milliseconds for SchedulingPolicy.EARLIEST_DEADLINE_FIRST, 0 means no target.
+    tpot_target_ms:     time per output token target in milliseconds for SchedulingPolicy.EARLIEST_DEADLINE_FIRST, 0 means no target.
+    tenant_id:          the tenant the request belongs to for SchedulingPolicy.FAIR_SHARE.
 )";
 
 
@@ -442,12 +457,18 @@ void init_generation_config(py::module_& m) {
         .def_readwrite("assistant_confidence_threshold", &GenerationConfig::assistant_confidence_threshold)
         .def_readwrite("num_assistant_tokens", &GenerationConfig::num_assistant_tokens)
         .def_readwrite("max_ngram_size", &GenerationConfig::max_ngram_size)
+        .def_readwrite("adaptive_num_assistant_tokens", &GenerationConfig::adaptive_num_assistant_tokens)
+        .def_readwrite("prompt_lookup_corpus", &GenerationConfig::prompt_lookup_corpus)
         .def_readwrite("include_stop_str_in_output", &GenerationConfig::include_stop_str_in_output)
         .def_readwrite("stop_token_ids", &GenerationConfig::stop_token_ids)
         .def_readwrite("structured_output_config", &GenerationConfig::structured_output_config)
         .def_readwrite("parsers", &GenerationConfig::parsers, py::keep_alive<1, 2>())
         .def_readwrite("adapters", &GenerationConfig::adapters)
         .def_readwrite("apply_chat_template", &GenerationConfig::apply_chat_template)
+        .def_readwrite("priority", &GenerationConfig::priority)
+        .def_readwrite("ttft_target_ms", &GenerationConfig::ttft_target_ms)
+        .def_readwrite("tpot_target_ms", &GenerationConfig::tpot_target_ms)
+        .def_readwrite("tenant_id", &GenerationConfig::tenant_id)
         .def("set_eos_token_id", &GenerationConfig::set_eos_token_id, py::arg("tokenizer_eos_token_id"))
         .def("is_beam_search", &GenerationConfig::is_beam_search)
         .def("is_greedy_decoding", &GenerationConfig::is_greedy_decoding)
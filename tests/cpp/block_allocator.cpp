@@ -138,6 +138,10 @@ TEST_F(PrefixCachingBlockAllocatorTest, HandlesFreesCorrectlyWithMixedHashFrees)
         EXPECT_EQ(allocator.num_free_blocks(0), 8);
         EXPECT_EQ(allocator.num_free_blocks(num_layers - 1), 8);
         EXPECT_EQ(allocator.num_overwriteable_blocks(), 0);  // mixed hash, can't store under blocks across layers under same hash
+        // the hashes are not cached anymore, so they can't be looked up in the prefix tree
+        EXPECT_FALSE(allocator.get_prefix_tree().contains(0));
+        EXPECT_FALSE(allocator.get_prefix_tree().contains(1));
+        EXPECT_TRUE(allocator.get_prefix_tree().contains(2));
     }
 
     {
@@ -216,6 +220,7 @@ TEST_F(PrefixCachingBlockAllocatorTest, HandlesHashCollisionsAtFreeCorrectly) {
     // this "free" should replace the old block with the same hash in the overwritable store
     allocator.free(second_hash_0_block);
     EXPECT_EQ(allocator.num_overwriteable_blocks(), 1);
+    EXPECT_TRUE(allocator.get_prefix_tree().contains(0));
 
     std::map<uint64_t, ov::genai::BlocksPerLayer> empty_map{};  // to force allocator to take the block from overwritable store
     auto internal_overwriteable_block = allocator.get_cached_block(0, empty_map);
@@ -268,3 +273,40 @@ TEST(TestBlockAllocator, CalculatesUsagePercentageCorrectlyWithPrefixCaching) {
         allocator.free(prefix_hash_map[allocated_block.first]);
     }
 }
+
+TEST(TestBlockAllocator, DecreasesNumberOfBlocksDownToOccupiedOnes) {
+    size_t num_layers = 3;
+    auto allocator = ov::genai::BlockAllocator(4, false, num_layers);
+    allocator.increase_kv_blocks_number(8);
+
+    std::vector<ov::genai::BlocksPerLayer> allocated_blocks;
+    for (size_t i = 0; i < 6; i++) {
+        allocated_blocks.push_back(allocator.allocate_block());
+    }
+    EXPECT_EQ(allocator.get_min_kv_blocks_number(), 6);
+
+    // a single block of a single layer keeps the pool from shrinking below it
+    auto one_block_from_some_layer = allocator.allocate_block(1);
+    EXPECT_EQ(one_block_from_some_layer->get_index(), 6);
+    EXPECT_EQ(allocator.get_min_kv_blocks_number(), 7);
+    allocator.free(one_block_from_some_layer, 1);
+
+    for (size_t i = 2; i < 6; i++) {
+        allocator.free(allocated_blocks[i]);
+    }
+    EXPECT_EQ(allocator.get_min_kv_blocks_number(), 2);
+    EXPECT_THROW(allocator.decrease_kv_blocks_number(1), ov::Exception);
+
+    allocator.decrease_kv_blocks_number(3);
+    EXPECT_EQ(allocator.get_total_number_of_kv_blocks(), 3);
+    for (size_t i = 0; i < num_layers; i++) {
+        EXPECT_EQ(allocator.num_free_blocks(i), 1);
+    }
+    auto blocks = allocator.allocate_block();
+    EXPECT_EQ(blocks[0]->get_index(), 2);
+    EXPECT_FALSE(allocator.can_allocate_blocks(1));
+
+    allocator.free(blocks);
+    allocator.free(allocated_blocks[0]);
+    allocator.free(allocated_blocks[1]);
+}
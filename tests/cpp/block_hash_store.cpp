@@ -52,3 +52,53 @@ TEST(TestBlockHashStore, general_test) {
     EXPECT_TRUE(block_hash_store.get_lru_block_to_overwrite().empty());
     EXPECT_EQ(block_hash_store.num_blocks(), 0);
 }
+
+TEST(TestBlockHashStore, overwrites_leaf_blocks_first) {
+    ov::genai::OverwritableBlocksHashStore block_hash_store(1);
+    auto block0 = std::make_shared<ov::genai::KVCacheBlock>(0);
+    block0->set_hash(10);
+    auto block1 = std::make_shared<ov::genai::KVCacheBlock>(1);
+    block1->set_hash(11);
+    auto block2 = std::make_shared<ov::genai::KVCacheBlock>(2);
+    block2->set_hash(12);
+    block_hash_store.add(ov::genai::BlocksPerLayer{block0});
+    block_hash_store.add(ov::genai::BlocksPerLayer{block1}, 10);
+    block_hash_store.add(ov::genai::BlocksPerLayer{block2}, 11);
+
+    // the oldest block starts the stored prefix and should only be overwritten after the blocks following it
+    EXPECT_EQ(block_hash_store.get_lru_block_to_overwrite()[0]->get_index(), 2);
+    EXPECT_EQ(block_hash_store.get_lru_block_to_overwrite()[0]->get_index(), 1);
+
+    // restoring a block makes its parent a leaf
+    block1->release();
+    block_hash_store.add(ov::genai::BlocksPerLayer{block1}, 10);
+    EXPECT_EQ(block_hash_store.get_block_to_restore(11)[0]->get_index(), 1);
+    EXPECT_EQ(block_hash_store.get_lru_block_to_overwrite()[0]->get_index(), 0);
+    EXPECT_EQ(block_hash_store.num_blocks(), 0);
+}
+
+TEST(TestBlockPrefixTree, general_test) {
+    ov::genai::BlockPrefixTree prefix_tree;
+    prefix_tree.insert(1, std::nullopt, 4);
+    prefix_tree.insert(2, 1, 4);
+    prefix_tree.insert(3, 1, 2);
+    prefix_tree.insert(4, 1, 3);
+    EXPECT_EQ(prefix_tree.size(), 4);
+    EXPECT_TRUE(prefix_tree.has_child(std::nullopt, 1));
+    EXPECT_TRUE(prefix_tree.has_child(1, 3));
+    EXPECT_FALSE(prefix_tree.has_child(std::nullopt, 3));
+    EXPECT_EQ(prefix_tree.get_prefix_hash(2), std::optional<size_t>(1));
+    EXPECT_EQ(prefix_tree.get_children_num_tokens(1), std::vector<size_t>({4, 3, 2}));
+
+    // children stay linked to the parent hash when the parent is removed
+    prefix_tree.erase(1);
+    EXPECT_FALSE(prefix_tree.contains(1));
+    EXPECT_TRUE(prefix_tree.has_child(1, 2));
+
+    prefix_tree.erase(3);
+    EXPECT_EQ(prefix_tree.get_children_num_tokens(1), std::vector<size_t>({4, 3}));
+
+    prefix_tree.clear();
+    EXPECT_EQ(prefix_tree.size(), 0);
+    EXPECT_TRUE(prefix_tree.get_children_num_tokens(std::nullopt).empty());
+}
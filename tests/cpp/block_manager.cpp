@@ -112,4 +112,56 @@ TEST(TestBlockManager, CanFreeBlocksFromSequence) {
     for (auto& sequence : sequence_group->get_sequences()) {
         bm.free_sequence(sequence->get_id());
     }
-}
\ No newline at end of file
+}
+TEST(TestBlockManager, BlockIndicesFollowBlockTables) {
+    const size_t NUM_LAYERS = 3;
+    ov::genai::BlockManager bm = ov::genai::BlockManager(16, false, 4, NUM_LAYERS);
+
+    std::vector<int64_t> tokens = {0,1,2,3,4,5};
+    ov::genai::SequenceGroup::Ptr sequence_group = std::make_shared<ov::genai::SequenceGroup>(
+            0,
+            ov::Tensor(ov::element::i64, {
+                    tokens.size()}, tokens.data()),
+            ov::genai::beam_search(),
+            4);
+
+    auto check_block_indices = [&](size_t seq_id) {
+        const auto& block_indices = bm.get_block_indices(seq_id);
+        ASSERT_EQ(block_indices.size(), NUM_LAYERS);
+        for (size_t layer_idx = 0; layer_idx < NUM_LAYERS; layer_idx++) {
+            const auto& block_table = bm.get_block_table(seq_id, layer_idx);
+            ASSERT_EQ(block_indices[layer_idx].size(), block_table.size());
+            for (size_t i = 0; i < block_table.size(); i++) {
+                EXPECT_EQ(block_indices[layer_idx][i], block_table[i]->get_index());
+            }
+        }
+    };
+
+    sequence_group->schedule_tokens(6);
+    bm.append_slots(sequence_group);
+    sequence_group->finish_iteration();
+    auto sequence = sequence_group->get_running_sequences()[0];
+    check_block_indices(sequence->get_id());
+
+    const auto forked_sequence = sequence_group->fork_sequence(sequence);
+    bm.fork_sequence(sequence->get_id(), forked_sequence->get_id());
+    check_block_indices(forked_sequence->get_id());
+
+    // the shared incomplete last block is copied on write
+    sequence_group->schedule_tokens(1);
+    EXPECT_FALSE(bm.append_slots(sequence_group).empty());
+    sequence_group->finish_iteration();
+    check_block_indices(sequence->get_id());
+    check_block_indices(forked_sequence->get_id());
+    EXPECT_NE(bm.get_block_indices(sequence->get_id())[0][1], bm.get_block_indices(forked_sequence->get_id())[0][1]);
+
+    bm.free_sequence_partially(forked_sequence->get_id(), 1);
+    check_block_indices(forked_sequence->get_id());
+    bm.free_sequence(forked_sequence->get_id());
+
+    bm.free_blocks_from_sequence(sequence->get_id(), { {0}, {1}, {0} });
+    check_block_indices(sequence->get_id());
+    EXPECT_EQ(bm.get_block_indices(sequence->get_id())[0].size(), 1);
+
+    bm.free_sequence(sequence->get_id());
+}
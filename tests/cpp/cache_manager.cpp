@@ -3,6 +3,10 @@
 //
 
 #include <gtest/gtest.h>
+
+#include <cstring>
+#include <numeric>
+
 #include "openvino/runtime/core.hpp"
 #include "continuous_batching/scheduler.hpp"
 #include "continuous_batching/cache_manager.hpp"
@@ -106,3 +110,83 @@ TEST(TestCacheManager, test_dynamic_cache_increase) {
     cache_manager->allocate_cache_if_needed(block_manager.get_total_number_of_kv_blocks());
     ASSERT_EQ(get_total_allocated_bytes(cache_manager), 200 * block_size_in_bytes);
 }
+
+
+TEST(TestCacheManager, test_copy_blocks) {
+    ov::Core core;
+    const size_t num_decoder_layers = 4;
+    const size_t num_kv_blocks = 16;
+
+    ov::InferRequest request = core.compile_model(get_dummy_model(core, num_decoder_layers)).create_infer_request();
+    auto cache_manager = std::make_shared<CacheManager>(request);
+    cache_manager->allocate_cache_if_needed(num_kv_blocks);
+
+    // fill each block with its own index
+    auto fill_blocks = [&](ov::Tensor cache) {
+        size_t block_size_in_bytes = cache.get_byte_size() / num_kv_blocks;
+        for (size_t block_id = 0; block_id < num_kv_blocks; block_id++) {
+            std::memset(static_cast<uint8_t*>(cache.data()) + block_id * block_size_in_bytes, static_cast<int>(block_id), block_size_in_bytes);
+        }
+    };
+    for (size_t i = 0; i < num_decoder_layers; i++) {
+        fill_blocks(cache_manager->get_key_cache(i));
+        fill_blocks(cache_manager->get_value_cache(i));
+    }
+
+    // 0-2 -> 5-7 form a single run, block 2 is additionally copied to 9 and 3 to 12
+    cache_manager->copy_blocks({{0, {5}}, {1, {6}}, {2, {9, 7}}, {3, {12}}});
+
+    std::vector<uint8_t> expected_block_contents(num_kv_blocks);
+    std::iota(expected_block_contents.begin(), expected_block_contents.end(), 0);
+    expected_block_contents[5] = 0;
+    expected_block_contents[6] = 1;
+    expected_block_contents[7] = 2;
+    expected_block_contents[9] = 2;
+    expected_block_contents[12] = 3;
+    auto check_blocks = [&](ov::Tensor cache) {
+        size_t block_size_in_bytes = cache.get_byte_size() / num_kv_blocks;
+        const uint8_t* data = static_cast<const uint8_t*>(cache.data());
+        for (size_t block_id = 0; block_id < num_kv_blocks; block_id++) {
+            for (size_t byte_idx = 0; byte_idx < block_size_in_bytes; byte_idx++) {
+                ASSERT_EQ(data[block_id * block_size_in_bytes + byte_idx], expected_block_contents[block_id]);
+            }
+        }
+    };
+    for (size_t i = 0; i < num_decoder_layers; i++) {
+        check_blocks(cache_manager->get_key_cache(i));
+        check_blocks(cache_manager->get_value_cache(i));
+    }
+}
+
+
+TEST(TestCacheManager, test_dynamic_cache_increase_keeps_data_in_place) {
+    ov::Core core;
+    const size_t num_decoder_layers = 4;
+
+    ov::InferRequest request = core.compile_model(get_dummy_model(core, num_decoder_layers)).create_infer_request();
+    auto cache_manager = std::make_shared<CacheManager>(request);
+    ASSERT_TRUE(cache_manager->can_shrink_cache());
+    size_t block_size_in_bytes = cache_manager->get_block_size_in_bytes();
+
+    cache_manager->allocate_cache_if_needed(10);
+    ov::Tensor key_cache = cache_manager->get_key_cache(0);
+    std::memset(key_cache.data(), 42, key_cache.get_byte_size());
+    const void* key_cache_data = key_cache.data();
+
+    cache_manager->allocate_cache_if_needed(100);
+    ASSERT_EQ(get_total_allocated_bytes(cache_manager), 100 * block_size_in_bytes);
+    ov::Tensor grown_key_cache = cache_manager->get_key_cache(0);
+    EXPECT_EQ(grown_key_cache.data(), key_cache_data);
+    const uint8_t* grown_key_cache_data = static_cast<const uint8_t*>(grown_key_cache.data());
+    EXPECT_EQ(grown_key_cache_data[0], 42);
+    EXPECT_EQ(grown_key_cache_data[key_cache.get_byte_size() - 1], 42);
+
+    cache_manager->shrink_cache(20);
+    ASSERT_EQ(get_total_allocated_bytes(cache_manager), 20 * block_size_in_bytes);
+    EXPECT_EQ(cache_manager->get_key_cache(0).data(), key_cache_data);
+    EXPECT_EQ(static_cast<const uint8_t*>(cache_manager->get_key_cache(0).data())[key_cache.get_byte_size() - 1], 42);
+
+    // does not grow the cache
+    cache_manager->shrink_cache(30);
+    ASSERT_EQ(get_total_allocated_bytes(cache_manager), 20 * block_size_in_bytes);
+}
@@ -0,0 +1,118 @@
+// Copyright (C) 2018-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include "openvino/runtime/core.hpp"
+#include "openvino/genai/generation_config.hpp"
+#include "sequence_group.hpp"
+#include "continuous_batching/block_manager.hpp"
+#include "continuous_batching/disk_block_cache.hpp"
+
+TEST(TestDiskBlockCache, general_test) {
+    std::filesystem::path path;
+    {
+        ov::genai::DiskBlockCache cache("", 2, 16);
+        path = cache.get_path();
+        EXPECT_TRUE(std::filesystem::exists(path));
+        EXPECT_EQ(cache.num_blocks(), 0);
+
+        auto slot0 = cache.put(100);
+        ASSERT_TRUE(slot0.has_value());
+        std::memset(cache.get_slot_data(*slot0), 1, 16);
+        auto slot1 = cache.put(200);
+        ASSERT_TRUE(slot1.has_value());
+        EXPECT_NE(*slot0, *slot1);
+        std::memset(cache.get_slot_data(*slot1), 2, 16);
+        EXPECT_EQ(cache.num_blocks(), 2);
+
+        // storing the same hash again reuses its slot
+        EXPECT_EQ(cache.put(100), slot0);
+        EXPECT_EQ(cache.num_blocks(), 2);
+
+        // the least recently stored block is dropped when full
+        auto slot2 = cache.put(300);
+        EXPECT_EQ(slot2, slot1);
+        EXPECT_FALSE(cache.contains(200));
+        EXPECT_TRUE(cache.contains(100));
+        EXPECT_TRUE(cache.contains(300));
+
+        // acquired slots are kept intact until released
+        auto acquired = cache.acquire(100);
+        ASSERT_EQ(acquired, slot0);
+        EXPECT_FALSE(cache.contains(100));
+        EXPECT_EQ(cache.get_slot_data(*acquired)[15], 1);
+        EXPECT_EQ(cache.put(400), slot2);
+        EXPECT_EQ(cache.put(500), slot2);
+        EXPECT_FALSE(cache.contains(400));
+        EXPECT_EQ(cache.get_slot_data(*acquired)[0], 1);
+        cache.release(*acquired);
+        EXPECT_FALSE(cache.acquire(100).has_value());
+    }
+    // backing file is removed with the cache
+    EXPECT_FALSE(std::filesystem::exists(path));
+}
+
+TEST(TestDiskBlockCache, disk_full) {
+    // the file is allocated on construction, so the lack of disk space is reported right away rather than by a fault
+    // on a write to the mapping
+    const std::filesystem::path dir = std::filesystem::temp_directory_path();
+    const size_t slot_byte_size = 1 << 20;
+    const size_t num_slots = std::filesystem::space(dir).available / slot_byte_size + 64;
+    EXPECT_THROW(ov::genai::DiskBlockCache cache(dir, num_slots, slot_byte_size), ov::Exception);
+}
+
+TEST(TestDiskBlockCache, block_manager_spills_and_restores_blocks) {
+    const size_t block_size = 4;
+    ov::genai::BlockManager bm(2, true, block_size);
+    auto disk_cache = std::make_shared<ov::genai::DiskBlockCache>("", 4, 16);
+    bm.set_disk_cache(disk_cache);
+
+    auto make_group = [&](uint64_t request_id, std::vector<int64_t>& tokens) {
+        return std::make_shared<ov::genai::SequenceGroup>(request_id, ov::Tensor(ov::element::i64, {tokens.size()}, tokens.data()),
+                                                          ov::genai::greedy(), block_size);
+    };
+
+    std::vector<int64_t> prompt_0 = {0, 1, 2, 3, 4, 5, 6, 7};
+    auto group_0 = make_group(0, prompt_0);
+    auto seq_0 = group_0->get_not_finished_sequences()[0];
+    bm.allocate(seq_0, 2, prompt_0.size());
+    bm.free_sequence(seq_0->get_id());
+    EXPECT_TRUE(bm.take_pending_disk_transfers().empty());
+
+    // a different prompt overwrites both cached blocks, which are stored to disk first
+    std::vector<int64_t> prompt_1 = {10, 11, 12, 13, 14, 15, 16, 17};
+    auto group_1 = make_group(1, prompt_1);
+    auto seq_1 = group_1->get_not_finished_sequences()[0];
+    bm.allocate(seq_1, 2, prompt_1.size());
+    auto transfers = bm.take_pending_disk_transfers();
+    ASSERT_EQ(transfers.size(), 2);
+    EXPECT_TRUE(transfers[0].to_disk && transfers[1].to_disk);
+    EXPECT_EQ(disk_cache->num_blocks(), 2);
+    bm.free_sequence(seq_1->get_id());
+
+    // the first prompt is restored from disk, each load preceded by storing the overwritten block
+    std::vector<int64_t> prompt_2 = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+    auto group_2 = make_group(2, prompt_2);
+    auto seq_2 = group_2->get_not_finished_sequences()[0];
+    bm.restore_cached_blocks(group_2);
+    EXPECT_EQ(group_2->get_num_processed_tokens(), 8);
+    EXPECT_EQ(bm.get_block_table(seq_2->get_id(), 0).size(), 2);
+
+    transfers = bm.take_pending_disk_transfers();
+    ASSERT_EQ(transfers.size(), 4);
+    for (size_t i = 0; i < transfers.size(); i++) {
+        EXPECT_EQ(transfers[i].to_disk, i % 2 == 0);
+        EXPECT_EQ(transfers[i].block_indices.size(), 1);
+    }
+    EXPECT_EQ(transfers[1].block_indices[0], bm.get_block_table(seq_2->get_id(), 0)[0]->get_index());
+    EXPECT_EQ(transfers[3].block_indices[0], bm.get_block_table(seq_2->get_id(), 0)[1]->get_index());
+    for (const auto& transfer : transfers) {
+        if (!transfer.to_disk) {
+            disk_cache->release(transfer.slot);
+        }
+    }
+    EXPECT_EQ(disk_cache->num_blocks(), 2);
+    bm.free_sequence(seq_2->get_id());
+}
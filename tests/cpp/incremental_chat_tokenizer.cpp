@@ -0,0 +1,149 @@
+// Copyright (C) 2018-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cctype>
+
+#include "tokenizer/incremental_chat_tokenizer.hpp"
+
+using namespace ov::genai;
+
+namespace {
+
+const std::map<std::string, int64_t> SPECIAL_TOKENS = {{"<|im_start|>", 1}, {"<|im_end|>", 2}};
+
+// encodes the special tokens as is, a run of letters as a single token and any other byte as a token
+class ToyTokenizer {
+public:
+    std::vector<int64_t> operator()(const std::string& text) {
+        m_encoded_texts.push_back(text);
+        std::vector<int64_t> token_ids;
+        for (size_t i = 0; i < text.size();) {
+            auto special_it = std::find_if(SPECIAL_TOKENS.begin(), SPECIAL_TOKENS.end(), [&](const auto& special_token) {
+                return text.compare(i, special_token.first.size(), special_token.first) == 0;
+            });
+            size_t size = 1;
+            if (special_it != SPECIAL_TOKENS.end()) {
+                token_ids.push_back(special_it->second);
+                i += special_it->first.size();
+                continue;
+            }
+            while (std::isalpha(text[i]) && i + size < text.size() && std::isalpha(text[i + size])) {
+                ++size;
+            }
+            token_ids.push_back(m_vocab.emplace(text.substr(i, size), m_vocab.size() + 100).first->second);
+            i += size;
+        }
+        return token_ids;
+    }
+
+    // the whole text may also be encoded to verify the result, so only the first encoded text is checked
+    std::vector<std::string> m_encoded_texts;
+
+private:
+    static inline std::map<std::string, int64_t> m_vocab;
+};
+
+std::string render(const std::vector<std::pair<std::string, std::string>>& messages, bool add_generation_prompt) {
+    std::string text;
+    for (const auto& [role, content] : messages) {
+        text += "<|im_start|>" + role + "\n" + content + "<|im_end|>\n";
+    }
+    return add_generation_prompt ? text + "<|im_start|>assistant\n" : text;
+}
+
+}  // namespace
+
+TEST(TestIncrementalChatTokenizer, encode_new_turn) {
+    ToyTokenizer toy_tokenizer;
+    IncrementalChatTokenizer tokenizer([&](const std::string& text) { return toy_tokenizer(text); }, SPECIAL_TOKENS);
+
+    std::vector<std::pair<std::string, std::string>> messages = {{"system", "Be brief"}, {"user", "Hi there"}};
+    const std::string first_turn = render(messages, true);
+    EXPECT_EQ(tokenizer.encode_ids(first_turn), ToyTokenizer()(first_turn));
+    EXPECT_EQ(toy_tokenizer.m_encoded_texts.at(0), first_turn);
+
+    messages.push_back({"assistant", "Hello"});
+    messages.push_back({"user", "How are you"});
+    const std::string second_turn = render(messages, true);
+    toy_tokenizer.m_encoded_texts.clear();
+    EXPECT_EQ(tokenizer.encode_ids(second_turn), ToyTokenizer()(second_turn));
+    // the text is encoded from the generation prompt of the first turn
+    EXPECT_EQ(toy_tokenizer.m_encoded_texts.at(0), second_turn.substr(first_turn.rfind("<|im_start|>")));
+}
+
+TEST(TestIncrementalChatTokenizer, changed_history) {
+    ToyTokenizer toy_tokenizer;
+    IncrementalChatTokenizer tokenizer([&](const std::string& text) { return toy_tokenizer(text); }, SPECIAL_TOKENS);
+
+    const std::string history = render({{"system", "Be brief"}, {"user", "Hi"}}, true);
+    tokenizer.encode_ids(history);
+
+    // the first message is changed
+    const std::string changed_history = render({{"system", "Be verbose"}, {"user", "Hi"}}, true);
+    toy_tokenizer.m_encoded_texts.clear();
+    EXPECT_EQ(tokenizer.encode_ids(changed_history), ToyTokenizer()(changed_history));
+    EXPECT_EQ(toy_tokenizer.m_encoded_texts.at(0), changed_history);
+
+    // the last turn is regenerated, the system message is reused
+    const std::string regenerated_history = render({{"system", "Be verbose"}, {"user", "Hello"}}, true);
+    toy_tokenizer.m_encoded_texts.clear();
+    EXPECT_EQ(tokenizer.encode_ids(regenerated_history), ToyTokenizer()(regenerated_history));
+    EXPECT_EQ(toy_tokenizer.m_encoded_texts.at(0), regenerated_history.substr(regenerated_history.find("<|im_start|>user")));
+
+    tokenizer.reset();
+    toy_tokenizer.m_encoded_texts.clear();
+    tokenizer.encode_ids(regenerated_history);
+    EXPECT_EQ(toy_tokenizer.m_encoded_texts.at(0), regenerated_history);
+}
+
+TEST(TestIncrementalChatTokenizer, misaligned_markers) {
+    ToyTokenizer toy_tokenizer;
+    // the toy tokenizer does not encode <|x|> as a single token
+    IncrementalChatTokenizer tokenizer([&](const std::string& text) { return toy_tokenizer(text); }, {{"<|x|>", 3}});
+
+    const std::string history = "<|x|>user\nHi<|x|>assistant\n";
+    EXPECT_EQ(tokenizer.encode_ids(history), ToyTokenizer()(history));
+    toy_tokenizer.m_encoded_texts.clear();
+    EXPECT_EQ(tokenizer.encode_ids(history + "Hello"), ToyTokenizer()(history + "Hello"));
+    EXPECT_EQ(toy_tokenizer.m_encoded_texts.at(0), history + "Hello");
+}
+
+TEST(TestIncrementalChatTokenizer, markers_are_disabled_on_mismatch) {
+    // the tokenizer adds a token at the start of each text, so the text after a marker is encoded differently
+    auto encode_with_prefix = [](ToyTokenizer& toy_tokenizer, const std::string& text) {
+        std::vector<int64_t> token_ids = {0};
+        const std::vector<int64_t> text_token_ids = toy_tokenizer(text);
+        token_ids.insert(token_ids.end(), text_token_ids.begin(), text_token_ids.end());
+        return token_ids;
+    };
+    ToyTokenizer toy_tokenizer, reference_tokenizer;
+    IncrementalChatTokenizer tokenizer([&](const std::string& text) { return encode_with_prefix(toy_tokenizer, text); }, SPECIAL_TOKENS);
+
+    std::vector<std::pair<std::string, std::string>> messages = {{"user", "Hi"}};
+    const std::string first_turn = render(messages, true);
+    EXPECT_EQ(tokenizer.encode_ids(first_turn), encode_with_prefix(reference_tokenizer, first_turn));
+
+    messages.push_back({"assistant", "Hello"});
+    messages.push_back({"user", "How are you"});
+    const std::string second_turn = render(messages, true);
+    EXPECT_EQ(tokenizer.encode_ids(second_turn), encode_with_prefix(reference_tokenizer, second_turn));
+
+    // the markers are disabled, so the whole history is encoded
+    messages.push_back({"assistant", "Fine"});
+    messages.push_back({"user", "Bye"});
+    const std::string third_turn = render(messages, true);
+    toy_tokenizer.m_encoded_texts.clear();
+    EXPECT_EQ(tokenizer.encode_ids(third_turn), encode_with_prefix(reference_tokenizer, third_turn));
+    EXPECT_EQ(toy_tokenizer.m_encoded_texts.at(0), third_turn);
+}
+
+TEST(TestIncrementalChatTokenizer, find_marker_candidates) {
+    const std::string chat_template = "{% for message in messages %}{{'<|im_start|>' + message['role'] + '\\n' + message['content'] + "
+                                      "'<|im_end|>' + '\\n'}}{% endfor %}{{ bos_token + '[INST]' + '<start_of_turn>' }}";
+    EXPECT_EQ(IncrementalChatTokenizer::find_marker_candidates(chat_template),
+              std::set<std::string>({"<|im_start|>", "<|im_end|>", "[INST]", "<start_of_turn>"}));
+}
@@ -0,0 +1,90 @@
+// Copyright (C) 2018-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "lock_free_queue.hpp"
+
+namespace {
+
+constexpr size_t NUM_PRODUCERS = 8;
+constexpr size_t NUM_ITEMS_PER_PRODUCER = 20000;
+
+// Runs NUM_PRODUCERS threads pushing into the queue while the calling thread consumes.
+// Every item encodes its producer and sequence number, so that the per-producer FIFO order and completeness are verified.
+template <typename PushFn, typename PopFn>
+void run_contention(PushFn push, PopFn try_pop) {
+    std::vector<size_t> next_expected(NUM_PRODUCERS, 0);
+    std::vector<std::thread> producers;
+    for (size_t producer = 0; producer < NUM_PRODUCERS; ++producer) {
+        producers.emplace_back([producer, &push] {
+            for (size_t i = 0; i < NUM_ITEMS_PER_PRODUCER; ++i) {
+                push(producer * NUM_ITEMS_PER_PRODUCER + i);
+            }
+        });
+    }
+    size_t num_received = 0, item = 0;
+    while (num_received < NUM_PRODUCERS * NUM_ITEMS_PER_PRODUCER) {
+        if (!try_pop(item)) {
+            std::this_thread::yield();
+            continue;
+        }
+        size_t producer = item / NUM_ITEMS_PER_PRODUCER;
+        EXPECT_EQ(item % NUM_ITEMS_PER_PRODUCER, next_expected[producer]);
+        next_expected[producer] = item % NUM_ITEMS_PER_PRODUCER + 1;
+        ++num_received;
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+}
+
+}  // namespace
+
+TEST(TestLockFreeQueue, mpsc_queue) {
+    MPSCQueue<int> queue;
+    int item = 0;
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.try_pop(item));
+    queue.push(1);
+    queue.push(2);
+    EXPECT_FALSE(queue.empty());
+    ASSERT_TRUE(queue.try_pop(item));
+    EXPECT_EQ(item, 1);
+    ASSERT_TRUE(queue.try_pop(item));
+    EXPECT_EQ(item, 2);
+    EXPECT_TRUE(queue.empty());
+    // remaining elements are released with the queue
+    queue.push(3);
+}
+
+TEST(TestLockFreeQueue, mpsc_queue_concurrent_producers) {
+    MPSCQueue<size_t> queue;
+    run_contention([&](size_t item) { queue.push(item); },
+                   [&](size_t& item) { return queue.try_pop(item); });
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(TestLockFreeQueue, spsc_queue_blocking_pull) {
+    SPSCQueue<std::vector<int>> queue;
+    EXPECT_TRUE(queue.empty());
+    std::thread producer([&queue] {
+        for (int i = 0; i < 1000; ++i) {
+            if (i % 100 == 0) {
+                // let the consumer go to sleep
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            queue.push({i});
+        }
+    });
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(queue.pull(), std::vector<int>{i});
+    }
+    producer.join();
+    EXPECT_TRUE(queue.empty());
+}
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <gtest/gtest.h>
+#include <random>
 #include <openvino/core/except.hpp>
 
 #include "sampling/logit_processor.hpp"
@@ -128,6 +129,70 @@ TEST(TopKFilteringTest, FilterNotAppliedTopKGreaterThanInputSize) {
     }
 }
 
+namespace {
+// softmax of random logits with repeated values, so that the selection also has to deal with ties
+std::vector<float> get_random_probabilities(size_t size, size_t seed) {
+    std::mt19937 generator(seed);
+    std::normal_distribution<float> distribution(0.0f, 4.0f);
+    std::vector<float> probabilities(size);
+    for (auto& probability : probabilities) {
+        probability = std::round(distribution(generator) * 8.0f) / 8.0f;
+    }
+    auto logits = Logits(probabilities.data(), size);
+    TemperatureLogitTransform(1.0).apply(logits);
+    return probabilities;
+}
+
+std::vector<Token> get_sorted_tokens(const std::vector<float>& probabilities) {
+    std::vector<Token> tokens;
+    for (size_t i = 0; i < probabilities.size(); i++) {
+        tokens.emplace_back(probabilities[i], i);
+    }
+    std::sort(tokens.begin(), tokens.end(), Logits::is_greater);
+    return tokens;
+}
+
+void expect_tokens_equal(const Logits& logits, const std::vector<Token>& expected_tokens) {
+    ASSERT_EQ(logits.m_size, expected_tokens.size());
+    ASSERT_EQ(logits.m_vector.size(), expected_tokens.size());
+    for (size_t i = 0; i < expected_tokens.size(); i++) {
+        EXPECT_EQ(logits.m_vector[i].m_log_prob, expected_tokens[i].m_log_prob);
+        EXPECT_EQ(logits.m_vector[i].m_index, expected_tokens[i].m_index);
+    }
+}
+}  // namespace
+
+TEST(TopKFilteringTest, LargeVocabularyEqualToFullSort) {
+    for (size_t top_k : {1, 7, 50, 1000}) {
+        auto probabilities = get_random_probabilities(50000, top_k);
+        auto expected_tokens = get_sorted_tokens(probabilities);
+        expected_tokens.resize(top_k);
+
+        auto logits = Logits(probabilities.data(), probabilities.size());
+        TopKFilter(top_k).apply(logits);
+        expect_tokens_equal(logits, expected_tokens);
+    }
+}
+
+TEST(TopPFilteringTest, LargeVocabularyEqualToFullSort) {
+    for (double top_p : {0.1, 0.5, 0.9, 0.999, 1.5}) {
+        auto probabilities = get_random_probabilities(50000, size_t(top_p * 1000));
+        auto expected_tokens = get_sorted_tokens(probabilities);
+        float probability_sum = 0.0f;
+        size_t nucleus_size = 0;
+        for (const auto& token : expected_tokens) {
+            probability_sum += token.m_log_prob;
+            nucleus_size += 1;
+            if (probability_sum > top_p) break;
+        }
+        expected_tokens.resize(nucleus_size);
+
+        auto logits = Logits(probabilities.data(), probabilities.size());
+        TopPFilter(top_p).apply(logits);
+        expect_tokens_equal(logits, expected_tokens);
+    }
+}
+
 struct RepetitionPenaltyTransformTestStruct {
     static inline const size_t size = 3;
 
@@ -304,6 +369,46 @@ TEST(PresencePenaltyTransformInitializationTest, ThrowsForInvalidInputIds) {
     EXPECT_THROW(transform.apply(logits, {0, -1}), ov::Exception);
 }
 
+TEST(CombinedPenaltyTransformTest, EqualToSequentialPenalties) {
+    const size_t vocab_size = 1000;
+    std::mt19937 generator(42);
+    std::normal_distribution<float> logit_distribution(0.0f, 4.0f);
+    std::uniform_int_distribution<int64_t> token_distribution(0, vocab_size - 1);
+
+    auto prompt_ids = std::make_shared<std::set<int64_t>>();
+    auto generated_ids = std::make_shared<std::map<int64_t, size_t>>();
+    for (size_t i = 0; i < 100; i++) {
+        prompt_ids->insert(token_distribution(generator));
+        (*generated_ids)[token_distribution(generator)] += 1;
+    }
+    std::vector<float> input(vocab_size);
+    for (auto& logit : input) {
+        logit = logit_distribution(generator);
+    }
+
+    std::vector<float> expected_output = input;
+    auto expected_logits = Logits(expected_output.data(), vocab_size);
+    RepetitionPenaltyTransform repetition_penalty(1.3);
+    repetition_penalty.set_unique_prompt_token_ids(prompt_ids);
+    repetition_penalty.set_unique_generated_token_ids(generated_ids);
+    repetition_penalty.apply(expected_logits);
+    PresencePenaltyTransform presence_penalty(0.7);
+    presence_penalty.set_unique_generated_token_ids(generated_ids);
+    presence_penalty.apply(expected_logits);
+    FrequencyPenaltyTransform frequency_penalty(0.4);
+    frequency_penalty.set_unique_generated_token_ids(generated_ids);
+    frequency_penalty.apply(expected_logits);
+
+    auto logits = Logits(input.data(), vocab_size);
+    CombinedPenaltyTransform transform(1.3, 0.7, 0.4);
+    transform.set_unique_prompt_token_ids(prompt_ids);
+    transform.set_unique_generated_token_ids(generated_ids);
+    transform.apply(logits);
+    for (size_t i = 0; i < vocab_size; i++) {
+        EXPECT_EQ(input[i], expected_output[i]);
+    }
+}
+
 struct EOSPenaltyTransformTestStruct {
     static inline const size_t size = 3;
 
@@ -0,0 +1,62 @@
+// Copyright (C) 2018-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <gtest/gtest.h>
+
+#include "prompt_lookup/ngram_index.hpp"
+
+using namespace ov::genai;
+
+TEST(TestNgramIndex, longest_earliest_match) {
+    NgramIndex index(3);
+    // 1 2 3 occurs at 0 and the suffix 2 3 occurs at 1, 5 and at the end
+    index.append({1, 2, 3, 4, 5, 2, 3, 6, 7, 1, 2, 3});
+    EXPECT_EQ(index.get_candidates(2), TokenIds({4, 5}));
+    EXPECT_EQ(index.get_candidates(100), TokenIds({4, 5, 2, 3, 6, 7, 1, 2, 3}));
+    EXPECT_TRUE(index.get_candidates(0).empty());
+
+    // 9 3 does not occur earlier, but 3 does
+    index.append(9);
+    index.append(3);
+    EXPECT_EQ(index.get_candidates(3), TokenIds({4, 5, 2}));
+
+    // the last token does not occur earlier
+    index.append(8);
+    EXPECT_TRUE(index.get_candidates(3).empty());
+}
+
+TEST(TestNgramIndex, overlapping_match) {
+    NgramIndex index(2);
+    index.append({5, 5, 5});
+    EXPECT_EQ(index.get_candidates(4), TokenIds({5}));
+}
+
+TEST(TestNgramIndex, truncate) {
+    NgramIndex index(2);
+    index.append({1, 2, 3});
+    // candidates 1 2 3 are appended, then rejected
+    index.append({1, 2, 3});
+    index.truncate(3);
+    EXPECT_EQ(index.get_token_ids(), TokenIds({1, 2, 3}));
+    EXPECT_TRUE(index.get_candidates(2).empty());
+
+    index.append(2);
+    EXPECT_EQ(index.get_candidates(2), TokenIds({3, 2}));
+    index.truncate(10);
+    EXPECT_EQ(index.size(), 4);
+}
+
+TEST(TestNgramIndex, corpus) {
+    NgramIndex corpus(2);
+    corpus.append({7, 8, 9, 10, 11});
+
+    NgramIndex index(2);
+    index.append({1, 8, 9});
+    EXPECT_TRUE(index.get_candidates(2).empty());
+    EXPECT_EQ(index.get_candidates(2, &corpus), TokenIds({10, 11}));
+
+    // the sequence itself is preferred to the corpus
+    index.append({2, 8, 9});
+    EXPECT_EQ(index.get_candidates(2, &corpus), TokenIds({2, 8}));
+}
@@ -0,0 +1,53 @@
+// Copyright (C) 2018-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <gtest/gtest.h>
+
+#include "continuous_batching/prefill_token_budget.hpp"
+
+using namespace ov::genai;
+
+TEST(TestPrefillTokenBudget, whole_batch_until_measured) {
+    PrefillTokenBudget budget(20.0f, 4, 256);
+    EXPECT_EQ(budget.get_budget(), 256);
+    // steps without tokens are ignored
+    budget.register_step(0, 0, 100.0f);
+    EXPECT_EQ(budget.get_budget(), 256);
+    // the base duration alone does not limit the prompt tokens
+    budget.register_step(8, 0, 10.0f);
+    EXPECT_EQ(budget.get_budget(), 256);
+}
+
+TEST(TestPrefillTokenBudget, follows_latency_target) {
+    PrefillTokenBudget budget(20.0f, 4, 256);
+    // a step without generated tokens is attributed to its prompt tokens
+    budget.register_step(0, 100, 50.0f);
+    EXPECT_EQ(budget.get_budget(), 40);
+
+    // generated tokens take half of the target
+    budget.register_step(8, 0, 10.0f);
+    EXPECT_EQ(budget.get_budget(), 20);
+
+    // a measurement consistent with the model keeps the budget
+    budget.register_step(8, 20, 20.0f);
+    EXPECT_EQ(budget.get_budget(), 20);
+
+    // prompt tokens turned out to be cheaper
+    for (size_t i = 0; i < 50; ++i) {
+        budget.register_step(8, 20, 15.0f);
+    }
+    EXPECT_NEAR(static_cast<float>(budget.get_budget()), 40.0f, 1.0f);
+}
+
+TEST(TestPrefillTokenBudget, clamps_budget) {
+    PrefillTokenBudget budget(20.0f, 4, 64);
+    budget.register_step(0, 10, 1.0f);
+    EXPECT_EQ(budget.get_budget(), 64);
+
+    // generated tokens alone exceed the target, prompts still progress
+    for (size_t i = 0; i < 10; ++i) {
+        budget.register_step(8, 0, 30.0f);
+    }
+    EXPECT_EQ(budget.get_budget(), 4);
+}
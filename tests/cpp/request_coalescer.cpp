@@ -0,0 +1,116 @@
+// Copyright (C) 2018-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <stdexcept>
+#include <thread>
+
+#include "tokenizer/request_coalescer.hpp"
+
+using namespace ov::genai;
+
+namespace {
+
+using Coalescer = RequestCoalescer<int, std::string>;
+
+std::vector<std::string> to_strings(const std::vector<const int*>& inputs) {
+    std::vector<std::string> outputs;
+    for (const int* input : inputs) {
+        outputs.push_back(std::to_string(*input));
+    }
+    return outputs;
+}
+
+}  // namespace
+
+TEST(TestRequestCoalescer, sequential_calls_are_not_delayed) {
+    // the window is long enough to fail the test by timeout if a call waits for it
+    Coalescer coalescer(std::chrono::hours(1), 8, 1);
+    std::vector<size_t> batch_sizes;
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(coalescer.submit("", i, [&](const std::vector<const int*>& inputs) {
+            batch_sizes.push_back(inputs.size());
+            return to_strings(inputs);
+        }), std::to_string(i));
+    }
+    EXPECT_EQ(batch_sizes, std::vector<size_t>({1, 1, 1}));
+}
+
+TEST(TestRequestCoalescer, concurrent_calls_are_batched) {
+    constexpr size_t batch_size = 4;
+    Coalescer coalescer(std::chrono::hours(1), batch_size, 1);
+    std::mutex batch_sizes_mutex;
+    std::vector<size_t> batch_sizes;
+    auto run_batch = [&](const std::vector<const int*>& inputs) {
+        std::lock_guard<std::mutex> lock(batch_sizes_mutex);
+        batch_sizes.push_back(inputs.size());
+        return to_strings(inputs);
+    };
+
+    // the first call occupies the only slot, so the next calls wait until their batch is full
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::promise<void> blocked;
+    std::thread blocking_thread([&] {
+        const int input = -1;
+        EXPECT_EQ(coalescer.submit("", input, [&](const std::vector<const int*>& inputs) {
+            blocked.set_value();
+            released.wait();
+            return to_strings(inputs);
+        }), "-1");
+    });
+    blocked.get_future().wait();
+
+    std::vector<std::future<std::string>> outputs;
+    for (int i = 0; i < static_cast<int>(batch_size); ++i) {
+        outputs.push_back(std::async(std::launch::async, [&, i] {
+            return coalescer.submit("", i, run_batch);
+        }));
+    }
+    for (int i = 0; i < static_cast<int>(batch_size); ++i) {
+        EXPECT_EQ(outputs[i].get(), std::to_string(i));
+    }
+    release.set_value();
+    blocking_thread.join();
+    EXPECT_EQ(batch_sizes, std::vector<size_t>({batch_size}));
+}
+
+TEST(TestRequestCoalescer, keys_are_not_mixed) {
+    Coalescer coalescer(std::chrono::milliseconds(10), 16, 1);
+    std::vector<std::future<std::string>> outputs;
+    for (int i = 0; i < 16; ++i) {
+        const std::string key = std::to_string(i % 2);
+        outputs.push_back(std::async(std::launch::async, [&, i, key] {
+            return coalescer.submit(key, i, [key](const std::vector<const int*>& inputs) {
+                std::vector<std::string> outputs = to_strings(inputs);
+                for (auto& output : outputs) {
+                    output += "/" + key;
+                }
+                return outputs;
+            });
+        }));
+    }
+    for (int i = 0; i < 16; ++i) {
+        EXPECT_EQ(outputs[i].get(), std::to_string(i) + "/" + std::to_string(i % 2));
+    }
+}
+
+TEST(TestRequestCoalescer, exception_is_rethrown) {
+    Coalescer coalescer(std::chrono::milliseconds(10), 4, 1);
+    std::vector<std::future<std::string>> outputs;
+    for (int i = 0; i < 8; ++i) {
+        outputs.push_back(std::async(std::launch::async, [&, i] {
+            return coalescer.submit("", i, [](const std::vector<const int*>&) -> std::vector<std::string> {
+                throw std::runtime_error("failed");
+            });
+        }));
+    }
+    for (auto& output : outputs) {
+        EXPECT_THROW(output.get(), std::runtime_error);
+    }
+    // the coalescer stays usable
+    EXPECT_EQ(coalescer.submit("", 1, to_strings), "1");
+}
@@ -0,0 +1,67 @@
+// Copyright (C) 2018-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "openvino/core/except.hpp"
+#include "continuous_batching/reserved_memory.hpp"
+
+using namespace ov::genai;
+
+TEST(TestReservedMemory, grows_in_place_and_shrinks) {
+    const size_t chunk_size = 1024 * 1024;
+    ReservedMemory memory(64 * chunk_size, chunk_size);
+    EXPECT_EQ(memory.get_capacity(), 64 * chunk_size);
+    EXPECT_EQ(memory.get_committed_size(), 0);
+
+    memory.resize(100);
+    EXPECT_EQ(memory.get_committed_size(), chunk_size);
+    std::memset(memory.data(), 7, chunk_size);
+
+    uint8_t* data = memory.data();
+    memory.resize(5 * chunk_size);
+    EXPECT_EQ(memory.data(), data);
+    EXPECT_EQ(memory.data()[chunk_size - 1], 7);
+    EXPECT_EQ(memory.data()[5 * chunk_size - 1], 0);
+
+    // released chunks are zero-filled when committed again
+    std::memset(memory.data(), 9, 5 * chunk_size);
+    memory.resize(chunk_size);
+    memory.resize(2 * chunk_size);
+    EXPECT_EQ(memory.data()[chunk_size - 1], 9);
+    EXPECT_EQ(memory.data()[chunk_size], 0);
+
+    EXPECT_THROW(memory.resize(64 * chunk_size + 1), ov::Exception);
+}
+
+TEST(TestReservedMemory, falls_back_to_allocation) {
+    const size_t chunk_size = 1024 * 1024;
+    // the capacity exceeds the address space, so it can not be reserved
+    ReservedMemory memory(size_t(1) << 62, chunk_size);
+    EXPECT_FALSE(memory.is_reserved());
+    EXPECT_EQ(memory.get_committed_size(), 0);
+
+    memory.resize(100);
+    EXPECT_EQ(memory.get_committed_size(), chunk_size);
+    std::memset(memory.data(), 7, chunk_size);
+
+    memory.resize(5 * chunk_size);
+    EXPECT_EQ(memory.data()[chunk_size - 1], 7);
+    EXPECT_EQ(memory.data()[5 * chunk_size - 1], 0);
+
+    std::memset(memory.data(), 9, 5 * chunk_size);
+    memory.resize(chunk_size);
+    memory.resize(2 * chunk_size);
+    EXPECT_EQ(memory.data()[chunk_size - 1], 9);
+    EXPECT_EQ(memory.data()[chunk_size], 0);
+
+    memory.resize(0);
+    EXPECT_EQ(memory.get_committed_size(), 0);
+}
+
+TEST(TestReservedMemory, physical_memory_size) {
+    EXPECT_GT(ReservedMemory::get_physical_memory_size(), 0);
+}
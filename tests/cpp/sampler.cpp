@@ -300,3 +300,130 @@ TEST(SamplerValidationMode, prompt_phase) {
              expected{0, 1, 2, 3};
     ASSERT_EQ(sequence_groups.front()->get_sequences().front()->get_generated_ids(), expected);
 }
+
+namespace {
+
+const std::map<int64_t, std::string> TOY_VOCAB = {
+    {1, "Hello"}, {2, " wor"}, {3, "ld"}, {4, " Obs"}, {5, "ervation"}, {6, ":"}, {7, " "}, {8, "\n"}, {9, "STOP"},
+    // the bytes of "停"
+    {10, "\xE5"}, {11, "\x81"}, {12, "\x9C"},
+};
+
+// decodes the tokens as the concatenation of their bytes, with invalid UTF-8 replaced by U+FFFD
+// and without the leading space of the text like SentencePiece detokenizers do
+std::string toy_decode(const std::vector<int64_t>& token_ids) {
+    std::string bytes;
+    for (int64_t token_id : token_ids) {
+        bytes += TOY_VOCAB.at(token_id);
+    }
+    std::string text;
+    for (size_t i = 0; i < bytes.size();) {
+        const auto lead = static_cast<unsigned char>(bytes[i]);
+        const size_t length = lead < 0x80 ? 1 : lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : lead >= 0xC0 ? 2 : 0;
+        bool is_valid = length > 0 && i + length <= bytes.size();
+        for (size_t j = 1; is_valid && j < length; ++j) {
+            is_valid = (static_cast<unsigned char>(bytes[i + j]) & 0xC0) == 0x80;
+        }
+        text += is_valid ? bytes.substr(i, length) : "\xEF\xBF\xBD";
+        i += is_valid ? length : 1;
+    }
+    return !text.empty() && text[0] == ' ' ? text.substr(1) : text;
+}
+
+// appends the tokens one by one, matching the stop strings after each of them as the sampler does
+MatchStopStringResult append_and_match(TokenPieces& token_pieces, const StopStringMatcher& matcher, Sequence::Ptr sequence,
+                                       const std::vector<int64_t>& token_ids, bool is_include_to_output = false) {
+    MatchStopStringResult result;
+    for (int64_t token_id : token_ids) {
+        EXPECT_FALSE(result.is_matched);
+        sequence->append_token(token_id, 0.f);
+        result = match_stop_string(token_pieces, matcher, sequence, is_include_to_output);
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST(SamplerStopStringTest, cut_point) {
+    TokenPieces token_pieces(toy_decode);
+    const StopStringMatcher matcher({"Observation:"});
+    auto sequence = Sequence::create(0);
+    auto result = append_and_match(token_pieces, matcher, sequence, {1, 2, 3, 4, 5, 6});
+    ASSERT_TRUE(result.is_matched);
+    // " Obs" is removed with the stop string, as only the space is left of it
+    EXPECT_EQ(result.to_remove, 3);
+
+    auto included = Sequence::create(1);
+    result = append_and_match(token_pieces, matcher, included, {1, 2, 3, 4, 5, 6}, true);
+    ASSERT_TRUE(result.is_matched);
+    EXPECT_EQ(result.to_remove, 0);
+}
+
+TEST(SamplerStopStringTest, trailing_spaces_are_trimmed) {
+    TokenPieces token_pieces(toy_decode);
+    const StopStringMatcher matcher({"STOP"});
+    auto sequence = Sequence::create(0);
+    auto result = append_and_match(token_pieces, matcher, sequence, {1, 7, 8, 9});
+    ASSERT_TRUE(result.is_matched);
+    EXPECT_EQ(result.to_remove, 3);
+}
+
+TEST(SamplerStopStringTest, character_split_into_tokens) {
+    TokenPieces token_pieces(toy_decode);
+    const StopStringMatcher matcher({"停"});
+    auto sequence = Sequence::create(0);
+    auto result = append_and_match(token_pieces, matcher, sequence, {1, 10, 11});
+    EXPECT_FALSE(result.is_matched);
+    // the bytes of the incomplete character are not fed yet
+    EXPECT_EQ(sequence->get_stop_string_states().size(), 3);
+    EXPECT_EQ(sequence->get_stop_string_states()[1], StopStringMatcher::PENDING_STATE);
+    EXPECT_EQ(sequence->get_stop_string_states()[2], StopStringMatcher::PENDING_STATE);
+
+    result = append_and_match(token_pieces, matcher, sequence, {12});
+    ASSERT_TRUE(result.is_matched);
+    // all the tokens of the character are removed
+    EXPECT_EQ(result.to_remove, 3);
+
+    // the character is matched after a rollback of its last bytes as well
+    sequence->remove_last_tokens(2);
+    EXPECT_EQ(sequence->get_stop_string_states().size(), 2);
+    result = append_and_match(token_pieces, matcher, sequence, {11, 12}, true);
+    ASSERT_TRUE(result.is_matched);
+    EXPECT_EQ(result.to_remove, 0);
+}
+
+TEST(SamplerStopStringTest, remove_last_tokens_truncates_states) {
+    TokenPieces token_pieces(toy_decode);
+    const StopStringMatcher matcher({"Observation:"});
+    auto sequence = Sequence::create(0);
+    EXPECT_FALSE(append_and_match(token_pieces, matcher, sequence, {1, 4, 5, 3}).is_matched);
+    EXPECT_EQ(sequence->get_stop_string_states().size(), 4);
+
+    // e.g. the candidates are not accepted by the main model in speculative decoding
+    sequence->remove_last_tokens(1);
+    EXPECT_EQ(sequence->get_stop_string_states().size(), 3);
+    auto result = append_and_match(token_pieces, matcher, sequence, {6});
+    ASSERT_TRUE(result.is_matched);
+    EXPECT_EQ(result.to_remove, 3);
+}
+
+TEST(SamplerStopStringTest, forked_sequence) {
+    TokenPieces token_pieces(toy_decode);
+    const StopStringMatcher matcher({"Observation:"});
+    auto parent = Sequence::create(0);
+    EXPECT_FALSE(append_and_match(token_pieces, matcher, parent, {1, 4, 5}).is_matched);
+    auto child = Sequence::fork(parent, 1);
+    EXPECT_EQ(child->get_stop_string_states(), parent->get_stop_string_states());
+
+    // beam search matches a candidate token before it is appended
+    auto result = match_stop_string(token_pieces, matcher, child, false, 6);
+    ASSERT_TRUE(result.is_matched);
+    EXPECT_EQ(result.to_remove, 3);
+    EXPECT_FALSE(match_stop_string(token_pieces, matcher, parent, false, 3).is_matched);
+    // the state after the candidate token is not stored
+    EXPECT_EQ(parent->get_stop_string_states().size(), 3);
+
+    // the sequences continue from their own states
+    EXPECT_TRUE(append_and_match(token_pieces, matcher, child, {6}).is_matched);
+    EXPECT_FALSE(append_and_match(token_pieces, matcher, parent, {3, 6}).is_matched);
+}
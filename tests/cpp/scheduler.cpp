@@ -3,12 +3,14 @@
 //
 
 #include <gtest/gtest.h>
+#include <fstream>
 #include "openvino/runtime/core.hpp"
 #include "openvino/op/concat.hpp"
 #include "openvino/genai/continuous_batching_pipeline.hpp"
 #include "openvino/genai/generation_config.hpp"
 #include "sequence_group.hpp"
 #include "continuous_batching/scheduler.hpp"
+#include "continuous_batching/prefix_cache_snapshot.hpp"
 #include "helper.hpp"
 
 using namespace ov::genai;
@@ -69,9 +71,9 @@ TEST(TestScheduler, general_test) {
 
         std::vector<uint64_t> ref_ids = {0, 1, 2};
         EXPECT_EQ(out1.m_scheduled_sequence_groups_ids, ref_ids);
-        EXPECT_EQ(out1.m_block_tables[idx0][0].size(), 2);
-        EXPECT_EQ(out1.m_block_tables[idx1][0].size(), 2);
-        EXPECT_EQ(out1.m_block_tables[idx2][0].size(), 2);
+        EXPECT_EQ(out1.m_block_indices.at(idx0)->at(0).size(), 2);
+        EXPECT_EQ(out1.m_block_indices.at(idx1)->at(0).size(), 2);
+        EXPECT_EQ(out1.m_block_indices.at(idx2)->at(0).size(), 2);
         // tokens.size() * 2 tokens should be scheduled on prompt phase, corresponding to first three sequences
         EXPECT_EQ(out1.m_total_num_scheduled_tokens, tokens.size() * 3);
         EXPECT_EQ(out1.is_prompt, !scheduler_config.dynamic_split_fuse);
@@ -96,8 +98,8 @@ TEST(TestScheduler, general_test) {
 
         std::vector<uint64_t> ref_ids2 = {0, 1};
         EXPECT_EQ(out3.m_scheduled_sequence_groups_ids, ref_ids2);
-        EXPECT_EQ(out3.m_block_tables[idx0][0].size(), 3);
-        EXPECT_EQ(out3.m_block_tables[idx1][0].size(), 3);
+        EXPECT_EQ(out3.m_block_indices.at(idx0)->at(0).size(), 3);
+        EXPECT_EQ(out3.m_block_indices.at(idx1)->at(0).size(), 3);
         // 2 tokens should be scheduled on generate phase for "0" and "1" sequence, "2" sequence should be preempted
         EXPECT_EQ(out3.m_total_num_scheduled_tokens, 2);
         EXPECT_FALSE(out3.is_prompt);
@@ -115,11 +117,11 @@ TEST(TestScheduler, general_test) {
         auto out4 = scheduler.schedule(requests);
 
         // check that sequence_group3 is fully scehuled
-        EXPECT_EQ(out4.m_block_tables[idx2][0].size(), 2);
-        EXPECT_FALSE(out4.m_block_tables[idx2][0][0]->is_free());
-        EXPECT_EQ(out4.m_block_tables[idx2][0][0]->get_index(), 0);
-        EXPECT_FALSE(out4.m_block_tables[idx2][0][1]->is_free());
-        EXPECT_EQ(out4.m_block_tables[idx2][0][1]->get_index(), 1);
+        EXPECT_EQ(out4.m_block_indices.at(idx2)->at(0).size(), 2);
+        EXPECT_FALSE(scheduler.get_block_tables(idx2)[0][0]->is_free());
+        EXPECT_EQ(out4.m_block_indices.at(idx2)->at(0)[0], 0);
+        EXPECT_FALSE(scheduler.get_block_tables(idx2)[0][1]->is_free());
+        EXPECT_EQ(out4.m_block_indices.at(idx2)->at(0)[1], 1);
 
         // requests1[1] should be fully scheduled plus 1 slot for requests[0] for generate phase
         EXPECT_EQ(out4.m_total_num_scheduled_tokens, requests[1]->get_context_len() + 1);
@@ -176,16 +178,16 @@ TEST_P(AppendSlotsSchedulerTest, test_append_slots_considers_all_sequences) {
 
     std::vector<uint64_t> ref_ids = {0, 1};
     EXPECT_EQ(out1.m_scheduled_sequence_groups_ids, ref_ids);
-    EXPECT_EQ(out1.m_block_tables[idx0][0].size(), 2);
-    EXPECT_EQ(out1.m_block_tables[idx1][0].size(), 2);
-    EXPECT_FALSE(out1.m_block_tables[idx0][0][0]->is_free());
-    EXPECT_EQ(out1.m_block_tables[idx0][0][0]->get_index(), 0);
-    EXPECT_FALSE(out1.m_block_tables[idx0][0][1]->is_free());
-    EXPECT_EQ(out1.m_block_tables[idx0][0][1]->get_index(), 1);
-    EXPECT_FALSE(out1.m_block_tables[idx1][0][0]->is_free());
-    EXPECT_EQ(out1.m_block_tables[idx1][0][0]->get_index(), 2);
-    EXPECT_FALSE(out1.m_block_tables[idx1][0][1]->is_free());
-    EXPECT_EQ(out1.m_block_tables[idx1][0][1]->get_index(), 3);
+    EXPECT_EQ(out1.m_block_indices.at(idx0)->at(0).size(), 2);
+    EXPECT_EQ(out1.m_block_indices.at(idx1)->at(0).size(), 2);
+    EXPECT_FALSE(scheduler.get_block_tables(idx0)[0][0]->is_free());
+    EXPECT_EQ(out1.m_block_indices.at(idx0)->at(0)[0], 0);
+    EXPECT_FALSE(scheduler.get_block_tables(idx0)[0][1]->is_free());
+    EXPECT_EQ(out1.m_block_indices.at(idx0)->at(0)[1], 1);
+    EXPECT_FALSE(scheduler.get_block_tables(idx1)[0][0]->is_free());
+    EXPECT_EQ(out1.m_block_indices.at(idx1)->at(0)[0], 2);
+    EXPECT_FALSE(scheduler.get_block_tables(idx1)[0][1]->is_free());
+    EXPECT_EQ(out1.m_block_indices.at(idx1)->at(0)[1], 3);
     EXPECT_EQ(out1.m_total_num_scheduled_tokens, tokens.size() * 2);
     EXPECT_EQ(out1.is_prompt, !scheduler_config.dynamic_split_fuse);
     for (auto seq: requests) {
@@ -198,13 +200,13 @@ TEST_P(AppendSlotsSchedulerTest, test_append_slots_considers_all_sequences) {
     auto out2 = scheduler.schedule(requests);
 
     // 1-st sequence now should use 3 kv-blocks
-    EXPECT_EQ(out2.m_block_tables[idx0][0].size(), 3);
-    EXPECT_FALSE(out2.m_block_tables[idx0][0][0]->is_free());
-    EXPECT_EQ(out2.m_block_tables[idx0][0][0]->get_index(), 0);
-    EXPECT_FALSE(out2.m_block_tables[idx0][0][1]->is_free());
-    EXPECT_EQ(out2.m_block_tables[idx0][0][1]->get_index(), 1);
-    EXPECT_FALSE(out2.m_block_tables[idx0][0][2]->is_free());
-    EXPECT_EQ(out2.m_block_tables[idx0][0][2]->get_index(), 4);
+    EXPECT_EQ(out2.m_block_indices.at(idx0)->at(0).size(), 3);
+    EXPECT_FALSE(scheduler.get_block_tables(idx0)[0][0]->is_free());
+    EXPECT_EQ(out2.m_block_indices.at(idx0)->at(0)[0], 0);
+    EXPECT_FALSE(scheduler.get_block_tables(idx0)[0][1]->is_free());
+    EXPECT_EQ(out2.m_block_indices.at(idx0)->at(0)[1], 1);
+    EXPECT_FALSE(scheduler.get_block_tables(idx0)[0][2]->is_free());
+    EXPECT_EQ(out2.m_block_indices.at(idx0)->at(0)[2], 4);
 
     // 1 token was scheduled for generate phase
     EXPECT_EQ(out2.m_total_num_scheduled_tokens, 1);
@@ -282,10 +284,10 @@ TEST_P(PartialPreemptionSchedulerTest, test_partial_preemption) {
     EXPECT_EQ(block_table2[1]->get_index(), 4);
 
     EXPECT_EQ(out2.m_total_num_scheduled_tokens, 1);
-    EXPECT_EQ(out2.m_block_tables[idx0][0][0]->get_index(), 0);
-    EXPECT_EQ(out2.m_block_tables[idx0][0][1]->get_index(), 1);
-    EXPECT_EQ(out2.m_block_tables[idx0][0][2]->get_index(), 2);
-    EXPECT_EQ(out2.m_block_tables[idx0][0][3]->get_index(), 5);
+    EXPECT_EQ(out2.m_block_indices.at(idx0)->at(0)[0], 0);
+    EXPECT_EQ(out2.m_block_indices.at(idx0)->at(0)[1], 1);
+    EXPECT_EQ(out2.m_block_indices.at(idx0)->at(0)[2], 2);
+    EXPECT_EQ(out2.m_block_indices.at(idx0)->at(0)[3], 5);
 
     // finish first sequence
     requests[0]->get_running_sequences()[0]->set_status(SequenceStatus::FINISHED);
@@ -298,9 +300,9 @@ TEST_P(PartialPreemptionSchedulerTest, test_partial_preemption) {
 
     // last token should be recomputed
     EXPECT_EQ(out3.m_total_num_scheduled_tokens, 1);
-    EXPECT_EQ(out3.m_block_tables[idx1][0][0]->get_index(), 3);
-    EXPECT_EQ(out3.m_block_tables[idx1][0][1]->get_index(), 4);
-    EXPECT_EQ(out3.m_block_tables[idx1][0][2]->get_index(), 0);
+    EXPECT_EQ(out3.m_block_indices.at(idx1)->at(0)[0], 3);
+    EXPECT_EQ(out3.m_block_indices.at(idx1)->at(0)[1], 4);
+    EXPECT_EQ(out3.m_block_indices.at(idx1)->at(0)[2], 0);
 
     block_table2 = scheduler.get_block_tables(*(*sequence_group2)[0])[0];
     EXPECT_EQ(block_table2.size(), 3);
@@ -320,6 +322,314 @@ TEST_P(PartialPreemptionSchedulerTest, test_partial_preemption) {
 INSTANTIATE_TEST_SUITE_P(VariousSchedulerConfigs, PartialPreemptionSchedulerTest ,
                          ::testing::ValuesIn(PARTIAL_PREEMPTION_TEST_CASES));
 
+TEST(TestScheduler, test_preemption_by_swap) {
+    std::array<SchedulerConfig, 2> configs = {get_scheduler_config(32, 6, false, 5), get_scheduler_config(32, 6, true, 5)};
+    for (auto scheduler_config: configs) {
+        scheduler_config.swap_space = 1;
+        std::vector<uint64_t> tokens1 = {0,1,2,3,4,5,6,7,8,9,10};
+        SequenceGroup::Ptr sequence_group1 = std::make_shared<SequenceGroup>(0, ov::Tensor(ov::element::i64, {tokens1.size()}, tokens1.data()),
+                                                                                ov::genai::greedy(), 4);
+        std::vector<uint64_t> tokens2 = {0,1,2,3,4,5,6,7};
+        auto idx0 = (*sequence_group1)[0]->get_id();
+        SequenceGroup::Ptr sequence_group2 = std::make_shared<SequenceGroup>(1, ov::Tensor(ov::element::i64, {tokens2.size()}, tokens2.data()),
+                                                                                ov::genai::greedy(), 4);
+        auto idx1 = (*sequence_group2)[0]->get_id();
+        std::vector<SequenceGroup::Ptr> requests = {sequence_group1, sequence_group2};
+
+        auto cache_manager = init_cache_manager(scheduler_config);
+        Scheduler scheduler = Scheduler(4, cache_manager, scheduler_config);
+        scheduler.schedule(requests);
+        for (auto seq: requests) {
+            // prompt phase
+            seq->finish_iteration();
+        }
+
+        // schedule generate, all 6 kv blocks are used.
+        scheduler.schedule(requests);
+        for (auto seq: requests) {
+            seq->get_running_sequences()[0]->append_token(16, 0.9);
+            seq->finish_iteration();
+        }
+
+        // mark KV cache contents of the sequence to be swapped out
+        ov::Tensor key_cache = cache_manager->get_key_cache(0);
+        size_t block_byte_size = key_cache.get_byte_size() / key_cache.get_shape()[0];
+        auto block_data = [&](const ov::Tensor& cache, size_t block_idx) {
+            return static_cast<uint8_t*>(cache.data()) + block_idx * block_byte_size;
+        };
+        auto block_table2 = scheduler.get_block_tables(*(*sequence_group2)[0])[0];
+        ASSERT_EQ(block_table2.size(), 3);
+        for (size_t i = 0; i < block_table2.size(); i++) {
+            std::memset(block_data(key_cache, block_table2[i]->get_index()), static_cast<int>(i + 1), block_byte_size);
+        }
+
+        // sequence_group2 should be swapped out completely instead of being recomputed
+        auto out2 = scheduler.schedule(requests);
+        std::vector<uint64_t> ref_ids = {0};
+        EXPECT_EQ(out2.m_scheduled_sequence_groups_ids, ref_ids);
+        EXPECT_TRUE(scheduler.is_swapped_out(idx1));
+        EXPECT_TRUE(scheduler.has_block_table(idx1));
+        EXPECT_EQ(scheduler.get_block_tables(*(*sequence_group1)[0])[0].size(), 4);
+        EXPECT_EQ(sequence_group2->get_num_processed_tokens(), tokens2.size() + 1);
+
+        // finish first sequence
+        requests[0]->get_running_sequences()[0]->set_status(SequenceStatus::FINISHED);
+        scheduler.free_sequence(idx0);
+        clear_finished_sequences(requests);
+
+        // sequence_group2 should be swapped in and continue generation without recomputation
+        auto out3 = scheduler.schedule(requests);
+        EXPECT_FALSE(scheduler.is_swapped_out(idx1));
+        EXPECT_EQ(out3.m_total_num_scheduled_tokens, 1);
+        block_table2 = scheduler.get_block_tables(*(*sequence_group2)[0])[0];
+        ASSERT_EQ(block_table2.size(), 3);
+        key_cache = cache_manager->get_key_cache(0);
+        for (size_t i = 0; i < block_table2.size(); i++) {
+            const uint8_t* data = block_data(key_cache, block_table2[i]->get_index());
+            EXPECT_TRUE(std::all_of(data, data + block_byte_size, [i](uint8_t value) { return value == i + 1; }));
+        }
+
+        // the swapped in sequence keeps generating and allocates new blocks to its restored block table
+        for (size_t step = 0; step < 4; ++step) {
+            sequence_group2->get_running_sequences()[0]->append_token(16, 0.9);
+            sequence_group2->finish_iteration();
+            auto out = scheduler.schedule(requests);
+            EXPECT_EQ(out.m_scheduled_sequence_groups_ids, ref_ids);
+            const auto& block_tables = scheduler.get_block_tables(*(*sequence_group2)[0]);
+            const auto& block_indices = *out.m_block_indices.at(idx1);
+            EXPECT_EQ(block_tables[0].size(), sequence_group2->get_num_logical_blocks());
+            ASSERT_EQ(block_indices.size(), block_tables.size());
+            for (size_t layer_idx = 0; layer_idx < block_tables.size(); ++layer_idx) {
+                ASSERT_EQ(block_indices[layer_idx].size(), block_tables[layer_idx].size());
+                for (size_t i = 0; i < block_tables[layer_idx].size(); ++i) {
+                    EXPECT_EQ(block_indices[layer_idx][i], block_tables[layer_idx][i]->get_index());
+                }
+            }
+        }
+        EXPECT_EQ(scheduler.get_block_tables(*(*sequence_group2)[0])[0].size(), 4);
+
+        for (auto& req : requests) {
+            for (auto& seq : req->get_sequences()) {
+                scheduler.free_sequence(seq->get_id());
+            }
+        }
+    }
+}
+
+TEST(TestScheduler, priority_scheduling_policy) {
+    std::array<SchedulerConfig, 2> configs = {get_scheduler_config(32, 6, false, 5), get_scheduler_config(32, 6, true, 5)};
+    for (auto scheduler_config: configs) {
+        scheduler_config.scheduling_policy = SchedulingPolicy::PRIORITY;
+        std::vector<uint64_t> tokens = {0,1,2,3,4,5,6,7};
+        ov::genai::GenerationConfig low_priority = ov::genai::greedy(), high_priority = ov::genai::greedy();
+        high_priority.priority = 1;
+        SequenceGroup::Ptr sequence_group1 = std::make_shared<SequenceGroup>(0, ov::Tensor(ov::element::i64, {tokens.size()}, tokens.data()),
+                                                                                low_priority, 4);
+        auto idx0 = (*sequence_group1)[0]->get_id();
+        SequenceGroup::Ptr sequence_group2 = std::make_shared<SequenceGroup>(1, ov::Tensor(ov::element::i64, {tokens.size()}, tokens.data()),
+                                                                                low_priority, 4);
+        auto idx1 = (*sequence_group2)[0]->get_id();
+        SequenceGroup::Ptr sequence_group3 = std::make_shared<SequenceGroup>(2, ov::Tensor(ov::element::i64, {tokens.size()}, tokens.data()),
+                                                                                high_priority, 4);
+        auto idx2 = (*sequence_group3)[0]->get_id();
+        std::vector<SequenceGroup::Ptr> requests = {sequence_group1, sequence_group2, sequence_group3};
+
+        // the most recent request goes first due to its priority
+        Scheduler scheduler = Scheduler(4, init_cache_manager(scheduler_config), scheduler_config);
+        auto out1 = scheduler.schedule(requests);
+        std::vector<SequenceGroup::Ptr> ref_order = {sequence_group3, sequence_group1, sequence_group2};
+        EXPECT_EQ(requests, ref_order);
+        std::vector<uint64_t> ref_ids = {0, 1, 2};
+        EXPECT_EQ(out1.m_scheduled_sequence_groups_ids, ref_ids);
+
+        for (auto seq: requests) {
+            seq->finish_iteration();
+        }
+
+        // all kv blocks are taken, so the least important of the remaining requests is preempted instead of the most recent one
+        auto out2 = scheduler.schedule(requests);
+        std::vector<uint64_t> ref_ids2 = {0, 1};
+        EXPECT_EQ(out2.m_scheduled_sequence_groups_ids, ref_ids2);
+        EXPECT_EQ(out2.m_block_indices.at(idx2)->at(0).size(), 3);
+        EXPECT_EQ(out2.m_block_indices.at(idx0)->at(0).size(), 3);
+        EXPECT_FALSE(scheduler.has_block_table(idx1));
+
+        scheduler.free_sequence(idx0);
+        scheduler.free_sequence(idx2);
+    }
+}
+
+TEST(TestScheduler, multi_step_generation) {
+    std::array<SchedulerConfig, 2> configs = {get_scheduler_config(32, 12, false, 5), get_scheduler_config(32, 12, true, 5)};
+    for (auto scheduler_config: configs) {
+        scheduler_config.num_scheduler_steps = 3;
+        std::vector<uint64_t> tokens = {0,1,2,3,4,5,6,7};
+        SequenceGroup::Ptr sequence_group1 = std::make_shared<SequenceGroup>(0, ov::Tensor(ov::element::i64, {tokens.size()}, tokens.data()),
+                                                                                ov::genai::greedy(), 4);
+        auto idx0 = (*sequence_group1)[0]->get_id();
+        SequenceGroup::Ptr sequence_group2 = std::make_shared<SequenceGroup>(1, ov::Tensor(ov::element::i64, {tokens.size()}, tokens.data()),
+                                                                                ov::genai::greedy(), 4);
+        auto idx1 = (*sequence_group2)[0]->get_id();
+        std::vector<SequenceGroup::Ptr> requests = {sequence_group1, sequence_group2};
+
+        Scheduler scheduler = Scheduler(4, init_cache_manager(scheduler_config), scheduler_config);
+        auto generate_step = [&](const Scheduler::Output& out) {
+            for (auto id : out.m_scheduled_sequence_groups_ids) {
+                requests[id]->get_running_sequences()[0]->append_token(16, 0.9);
+                requests[id]->finish_iteration();
+            }
+        };
+
+        // prompt phase does not start a window
+        scheduler.schedule(requests);
+        for (auto seq: requests) {
+            seq->finish_iteration();
+        }
+
+        // the first generation step is fully scheduled and starts a window of 3 steps
+        auto out1 = scheduler.schedule(requests);
+        std::vector<uint64_t> ref_ids = {0, 1};
+        EXPECT_EQ(out1.m_scheduled_sequence_groups_ids, ref_ids);
+        generate_step(out1);
+
+        // a request added within the window waits for its end
+        SequenceGroup::Ptr sequence_group3 = std::make_shared<SequenceGroup>(2, ov::Tensor(ov::element::i64, {tokens.size()}, tokens.data()),
+                                                                                ov::genai::greedy(), 4);
+        auto idx2 = (*sequence_group3)[0]->get_id();
+        requests.push_back(sequence_group3);
+
+        auto out2 = scheduler.schedule(requests);
+        EXPECT_EQ(out2.m_scheduled_sequence_groups_ids, ref_ids);
+        EXPECT_EQ(out2.m_total_num_scheduled_tokens, 2);
+        EXPECT_EQ(out2.m_block_indices.at(idx0)->at(0).size(), 3);
+        EXPECT_EQ(out2.m_block_indices.at(idx1)->at(0).size(), 3);
+        EXPECT_FALSE(scheduler.has_block_table(idx2));
+        generate_step(out2);
+
+        // finished requests leave the window
+        requests[1]->get_running_sequences()[0]->set_status(SequenceStatus::FINISHED);
+        scheduler.free_sequence(idx1);
+        clear_finished_sequences(requests);
+
+        auto out3 = scheduler.schedule(requests);
+        std::vector<uint64_t> ref_ids3 = {0};
+        EXPECT_EQ(out3.m_scheduled_sequence_groups_ids, ref_ids3);
+        EXPECT_EQ(out3.m_total_num_scheduled_tokens, 1);
+        generate_step(out3);
+
+        // the window is over, so the new request is admitted
+        auto out4 = scheduler.schedule(requests);
+        EXPECT_NE(std::find(out4.m_scheduled_sequence_groups_ids.begin(), out4.m_scheduled_sequence_groups_ids.end(), 1),
+                  out4.m_scheduled_sequence_groups_ids.end());
+        EXPECT_TRUE(scheduler.has_block_table(idx2));
+
+        scheduler.free_sequence(idx0);
+        scheduler.free_sequence(idx2);
+    }
+}
+
+TEST(TestScheduler, multi_step_generation_with_prefix_cache_disk_tier) {
+    auto scheduler_config = get_scheduler_config(32, 3, true, 5);
+    scheduler_config.num_scheduler_steps = 3;
+    scheduler_config.enable_prefix_caching = true;
+    scheduler_config.prefix_cache_disk_size = 1;
+    auto cache_manager = init_cache_manager(scheduler_config);
+    Scheduler scheduler = Scheduler(4, cache_manager, scheduler_config);
+
+    auto fill_block = [](const ov::Tensor& cache, size_t block_idx, uint8_t value) {
+        size_t block_byte_size = cache.get_byte_size() / cache.get_shape()[0];
+        std::memset(static_cast<uint8_t*>(cache.data()) + block_idx * block_byte_size, value, block_byte_size);
+    };
+    auto is_block_filled = [](const ov::Tensor& cache, size_t block_idx, uint8_t value) {
+        size_t block_byte_size = cache.get_byte_size() / cache.get_shape()[0];
+        const uint8_t* data = static_cast<const uint8_t*>(cache.data()) + block_idx * block_byte_size;
+        return std::all_of(data, data + block_byte_size, [value](uint8_t element) { return element == value; });
+    };
+
+    // the prompt of the first request fills a single block, which stays cached after the request is finished
+    std::vector<uint64_t> tokens1 = {0,1,2,3};
+    SequenceGroup::Ptr sequence_group1 = std::make_shared<SequenceGroup>(0, ov::Tensor(ov::element::i64, {tokens1.size()}, tokens1.data()),
+                                                                         ov::genai::greedy(), 4);
+    std::vector<SequenceGroup::Ptr> requests = {sequence_group1};
+    scheduler.schedule(requests);
+    sequence_group1->finish_iteration();
+    const int cached_block_idx = scheduler.get_block_tables(*(*sequence_group1)[0])[0][0]->get_index();
+    fill_block(cache_manager->get_key_cache(0), cached_block_idx, 1);
+    (*sequence_group1)[0]->set_status(SequenceStatus::FINISHED);
+    scheduler.free_sequence((*sequence_group1)[0]->get_id());
+
+    // the second request takes the rest of the free blocks
+    std::vector<uint64_t> tokens2 = {10,11,12,13,14,15,16};
+    SequenceGroup::Ptr sequence_group2 = std::make_shared<SequenceGroup>(1, ov::Tensor(ov::element::i64, {tokens2.size()}, tokens2.data()),
+                                                                         ov::genai::greedy(), 4);
+    auto idx1 = (*sequence_group2)[0]->get_id();
+    requests = {sequence_group2};
+    auto generate_step = [&](const Scheduler::Output& out) {
+        EXPECT_EQ(out.m_scheduled_sequence_groups_ids, std::vector<uint64_t>({0}));
+        sequence_group2->get_running_sequences()[0]->append_token(16, 0.9);
+        sequence_group2->finish_iteration();
+    };
+    generate_step(scheduler.schedule(requests));
+    // starts a window of 3 steps
+    generate_step(scheduler.schedule(requests));
+
+    // the window step needs a new block, so the cached one is overwritten after being stored to disk
+    auto out = scheduler.schedule(requests);
+    const auto& block_indices = out.m_block_indices.at(idx1)->at(0);
+    ASSERT_EQ(block_indices.size(), 3);
+    EXPECT_EQ(block_indices[2], cached_block_idx);
+    // the inference of the step writes to the block
+    fill_block(cache_manager->get_key_cache(0), cached_block_idx, 2);
+    generate_step(out);
+    (*sequence_group2)[0]->set_status(SequenceStatus::FINISHED);
+    scheduler.free_sequence(idx1);
+
+    // the block restored from disk holds the contents before the overwrite
+    std::vector<uint64_t> tokens3 = {0,1,2,3,4,5};
+    SequenceGroup::Ptr sequence_group3 = std::make_shared<SequenceGroup>(2, ov::Tensor(ov::element::i64, {tokens3.size()}, tokens3.data()),
+                                                                         ov::genai::greedy(), 4);
+    scheduler.restore_cached_blocks(sequence_group3);
+    EXPECT_EQ(sequence_group3->get_num_processed_tokens(), 4);
+    requests = {sequence_group3};
+    scheduler.schedule(requests);
+    const size_t restored_block_idx = scheduler.get_block_tables(*(*sequence_group3)[0])[0][0]->get_index();
+    EXPECT_TRUE(is_block_filled(cache_manager->get_key_cache(0), restored_block_idx, 1));
+    scheduler.free_sequence((*sequence_group3)[0]->get_id());
+}
+
+TEST(TestScheduler, prompt_tokens_follow_latency_target) {
+    auto scheduler_config = get_scheduler_config(32, 20, true, 5);
+    scheduler_config.inter_token_latency_target_ms = 10;
+    std::vector<uint64_t> tokens1 = {0,1,2,3,4,5,6,7};
+    SequenceGroup::Ptr sequence_group1 = std::make_shared<SequenceGroup>(0, ov::Tensor(ov::element::i64, {tokens1.size()}, tokens1.data()),
+                                                                            ov::genai::greedy(), 4);
+    auto idx0 = (*sequence_group1)[0]->get_id();
+    std::vector<SequenceGroup::Ptr> requests = {sequence_group1};
+
+    Scheduler scheduler = Scheduler(4, init_cache_manager(scheduler_config), scheduler_config);
+    auto out1 = scheduler.schedule(requests);
+    EXPECT_EQ(out1.m_num_prompt_tokens, tokens1.size());
+    // 1 ms per prompt token
+    scheduler.register_step_duration(out1, 8.0f);
+    requests[0]->finish_iteration();
+
+    std::vector<uint64_t> tokens2(30, 1);
+    SequenceGroup::Ptr sequence_group2 = std::make_shared<SequenceGroup>(1, ov::Tensor(ov::element::i64, {tokens2.size()}, tokens2.data()),
+                                                                            ov::genai::greedy(), 4);
+    auto idx1 = (*sequence_group2)[0]->get_id();
+    requests.push_back(sequence_group2);
+
+    // the prompt is chunked to keep the latency of the generated token
+    auto out2 = scheduler.schedule(requests);
+    std::vector<uint64_t> ref_ids = {0, 1};
+    EXPECT_EQ(out2.m_scheduled_sequence_groups_ids, ref_ids);
+    EXPECT_EQ(out2.m_num_prompt_tokens, 10);
+    EXPECT_EQ(out2.m_total_num_scheduled_tokens, 11);
+
+    scheduler.free_sequence(idx0);
+    scheduler.free_sequence(idx1);
+}
+
 TEST(TestScheduler, test_partial_preemption_beam_search) {
     std::array<SchedulerConfig, 2> configs = {SchedulerConfig(), SchedulerConfig()};
     configs.at(0).num_kv_blocks = 10;
@@ -472,11 +782,11 @@ TEST(TestScheduler, test_partially_preempted_prompt) {
         EXPECT_EQ(block_table1[1]->get_index(), 1);
         EXPECT_EQ(block_table1[2]->get_index(), 2);
         EXPECT_EQ(block_table1[3]->get_index(), 5);
-        EXPECT_EQ(out2.m_block_tables[idx0][0].size(), 4);
-        EXPECT_EQ(out2.m_block_tables[idx0][0][0]->get_index(), 0);
-        EXPECT_EQ(out2.m_block_tables[idx0][0][1]->get_index(), 1);
-        EXPECT_EQ(out2.m_block_tables[idx0][0][2]->get_index(), 2);
-        EXPECT_EQ(out2.m_block_tables[idx0][0][3]->get_index(), 5);
+        EXPECT_EQ(out2.m_block_indices.at(idx0)->at(0).size(), 4);
+        EXPECT_EQ(out2.m_block_indices.at(idx0)->at(0)[0], 0);
+        EXPECT_EQ(out2.m_block_indices.at(idx0)->at(0)[1], 1);
+        EXPECT_EQ(out2.m_block_indices.at(idx0)->at(0)[2], 2);
+        EXPECT_EQ(out2.m_block_indices.at(idx0)->at(0)[3], 5);
 
         std::vector<uint64_t> ref_ids = {0};
         EXPECT_EQ(out2.m_scheduled_sequence_groups_ids, ref_ids);
@@ -516,9 +826,9 @@ TEST(TestScheduler, test_partially_preempted_prompt) {
             EXPECT_EQ(out3.m_total_num_scheduled_tokens, 12);
         }
 
-        EXPECT_EQ(out3.m_block_tables[idx1][0][0]->get_index(), 3);
-        EXPECT_EQ(out3.m_block_tables[idx1][0][1]->get_index(), 4);
-        EXPECT_EQ(out3.m_block_tables[idx1][0][2]->get_index(), 0);
+        EXPECT_EQ(out3.m_block_indices.at(idx1)->at(0)[0], 3);
+        EXPECT_EQ(out3.m_block_indices.at(idx1)->at(0)[1], 4);
+        EXPECT_EQ(out3.m_block_indices.at(idx1)->at(0)[2], 0);
 
         auto block_table2 = scheduler.get_block_tables(*(*sequence_group2)[0])[0];
         EXPECT_EQ(block_table2.size(), 3);
@@ -608,6 +918,167 @@ TEST(TestScheduler, prefix_caching_test) {
 
 }
 
+TEST(TestScheduler, prefix_cache_snapshot) {
+    auto scheduler_config = get_scheduler_config(32, 10, false, 5);
+    scheduler_config.enable_prefix_caching = true;
+    std::vector<uint64_t> tokens = {0,1,2,3,4,5,6,7,8};
+    const uint64_t model_fingerprint = 42;
+    auto snapshot_path = std::filesystem::temp_directory_path() / "test_prefix_cache_snapshot.bin";
+
+    auto fill_block = [](const ov::Tensor& cache, size_t block_idx, uint8_t value) {
+        size_t block_byte_size = cache.get_byte_size() / cache.get_shape()[0];
+        std::memset(static_cast<uint8_t*>(cache.data()) + block_idx * block_byte_size, value, block_byte_size);
+    };
+    auto is_block_filled = [](const ov::Tensor& cache, size_t block_idx, uint8_t value) {
+        size_t block_byte_size = cache.get_byte_size() / cache.get_shape()[0];
+        const uint8_t* data = static_cast<const uint8_t*>(cache.data()) + block_idx * block_byte_size;
+        return std::all_of(data, data + block_byte_size, [value](uint8_t element) { return element == value; });
+    };
+
+    {
+        auto cache_manager = init_cache_manager(scheduler_config);
+        Scheduler scheduler = Scheduler(4, cache_manager, scheduler_config);
+        SequenceGroup::Ptr sequence_group = std::make_shared<SequenceGroup>(0, ov::Tensor(ov::element::i64, {tokens.size()}, tokens.data()),
+                                                                            ov::genai::greedy(), 4);
+        std::vector<SequenceGroup::Ptr> requests = {sequence_group};
+        scheduler.schedule(requests);
+        sequence_group->finish_iteration();
+
+        auto block_table = scheduler.get_block_tables(*(*sequence_group)[0])[0];
+        ASSERT_EQ(block_table.size(), 3);
+        for (size_t i = 0; i < block_table.size(); i++) {
+            fill_block(cache_manager->get_key_cache(0), block_table[i]->get_index(), i + 1);
+            fill_block(cache_manager->get_value_cache(11), block_table[i]->get_index(), i + 10);
+        }
+        auto sequence = (*sequence_group)[0];
+        sequence->set_status(SequenceStatus::FINISHED);
+        scheduler.free_sequence(sequence->get_id());
+
+        EXPECT_EQ(PrefixCacheSnapshot::save(snapshot_path, scheduler, model_fingerprint), 3);
+    }
+
+    // a snapshot of a different model is not loaded
+    {
+        Scheduler scheduler = Scheduler(4, init_cache_manager(scheduler_config), scheduler_config);
+        EXPECT_EQ(PrefixCacheSnapshot::load(snapshot_path, scheduler, model_fingerprint + 1), 0);
+    }
+
+    auto cache_manager = init_cache_manager(scheduler_config);
+    Scheduler scheduler = Scheduler(4, cache_manager, scheduler_config);
+    EXPECT_EQ(PrefixCacheSnapshot::load(snapshot_path, scheduler, model_fingerprint), 3);
+    std::filesystem::remove(snapshot_path);
+
+    // the whole prompt is restored from the loaded cache
+    SequenceGroup::Ptr sequence_group = std::make_shared<SequenceGroup>(1, ov::Tensor(ov::element::i64, {tokens.size()}, tokens.data()),
+                                                                        ov::genai::greedy(), 4);
+    scheduler.restore_cached_blocks(sequence_group);
+    EXPECT_EQ(sequence_group->get_num_processed_tokens(), tokens.size() - 1);
+    auto block_table = scheduler.get_block_tables(*(*sequence_group)[0])[0];
+    ASSERT_EQ(block_table.size(), 3);
+    for (size_t i = 0; i < block_table.size(); i++) {
+        EXPECT_TRUE(is_block_filled(cache_manager->get_key_cache(0), block_table[i]->get_index(), i + 1));
+        EXPECT_TRUE(is_block_filled(cache_manager->get_value_cache(11), block_table[i]->get_index(), i + 10));
+    }
+    scheduler.free_sequence((*sequence_group)[0]->get_id());
+}
+
+TEST(TestScheduler, corrupted_prefix_cache_snapshot) {
+    auto scheduler_config = get_scheduler_config(32, 10, false, 5);
+    scheduler_config.enable_prefix_caching = true;
+    std::vector<uint64_t> tokens = {0,1,2,3,4,5,6,7,8};
+    const uint64_t model_fingerprint = 42;
+    auto snapshot_path = std::filesystem::temp_directory_path() / "test_corrupted_prefix_cache_snapshot.bin";
+    {
+        Scheduler scheduler = Scheduler(4, init_cache_manager(scheduler_config), scheduler_config);
+        SequenceGroup::Ptr sequence_group = std::make_shared<SequenceGroup>(0, ov::Tensor(ov::element::i64, {tokens.size()}, tokens.data()),
+                                                                            ov::genai::greedy(), 4);
+        std::vector<SequenceGroup::Ptr> requests = {sequence_group};
+        scheduler.schedule(requests);
+        sequence_group->finish_iteration();
+        auto sequence = (*sequence_group)[0];
+        sequence->set_status(SequenceStatus::FINISHED);
+        scheduler.free_sequence(sequence->get_id());
+        ASSERT_EQ(PrefixCacheSnapshot::save(snapshot_path, scheduler, model_fingerprint), 3);
+    }
+
+    // magic, version, model fingerprint and cache layout hash precede the number of blocks, followed by the block hash,
+    // the prefix hash flag and the prefix hash preceding the number of tokens of the first block
+    const std::streamoff num_blocks_offset = 8 + 4 + 8 + 8, num_tokens_offset = num_blocks_offset + 8 + 8 + 1 + 8;
+    auto load_patched = [&](std::streamoff offset, uint64_t value) {
+        std::filesystem::path patched_path = snapshot_path;
+        patched_path += ".patched";
+        std::filesystem::copy_file(snapshot_path, patched_path, std::filesystem::copy_options::overwrite_existing);
+        {
+            std::fstream file(patched_path, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(offset);
+            file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+        Scheduler scheduler = Scheduler(4, init_cache_manager(scheduler_config), scheduler_config);
+        const size_t num_loaded_blocks = PrefixCacheSnapshot::load(patched_path, scheduler, model_fingerprint);
+        std::filesystem::remove(patched_path);
+        return num_loaded_blocks;
+    };
+
+    // more blocks than the file holds
+    EXPECT_EQ(load_patched(num_blocks_offset, 1ULL << 40), 0);
+    EXPECT_EQ(load_patched(num_blocks_offset, 4), 0);
+    // a block of more tokens than the block size
+    EXPECT_EQ(load_patched(num_tokens_offset, 5), 0);
+    // the first block is full, so the unchanged snapshot is loaded
+    EXPECT_EQ(load_patched(num_tokens_offset, 4), 3);
+    std::filesystem::remove(snapshot_path);
+}
+
+TEST(TestScheduler, prefix_cache_snapshot_of_prompt) {
+    auto scheduler_config = get_scheduler_config(32, 10, false, 5);
+    scheduler_config.enable_prefix_caching = true;
+    std::vector<uint64_t> tokens1 = {0,1,2,3,4,5,6,7,8};
+    std::vector<uint64_t> tokens2 = {9,10,11,12,13,14,15,16,17};
+    const uint64_t model_fingerprint = 42;
+    auto snapshot_path = std::filesystem::temp_directory_path() / "test_prefix_cache_snapshot_of_prompt.bin";
+    ov::Tensor input_ids1(ov::element::i64, {tokens1.size()}, tokens1.data());
+    ov::Tensor input_ids2(ov::element::i64, {tokens2.size()}, tokens2.data());
+
+    // both prompts are processed by the first scheduler, only the first one is handed over
+    {
+        Scheduler scheduler = Scheduler(4, init_cache_manager(scheduler_config), scheduler_config);
+        SequenceGroup::Ptr sequence_group1 = std::make_shared<SequenceGroup>(0, input_ids1, ov::genai::greedy(), 4);
+        SequenceGroup::Ptr sequence_group2 = std::make_shared<SequenceGroup>(1, input_ids2, ov::genai::greedy(), 4);
+        std::vector<SequenceGroup::Ptr> requests = {sequence_group1, sequence_group2};
+        scheduler.schedule(requests);
+        for (auto& sequence_group : requests) {
+            sequence_group->finish_iteration();
+            auto sequence = (*sequence_group)[0];
+            sequence->set_status(SequenceStatus::FINISHED);
+            scheduler.free_sequence(sequence->get_id());
+        }
+        EXPECT_EQ(PrefixCacheSnapshot::save(snapshot_path, scheduler, model_fingerprint, input_ids1), 3);
+    }
+
+    // the second scheduler is already generating when the prompt is handed over
+    Scheduler scheduler = Scheduler(4, init_cache_manager(scheduler_config), scheduler_config);
+    std::vector<uint64_t> tokens3 = {18,19,20,21,22,23,24,25,26};
+    SequenceGroup::Ptr sequence_group3 = std::make_shared<SequenceGroup>(2, ov::Tensor(ov::element::i64, {tokens3.size()}, tokens3.data()),
+                                                                         ov::genai::greedy(), 4);
+    std::vector<SequenceGroup::Ptr> requests = {sequence_group3};
+    scheduler.schedule(requests);
+    sequence_group3->finish_iteration();
+
+    EXPECT_EQ(PrefixCacheSnapshot::load(snapshot_path, scheduler, model_fingerprint), 3);
+    std::filesystem::remove(snapshot_path);
+
+    SequenceGroup::Ptr sequence_group1 = std::make_shared<SequenceGroup>(3, input_ids1, ov::genai::greedy(), 4);
+    scheduler.restore_cached_blocks(sequence_group1);
+    EXPECT_EQ(sequence_group1->get_num_processed_tokens(), tokens1.size() - 1);
+    SequenceGroup::Ptr sequence_group2 = std::make_shared<SequenceGroup>(4, input_ids2, ov::genai::greedy(), 4);
+    scheduler.restore_cached_blocks(sequence_group2);
+    EXPECT_EQ(sequence_group2->get_num_processed_tokens(), 0);
+
+    scheduler.free_sequence((*sequence_group1)[0]->get_id());
+    scheduler.free_sequence((*sequence_group2)[0]->get_id());
+    scheduler.free_sequence((*sequence_group3)[0]->get_id());
+}
+
 TEST(TestScheduler, prefix_caching_test_two_identical_sequences) {
     std::array<SchedulerConfig, 2> configs = {SchedulerConfig(), SchedulerConfig()};
     configs.at(0).num_kv_blocks = 100;
@@ -764,11 +1235,11 @@ TEST(TestScheduler, test_partially_preempted_prompt_not_allowed) {
     ASSERT_EQ(block_table1[0][1]->get_index(), 1);
     ASSERT_EQ(block_table1[0][2]->get_index(), 2);
     ASSERT_EQ(block_table1[0][3]->get_index(), 3);
-    ASSERT_EQ(out2.m_block_tables[idx0][0].size(), 4);
-    ASSERT_EQ(out2.m_block_tables[idx0][0][0]->get_index(), 0);
-    ASSERT_EQ(out2.m_block_tables[idx0][0][1]->get_index(), 1);
-    ASSERT_EQ(out2.m_block_tables[idx0][0][2]->get_index(), 2);
-    ASSERT_EQ(out2.m_block_tables[idx0][0][3]->get_index(), 3);
+    ASSERT_EQ(out2.m_block_indices.at(idx0)->at(0).size(), 4);
+    ASSERT_EQ(out2.m_block_indices.at(idx0)->at(0)[0], 0);
+    ASSERT_EQ(out2.m_block_indices.at(idx0)->at(0)[1], 1);
+    ASSERT_EQ(out2.m_block_indices.at(idx0)->at(0)[2], 2);
+    ASSERT_EQ(out2.m_block_indices.at(idx0)->at(0)[3], 3);
 
     std::vector<uint64_t> ref_ids = {0};
     ASSERT_EQ(out2.m_scheduled_sequence_groups_ids, ref_ids);
@@ -791,9 +1262,9 @@ TEST(TestScheduler, test_partially_preempted_prompt_not_allowed) {
     // prompt should be fully scheduled
     ASSERT_EQ(out3.m_total_num_scheduled_tokens, 12);
 
-    ASSERT_EQ(out3.m_block_tables[idx1][0][0]->get_index(), 4);
-    ASSERT_EQ(out3.m_block_tables[idx1][0][1]->get_index(), 5);
-    ASSERT_EQ(out3.m_block_tables[idx1][0][2]->get_index(), 0);
+    ASSERT_EQ(out3.m_block_indices.at(idx1)->at(0)[0], 4);
+    ASSERT_EQ(out3.m_block_indices.at(idx1)->at(0)[1], 5);
+    ASSERT_EQ(out3.m_block_indices.at(idx1)->at(0)[2], 0);
 
     auto block_table2 = scheduler.get_block_tables(*(*sequence_group2)[0]);
     ASSERT_EQ(block_table2[0].size(), 3);
@@ -858,11 +1329,11 @@ TEST(TestScheduler, test_partially_preempted_prompt_not_allowed2) {
     ASSERT_EQ(block_table1[0][1]->get_index(), 1);
     ASSERT_EQ(block_table1[0][2]->get_index(), 2);
     ASSERT_EQ(block_table1[0][3]->get_index(), 3);
-    ASSERT_EQ(out2.m_block_tables[idx0][0].size(), 4);
-    ASSERT_EQ(out2.m_block_tables[idx0][0][0]->get_index(), 0);
-    ASSERT_EQ(out2.m_block_tables[idx0][0][1]->get_index(), 1);
-    ASSERT_EQ(out2.m_block_tables[idx0][0][2]->get_index(), 2);
-    ASSERT_EQ(out2.m_block_tables[idx0][0][3]->get_index(), 3);
+    ASSERT_EQ(out2.m_block_indices.at(idx0)->at(0).size(), 4);
+    ASSERT_EQ(out2.m_block_indices.at(idx0)->at(0)[0], 0);
+    ASSERT_EQ(out2.m_block_indices.at(idx0)->at(0)[1], 1);
+    ASSERT_EQ(out2.m_block_indices.at(idx0)->at(0)[2], 2);
+    ASSERT_EQ(out2.m_block_indices.at(idx0)->at(0)[3], 3);
 
     std::vector<uint64_t> ref_ids = {0};
     ASSERT_EQ(out2.m_scheduled_sequence_groups_ids, ref_ids);
@@ -885,9 +1356,9 @@ TEST(TestScheduler, test_partially_preempted_prompt_not_allowed2) {
     // prompt should be fully scheduled + generated tokens concatenated to prompt (10 + 2)
     ASSERT_EQ(out3.m_total_num_scheduled_tokens, 12);
 
-    ASSERT_EQ(out3.m_block_tables[idx1][0][0]->get_index(), 4);
-    ASSERT_EQ(out3.m_block_tables[idx1][0][1]->get_index(), 5);
-    ASSERT_EQ(out3.m_block_tables[idx1][0][2]->get_index(), 0);
+    ASSERT_EQ(out3.m_block_indices.at(idx1)->at(0)[0], 4);
+    ASSERT_EQ(out3.m_block_indices.at(idx1)->at(0)[1], 5);
+    ASSERT_EQ(out3.m_block_indices.at(idx1)->at(0)[2], 0);
 
     auto block_table2 = scheduler.get_block_tables(*(*sequence_group2)[0]);
     ASSERT_EQ(block_table2[0].size(), 3);
@@ -0,0 +1,83 @@
+// Copyright (C) 2018-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <gtest/gtest.h>
+#include "openvino/genai/generation_config.hpp"
+#include "sequence_group.hpp"
+#include "continuous_batching/scheduling_policy.hpp"
+
+using namespace ov::genai;
+
+namespace {
+SequenceGroup::Ptr make_sequence_group(uint64_t request_id, const GenerationConfig& config) {
+    std::vector<int64_t> tokens = {0, 1, 2, 3};
+    return std::make_shared<SequenceGroup>(request_id, ov::Tensor(ov::element::i64, {tokens.size()}, tokens.data()), config, 4);
+}
+}
+
+TEST(TestSchedulingPolicy, deadline_policy_orders_by_ttft_target) {
+    GenerationConfig no_target = ov::genai::greedy(), relaxed = ov::genai::greedy(), tight = ov::genai::greedy();
+    relaxed.ttft_target_ms = 10000;
+    tight.ttft_target_ms = 1;
+
+    auto group_0 = make_sequence_group(0, no_target);
+    auto group_1 = make_sequence_group(1, relaxed);
+    auto group_2 = make_sequence_group(2, no_target);
+    auto group_3 = make_sequence_group(3, tight);
+    std::vector<SequenceGroup::Ptr> sequence_groups = {group_0, group_1, group_2, group_3};
+
+    DeadlineSchedulingPolicy policy;
+    policy.order(sequence_groups);
+    // requests without a target keep the order of arrival
+    std::vector<SequenceGroup::Ptr> ref_order = {group_3, group_1, group_0, group_2};
+    EXPECT_EQ(sequence_groups, ref_order);
+    EXPECT_EQ(policy.get_deadline(group_0), std::chrono::steady_clock::time_point::max());
+}
+
+TEST(TestSchedulingPolicy, fair_share_policy_balances_tenants) {
+    GenerationConfig tenant_a = ov::genai::greedy(), tenant_b = ov::genai::greedy(), tenant_c = ov::genai::greedy();
+    tenant_a.tenant_id = "a";
+    tenant_b.tenant_id = "b";
+    tenant_c.tenant_id = "c";
+
+    auto group_a = make_sequence_group(0, tenant_a);
+    auto group_b = make_sequence_group(1, tenant_b);
+    std::vector<SequenceGroup::Ptr> sequence_groups = {group_a, group_b};
+
+    // tenant "a" is entitled to twice as many tokens as tenant "b"
+    FairShareSchedulingPolicy policy({{"a", 2.0f}});
+    policy.order(sequence_groups);
+    EXPECT_EQ(sequence_groups[0], group_a);
+
+    group_a->schedule_tokens(8);
+    group_b->schedule_tokens(8);
+    policy.on_scheduled(sequence_groups, {0, 1});
+    EXPECT_DOUBLE_EQ(policy.get_usage("a"), 4.0);
+    EXPECT_DOUBLE_EQ(policy.get_usage("b"), 8.0);
+
+    policy.order(sequence_groups);
+    EXPECT_EQ(sequence_groups[0], group_a);
+    policy.on_scheduled(sequence_groups, {0});
+    policy.order(sequence_groups);
+    EXPECT_EQ(sequence_groups[0], group_a);
+    policy.on_scheduled(sequence_groups, {0});
+
+    // tenant "a" has received more than its share
+    policy.order(sequence_groups);
+    std::vector<SequenceGroup::Ptr> ref_order = {group_b, group_a};
+    EXPECT_EQ(sequence_groups, ref_order);
+
+    // a new tenant starts on par with the least served one instead of taking over the batch
+    auto group_c = make_sequence_group(2, tenant_c);
+    sequence_groups.push_back(group_c);
+    policy.order(sequence_groups);
+    EXPECT_DOUBLE_EQ(policy.get_usage("c"), 8.0);
+    ref_order = {group_b, group_c, group_a};
+    EXPECT_EQ(sequence_groups, ref_order);
+
+    // an idle tenant does not keep its usage
+    sequence_groups = {group_b, group_c};
+    policy.order(sequence_groups);
+    EXPECT_DOUBLE_EQ(policy.get_usage("a"), 0.0);
+}
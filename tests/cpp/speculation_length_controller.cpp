@@ -0,0 +1,90 @@
+// Copyright (C) 2018-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <gtest/gtest.h>
+
+#include "speculative_decoding/speculation_length_controller.hpp"
+
+using namespace ov::genai;
+
+namespace {
+
+GenerationConfig get_adaptive_config(size_t num_assistant_tokens) {
+    GenerationConfig config;
+    config.num_assistant_tokens = num_assistant_tokens;
+    config.adaptive_num_assistant_tokens = true;
+    return config;
+}
+
+}  // namespace
+
+TEST(TestSpeculationLengthController, static_until_measured) {
+    SpeculationLengthController controller;
+    auto config = get_adaptive_config(4);
+    EXPECT_EQ(controller.get_num_assistant_tokens(0, config), 4);
+
+    controller.register_validation(0, 4, 0);
+    // main model steps are not measured yet
+    EXPECT_EQ(controller.get_num_assistant_tokens(0, config), 4);
+
+    controller.register_main_step(1, 5, 10.0f);
+    EXPECT_NE(controller.get_num_assistant_tokens(0, config), 4);
+    // other requests are not measured yet
+    EXPECT_EQ(controller.get_num_assistant_tokens(1, config), 4);
+
+    // the adaptive number of candidates is opt-in
+    config.adaptive_num_assistant_tokens = false;
+    EXPECT_EQ(controller.get_num_assistant_tokens(0, config), 4);
+}
+
+TEST(TestSpeculationLengthController, follows_acceptance_rate) {
+    SpeculationLengthController controller;
+    const auto config = get_adaptive_config(4);
+    controller.register_draft_step(1.0f);
+    controller.register_main_step(1, 5, 10.0f);
+
+    // all candidates are accepted, so the number of candidates is limited by 2 * num_assistant_tokens
+    for (size_t i = 0; i < 20; ++i) {
+        controller.register_validation(0, 4, 4);
+    }
+    EXPECT_EQ(controller.get_num_assistant_tokens(0, config), 8);
+
+    // all candidates are rejected
+    for (size_t i = 0; i < 50; ++i) {
+        controller.register_validation(1, 4, 0);
+    }
+    EXPECT_EQ(controller.get_num_assistant_tokens(1, config), 1);
+
+    controller.remove_request(0);
+    EXPECT_EQ(controller.get_num_assistant_tokens(0, config), 4);
+}
+
+TEST(TestSpeculationLengthController, follows_step_durations) {
+    const auto config = get_adaptive_config(8);
+
+    SpeculationLengthController cheap_draft;
+    cheap_draft.register_draft_step(0.1f);
+    cheap_draft.register_main_step(1, 5, 20.0f);
+
+    SpeculationLengthController expensive_draft;
+    expensive_draft.register_draft_step(10.0f);
+    expensive_draft.register_main_step(1, 5, 20.0f);
+
+    for (size_t i = 0; i < 20; ++i) {
+        cheap_draft.register_validation(0, 4, 2);
+        expensive_draft.register_validation(0, 4, 2);
+    }
+    EXPECT_GT(cheap_draft.get_num_assistant_tokens(0, config), expensive_draft.get_num_assistant_tokens(0, config));
+
+    // validation of the candidates becomes expensive
+    SpeculationLengthController expensive_validation;
+    expensive_validation.register_draft_step(0.1f);
+    for (size_t num_tokens = 2; num_tokens <= 10; ++num_tokens) {
+        expensive_validation.register_main_step(1, num_tokens, 10.0f + 10.0f * num_tokens);
+    }
+    for (size_t i = 0; i < 20; ++i) {
+        expensive_validation.register_validation(0, 4, 2);
+    }
+    EXPECT_LT(expensive_validation.get_num_assistant_tokens(0, config), cheap_draft.get_num_assistant_tokens(0, config));
+}
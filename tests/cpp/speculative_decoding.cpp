@@ -190,6 +190,60 @@ TEST_F(CBForSDTest, add_tokens__one_sequence) {
     ASSERT_EQ(after.at(0).at(0).log_probs, log_probs);
 }
 
+TEST_F(CBForSDTest, keep_generated_ahead_tokens__one_sequence) {
+    std::vector<int64_t> input_vector{0, 1, 2, 3, 4};
+    ov::Tensor input_tensor(ov::element::i64, ov::Shape{1, 5}, input_vector.data());
+    m_pipeline.add_request(0, input_tensor);
+
+    std::vector<int64_t> tokens = { 0, 1, 2, 3, 4 };
+    std::vector<float> log_probs = { 0.1f, 0.2f, 0.3f, 0.4f, 0.5f };
+    ov::genai::GeneratedSequences candidate{{ 0, ov::genai::GeneratedSequence(tokens, log_probs) }};
+
+    auto update_result = m_pipeline.update_request(0, candidate, true);
+    ASSERT_EQ(update_result.removed_tokens_cnt, 0);
+    ASSERT_EQ(update_result.inserted_tokens_cnt, 5);
+
+    // validated tokens are a prefix of the generated ones
+    std::vector<int64_t> validated_tokens = { 0, 1, 2 };
+    std::vector<float> validated_log_probs = { 0.1f, 0.2f, 0.3f };
+    ov::genai::GeneratedSequences candidate_1{{ 0, ov::genai::GeneratedSequence(validated_tokens, validated_log_probs) }};
+
+    update_result = m_pipeline.update_request(0, candidate_1, true, true);
+    ASSERT_EQ(update_result.removed_tokens_cnt, 0);
+    ASSERT_EQ(update_result.inserted_tokens_cnt, 0);
+
+    auto after = m_pipeline.get_generated_requests();
+    ASSERT_EQ(after.at(0).at(0).token_ids, tokens);
+    ASSERT_EQ(after.at(0).at(0).log_probs, log_probs);
+}
+
+TEST_F(CBForSDTest, remove_generated_ahead_tokens__one_sequence) {
+    std::vector<int64_t> input_vector{0, 1, 2, 3, 4};
+    ov::Tensor input_tensor(ov::element::i64, ov::Shape{1, 5}, input_vector.data());
+    m_pipeline.add_request(0, input_tensor);
+
+    std::vector<int64_t> tokens = { 0, 1, 2, 3, 4 };
+    std::vector<float> log_probs = { 0.1f, 0.2f, 0.3f, 0.4f, 0.5f };
+    ov::genai::GeneratedSequences candidate{{ 0, ov::genai::GeneratedSequence(tokens, log_probs) }};
+
+    auto update_result = m_pipeline.update_request(0, candidate, true);
+    ASSERT_EQ(update_result.removed_tokens_cnt, 0);
+    ASSERT_EQ(update_result.inserted_tokens_cnt, 5);
+
+    // the last validated token differs from the generated one
+    tokens = { 0, 1, 5 };
+    log_probs = { 0.1f, 0.2f, 0.6f };
+    ov::genai::GeneratedSequences candidate_1{{ 0, ov::genai::GeneratedSequence(tokens, log_probs) }};
+
+    update_result = m_pipeline.update_request(0, candidate_1, true, true);
+    ASSERT_EQ(update_result.removed_tokens_cnt, 3);
+    ASSERT_EQ(update_result.inserted_tokens_cnt, 1);
+
+    auto after = m_pipeline.get_generated_requests();
+    ASSERT_EQ(after.at(0).at(0).token_ids, tokens);
+    ASSERT_EQ(after.at(0).at(0).log_probs, log_probs);
+}
+
 TEST_F(CBForSDTest, update_empty_sequence_by_not_empty__two_sequence) {
     std::vector<int64_t> input_vector{0, 1, 2, 3, 4};
     ov::Tensor input_tensor(ov::element::i64, ov::Shape{1, 5}, input_vector.data());
@@ -0,0 +1,64 @@
+// Copyright (C) 2018-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <gtest/gtest.h>
+
+#include "sampling/stop_string_matcher.hpp"
+
+using namespace ov::genai;
+
+namespace {
+
+// feeds the pieces until a stop string is matched, returns { index of the piece, match }
+std::pair<size_t, StopStringMatcher::Match> feed(const StopStringMatcher& matcher, const std::vector<std::string>& pieces) {
+    StopStringMatcher::State state = StopStringMatcher::INITIAL_STATE;
+    StopStringMatcher::Match match;
+    for (size_t i = 0; i < pieces.size(); ++i) {
+        state = matcher.advance(state, pieces[i], match);
+        if (match.is_matched()) {
+            return {i, match};
+        }
+    }
+    return {pieces.size(), match};
+}
+
+}  // namespace
+
+TEST(TestStopStringMatcher, match_across_pieces) {
+    const StopStringMatcher matcher({"Observation:", "\n\n"});
+    auto [piece_idx, match] = feed(matcher, {"Thought", ": ok", " Obs", "erv", "ation:", " more"});
+    EXPECT_EQ(piece_idx, 4);
+    EXPECT_EQ(match.end, 6);
+    EXPECT_EQ(match.length, 12);
+
+    std::tie(piece_idx, match) = feed(matcher, {"line", "\n", "\nnext"});
+    EXPECT_EQ(piece_idx, 2);
+    EXPECT_EQ(match.end, 1);
+    EXPECT_EQ(match.length, 2);
+
+    std::tie(piece_idx, match) = feed(matcher, {"Observ", "ing", " Observ"});
+    EXPECT_EQ(piece_idx, 3);
+    EXPECT_FALSE(match.is_matched());
+}
+
+TEST(TestStopStringMatcher, overlapping_stop_strings) {
+    // the automaton falls back from "abd" to "bc" after "ab"
+    const StopStringMatcher matcher({"abd", "bc", "c"});
+    auto [piece_idx, match] = feed(matcher, {"xa", "bc"});
+    EXPECT_EQ(piece_idx, 1);
+    EXPECT_EQ(match.end, 2);
+    // "bc" and "c" end at the same byte, the longest one is matched
+    EXPECT_EQ(match.length, 2);
+
+    std::tie(piece_idx, match) = feed(matcher, {"aab", "d"});
+    EXPECT_EQ(piece_idx, 1);
+    EXPECT_EQ(match.length, 3);
+}
+
+TEST(TestStopStringMatcher, empty) {
+    const StopStringMatcher matcher({""});
+    auto [piece_idx, match] = feed(matcher, {"any", "text"});
+    EXPECT_FALSE(match.is_matched());
+    EXPECT_FALSE(feed(StopStringMatcher(), {"text"}).second.is_matched());
+}
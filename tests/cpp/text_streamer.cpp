@@ -0,0 +1,174 @@
+// Copyright (C) 2018-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+#include "text_streamer_impl.hpp"
+
+using namespace ov::genai;
+
+namespace {
+
+// "_" is a space and the last two tokens are the bytes of "é"
+const std::vector<std::string> TOY_VOCAB = {"_hello", "_world", ",", "_a", "b", "\n", "_x", "y", "\xC3", "\xA9"};
+
+// a SentencePiece-like detokenizer: it removes the leading space and replaces invalid UTF-8 with U+FFFD
+std::string toy_decode(const std::vector<int64_t>& token_ids) {
+    std::string bytes;
+    for (int64_t token_id : token_ids) {
+        bytes += TOY_VOCAB.at(token_id);
+    }
+    std::replace(bytes.begin(), bytes.end(), '_', ' ');
+    std::string text;
+    for (size_t i = 0; i < bytes.size();) {
+        const auto lead = static_cast<unsigned char>(bytes[i]);
+        const size_t length = lead < 0x80 ? 1 : lead >= 0xE0 ? 0 : lead >= 0xC0 ? 2 : 0;
+        const bool is_valid = length > 0 && i + length <= bytes.size() && (length == 1 || (static_cast<unsigned char>(bytes[i + 1]) & 0xC0) == 0x80);
+        text += is_valid ? bytes.substr(i, length) : "\xEF\xBF\xBD";
+        i += is_valid ? length : 1;
+    }
+    return !text.empty() && text[0] == ' ' ? text.substr(1) : text;
+}
+
+bool is_incomplete(const std::string& text) {
+    return text.size() >= 3 && text.compare(text.size() - 3, 3, "\xEF\xBF\xBD") == 0;
+}
+
+class ToyTextStreamer : public TextStreamer {
+public:
+    ToyTextStreamer(TextStreamerImpl::DecodeFunction decode, std::function<CallbackTypeVariant(std::string)> callback)
+        : TextStreamer(Tokenizer(), std::move(callback)) {
+        m_impl = std::make_unique<TextStreamerImpl>(std::move(decode));
+    }
+};
+
+// the previous implementation of TextStreamer, which decodes the whole tokens cache with each token
+class ReferenceTextStreamer {
+public:
+    explicit ReferenceTextStreamer(std::function<void(std::string)> callback) : m_callback(std::move(callback)) {}
+
+    void write(const std::vector<int64_t>& tokens) {
+        m_tokens_cache.insert(m_tokens_cache.end(), tokens.begin(), tokens.end() - 1);
+        m_decoded_lengths.resize(m_decoded_lengths.size() + tokens.size() - 1, -2);
+        write(tokens.back());
+    }
+
+    void write(int64_t token) {
+        m_tokens_cache.push_back(token);
+        const std::string text = toy_decode(m_tokens_cache);
+        m_decoded_lengths.push_back(text.size());
+        if (!text.empty() && text.back() == '\n' && text.size() > m_printed_len) {
+            m_callback(text.substr(m_printed_len));
+            reset();
+            return;
+        }
+        if (is_incomplete(text)) {
+            m_decoded_lengths.back() = -1;
+            return;
+        }
+        if (m_decoded_lengths.size() < DELAY_N_TOKENS) {
+            return;
+        }
+        int64_t& print_until = m_decoded_lengths[m_decoded_lengths.size() - DELAY_N_TOKENS];
+        if (print_until == -2) {
+            const std::string text_for_position = toy_decode(std::vector<int64_t>(m_tokens_cache.begin(), m_tokens_cache.end() - DELAY_N_TOKENS + 1));
+            print_until = is_incomplete(text_for_position) ? -1 : static_cast<int64_t>(text_for_position.size());
+        }
+        if (print_until > static_cast<int64_t>(m_printed_len)) {
+            m_callback(text.substr(m_printed_len, print_until - m_printed_len));
+            m_printed_len = print_until;
+        }
+    }
+
+    void end() {
+        const std::string text = toy_decode(m_tokens_cache);
+        if (text.size() > m_printed_len) {
+            m_callback(text.substr(m_printed_len));
+        }
+        reset();
+    }
+
+private:
+    static constexpr size_t DELAY_N_TOKENS = 3;
+
+    void reset() {
+        m_tokens_cache.clear();
+        m_decoded_lengths.clear();
+        m_printed_len = 0;
+    }
+
+    std::function<void(std::string)> m_callback;
+    std::vector<int64_t> m_tokens_cache;
+    std::vector<int64_t> m_decoded_lengths;
+    size_t m_printed_len = 0;
+};
+
+}  // namespace
+
+TEST(TestTextStreamer, matches_reference_implementation) {
+    std::mt19937 rng(42);
+    for (size_t trial = 0; trial < 100; ++trial) {
+        // the tokens are written one by one or in batches, as speculative decoding does
+        std::vector<std::vector<int64_t>> writes;
+        for (size_t num_tokens = 0; num_tokens < 300;) {
+            const size_t batch_size = rng() % 4 == 0 ? 2 + rng() % 4 : 1;
+            std::vector<int64_t>& tokens = writes.emplace_back();
+            for (size_t i = 0; i < batch_size; ++i) {
+                tokens.push_back(rng() % TOY_VOCAB.size());
+            }
+            num_tokens += batch_size;
+        }
+
+        std::vector<std::string> chunks, reference_chunks;
+        ToyTextStreamer streamer(toy_decode, [&](std::string chunk) -> CallbackTypeVariant {
+            chunks.push_back(chunk);
+            return StreamingStatus::RUNNING;
+        });
+        ReferenceTextStreamer reference_streamer([&](std::string chunk) {
+            reference_chunks.push_back(chunk);
+        });
+        for (const auto& tokens : writes) {
+            if (tokens.size() == 1) {
+                streamer.write(tokens[0]);
+                reference_streamer.write(tokens[0]);
+            } else {
+                streamer.write(tokens);
+                reference_streamer.write(tokens);
+            }
+        }
+        streamer.end();
+        reference_streamer.end();
+        ASSERT_EQ(chunks, reference_chunks) << "trial " << trial;
+    }
+}
+
+TEST(TestTextStreamer, decoded_tokens_are_bounded) {
+    size_t num_decoded_tokens = 0;
+    std::string text;
+    ToyTextStreamer streamer([&](const std::vector<int64_t>& token_ids) {
+        num_decoded_tokens += token_ids.size();
+        return toy_decode(token_ids);
+    }, [&](std::string chunk) -> CallbackTypeVariant {
+        text += chunk;
+        return StreamingStatus::RUNNING;
+    });
+
+    // a long line without line breaks is never flushed, so the tokens cache grows
+    constexpr size_t num_tokens = 2000;
+    for (size_t i = 0; i < num_tokens; ++i) {
+        streamer.write(static_cast<int64_t>(i % 2));
+    }
+    streamer.end();
+
+    std::vector<int64_t> token_ids;
+    for (size_t i = 0; i < num_tokens; ++i) {
+        token_ids.push_back(static_cast<int64_t>(i % 2));
+    }
+    EXPECT_EQ(text, toy_decode(token_ids));
+    // each token decodes at most the window of the printed tokens and the delayed ones
+    EXPECT_LT(num_decoded_tokens, num_tokens * 40);
+}
@@ -0,0 +1,89 @@
+// Copyright (C) 2018-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "threadpool.hpp"
+
+using namespace ov::genai;
+
+TEST(TestThreadPool, parallel_for_visits_each_index_once) {
+    ThreadPool pool(4);
+    std::vector<std::atomic<size_t>> visits(1000);
+    pool.parallel_for(visits.size(), [&](size_t i) {
+        visits[i].fetch_add(1);
+    });
+    for (const auto& count : visits) {
+        EXPECT_EQ(count.load(), 1);
+    }
+}
+
+TEST(TestThreadPool, parallel_for_respects_max_concurrency) {
+    ThreadPool pool(4);
+    std::thread::id caller_id = std::this_thread::get_id();
+    pool.parallel_for(100, [&](size_t) {
+        EXPECT_EQ(std::this_thread::get_id(), caller_id);
+    }, 1);
+}
+
+TEST(TestThreadPool, parallel_for_rethrows_exception) {
+    ThreadPool pool(2);
+    EXPECT_THROW(pool.parallel_for(100, [&](size_t i) {
+        if (i % 10 == 0) {
+            throw std::runtime_error("failed");
+        }
+    }), std::runtime_error);
+
+    // the pool stays usable
+    std::atomic<size_t> sum{0};
+    pool.parallel_for(10, [&](size_t i) { sum.fetch_add(i); });
+    EXPECT_EQ(sum.load(), 45);
+}
+
+TEST(TestThreadPool, nested_parallel_for) {
+    // workers waiting for inner loops do not deadlock even when all of them are busy with outer iterations
+    ThreadPool pool(2);
+    std::atomic<size_t> num_calls{0};
+    pool.parallel_for(8, [&](size_t) {
+        pool.parallel_for(8, [&](size_t) {
+            num_calls.fetch_add(1);
+        });
+    });
+    EXPECT_EQ(num_calls.load(), 64);
+}
+
+TEST(TestThreadPool, submit_runs_jobs_on_workers) {
+    struct Counter {
+        std::mutex mutex;
+        std::condition_variable cv;
+        size_t value = 0;
+    } counter;
+    auto increment = [](void* context) {
+        auto* counter = static_cast<Counter*>(context);
+        std::lock_guard<std::mutex> lock(counter->mutex);
+        ++counter->value;
+        counter->cv.notify_one();
+    };
+
+    // a small queue makes part of the jobs run on the calling thread
+    ThreadPool pool(2, 4);
+    for (size_t i = 0; i < 100; ++i) {
+        pool.submit({increment, &counter});
+    }
+    std::unique_lock<std::mutex> lock(counter.mutex);
+    counter.cv.wait(lock, [&] { return counter.value == 100; });
+}
+
+TEST(TestThreadPool, shared_pool) {
+    ThreadPool& pool = ThreadPool::get_shared();
+    EXPECT_EQ(&pool, &ThreadPool::get_shared());
+    EXPECT_GE(pool.get_num_threads(), 1);
+}